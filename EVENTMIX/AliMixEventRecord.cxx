@@ -0,0 +1,133 @@
+//
+// Class AliMixEventRecord
+//
+// AliMixEventRecord is a compact copy of the part
+// of an event which is needed for mixing (primary
+// vertex and track kinematics). Users can declare
+// other content by deriving from it and overriding
+// Fill() and AcceptTrack()
+//
+
+#include <TMath.h>
+
+#include "AliVEvent.h"
+#include "AliVVertex.h"
+#include "AliVParticle.h"
+
+#include "AliMixEventRecord.h"
+
+ClassImp(AliMixEventRecord)
+
+//_________________________________________________________________________________________________
+AliMixEventRecord::AliMixEventRecord() : TObject(),
+   fEntry(-1),
+   fPt(),
+   fEta(),
+   fPhi(),
+   fCharge(),
+   fMinPt(0),
+   fMaxAbsEta(0)
+{
+   //
+   // Default constructor.
+   //
+   fVertex[0] = fVertex[1] = fVertex[2] = 0;
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRecord::AliMixEventRecord(const AliMixEventRecord &obj) : TObject(obj),
+   fEntry(obj.fEntry),
+   fPt(obj.fPt),
+   fEta(obj.fEta),
+   fPhi(obj.fPhi),
+   fCharge(obj.fCharge),
+   fMinPt(obj.fMinPt),
+   fMaxAbsEta(obj.fMaxAbsEta)
+{
+   //
+   // Copy constructor
+   //
+   for (Int_t i = 0; i < 3; i++) fVertex[i] = obj.fVertex[i];
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRecord &AliMixEventRecord::operator=(const AliMixEventRecord &obj)
+{
+   //
+   // Assigned operator
+   //
+   if (&obj != this) {
+      TObject::operator=(obj);
+      fEntry = obj.fEntry;
+      for (Int_t i = 0; i < 3; i++) fVertex[i] = obj.fVertex[i];
+      fPt = obj.fPt;
+      fEta = obj.fEta;
+      fPhi = obj.fPhi;
+      fCharge = obj.fCharge;
+      fMinPt = obj.fMinPt;
+      fMaxAbsEta = obj.fMaxAbsEta;
+   }
+   return *this;
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRecord::~AliMixEventRecord()
+{
+   //
+   // Destructor
+   //
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRecord::Clear(Option_t *)
+{
+   //
+   // Resets event content, capacity of track arrays is kept
+   //
+   fEntry = -1;
+   fVertex[0] = fVertex[1] = fVertex[2] = 0;
+   fPt.clear();
+   fEta.clear();
+   fPhi.clear();
+   fCharge.clear();
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRecord::Fill(AliVEvent *ev)
+{
+   //
+   // Copies primary vertex and accepted tracks
+   //
+   if (!ev) return;
+   const AliVVertex *vtx = ev->GetPrimaryVertex();
+   if (vtx) {
+      fVertex[0] = vtx->GetX();
+      fVertex[1] = vtx->GetY();
+      fVertex[2] = vtx->GetZ();
+   }
+   Int_t nTracks = ev->GetNumberOfTracks();
+   fPt.reserve(nTracks);
+   fEta.reserve(nTracks);
+   fPhi.reserve(nTracks);
+   fCharge.reserve(nTracks);
+   AliVParticle *track = 0;
+   for (Int_t i = 0; i < nTracks; i++) {
+      track = ev->GetTrack(i);
+      if (!track || !AcceptTrack(track)) continue;
+      fPt.push_back(track->Pt());
+      fEta.push_back(track->Eta());
+      fPhi.push_back(track->Phi());
+      fCharge.push_back((Char_t)track->Charge());
+   }
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventRecord::AcceptTrack(const AliVParticle *track) const
+{
+   //
+   // Track selection (pt and |eta|)
+   //
+   if (track->Pt() < fMinPt) return kFALSE;
+   if (fMaxAbsEta > 0 && TMath::Abs(track->Eta()) > fMaxAbsEta) return kFALSE;
+   return kTRUE;
+}
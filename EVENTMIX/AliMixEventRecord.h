@@ -0,0 +1,60 @@
+//
+// Class AliMixEventRecord
+//
+// AliMixEventRecord is a compact copy of the part
+// of an event which is needed for mixing (primary
+// vertex and track kinematics). Users can declare
+// other content by deriving from it and overriding
+// Fill() and AcceptTrack()
+//
+
+#ifndef ALIMIXEVENTRECORD_H
+#define ALIMIXEVENTRECORD_H
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliVEvent;
+class AliVParticle;
+class AliMixEventRecord : public TObject {
+public:
+   AliMixEventRecord();
+   AliMixEventRecord(const AliMixEventRecord &obj);
+   AliMixEventRecord &operator= (const AliMixEventRecord &obj);
+   virtual ~AliMixEventRecord();
+
+   // resets event content (track selection is kept)
+   virtual void      Clear(Option_t *option = "");
+   // copies vertex and accepted tracks from event
+   virtual void      Fill(AliVEvent *ev);
+   virtual Bool_t    AcceptTrack(const AliVParticle *track) const;
+
+   void              SetTrackCuts(Float_t minPt, Float_t maxAbsEta) { fMinPt = minPt; fMaxAbsEta = maxAbsEta; }
+   void              SetEntry(Long64_t entry) { fEntry = entry; }
+
+   Long64_t          GetEntry() const { return fEntry; }
+   Float_t           GetVertexX() const { return fVertex[0]; }
+   Float_t           GetVertexY() const { return fVertex[1]; }
+   Float_t           GetVertexZ() const { return fVertex[2]; }
+   Int_t             GetNumberOfTracks() const { return (Int_t)fPt.size(); }
+   Float_t           GetPt(Int_t i) const { return fPt[i]; }
+   Float_t           GetEta(Int_t i) const { return fEta[i]; }
+   Float_t           GetPhi(Int_t i) const { return fPhi[i]; }
+   Short_t           GetCharge(Int_t i) const { return fCharge[i]; }
+
+protected:
+
+   Long64_t              fEntry;         // entry of event in mixing chain
+   Float_t               fVertex[3];     // primary vertex
+   std::vector<Float_t>  fPt;            // track pt
+   std::vector<Float_t>  fEta;           // track eta
+   std::vector<Float_t>  fPhi;           // track phi
+   std::vector<Char_t>   fCharge;        // track charge
+   Float_t               fMinPt;         // minimum track pt
+   Float_t               fMaxAbsEta;     // maximum track |eta| (no cut if <= 0)
+
+   ClassDef(AliMixEventRecord, 1)
+};
+
+#endif
@@ -0,0 +1,233 @@
+//
+// Class AliMixEventRecordBuffer
+//
+// AliMixEventRecordBuffer keeps the last N event records
+// of every mixing bin in a ring. Records are kept in memory
+// or, when a file name is given, in a TTree on local disk
+// where only the entry numbers are kept in the ring. The
+// disk buffer is rewritten with the live records only when
+// the tree holds twice as many entries, so its size is bounded
+//
+
+#include <algorithm>
+#include <utility>
+
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TTree.h>
+#include <TSystem.h>
+
+#include "AliLog.h"
+#include "AliMixEventRecord.h"
+
+#include "AliMixEventRecordBuffer.h"
+
+ClassImp(AliMixEventRecordBuffer)
+
+//_________________________________________________________________________________________________
+AliMixEventRecordBuffer::AliMixEventRecordBuffer(const char *name, const char *title) : TNamed(name, title),
+   fPrototype(0),
+   fDepth(0),
+   fRecords(),
+   fTreeEntries(),
+   fNext(),
+   fCount(),
+   fFileName(),
+   fFile(0),
+   fTree(0),
+   fIORecord(0),
+   fNLive(0),
+   fNCompactions(0)
+{
+   //
+   // Default constructor.
+   //
+   fRecords.SetOwner(kTRUE);
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRecordBuffer::~AliMixEventRecordBuffer()
+{
+   //
+   // Destructor (disk buffer file is removed)
+   //
+   fRecords.Delete();
+   if (fFile) {
+      fFile->Close();
+      delete fFile;
+      gSystem->Unlink(DiskBufferName(fNCompactions).Data());
+   }
+   delete fIORecord;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventRecordBuffer::Init(const AliMixEventRecord *prototype, Int_t depth, const char *fileName)
+{
+   //
+   // Prepares buffer with depth records per bin.
+   // When fileName is set, records are written to a tree
+   // in file "fileName.<pid>" (one file per process)
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   if (!prototype || depth < 1) {
+      AliError(Form("Wrong record (%p) or depth (%d) !!!", (void *)prototype, depth));
+      return kFALSE;
+   }
+   fPrototype = prototype;
+   fDepth = depth;
+   if (fileName && fileName[0]) {
+      fFileName = Form("%s.%d", fileName, gSystem->GetPid());
+      fIORecord = (AliMixEventRecord *) fPrototype->Clone();
+      if (!OpenDiskBuffer(fFile, fTree)) {
+         AliError(Form("Cannot create file %s, records will be kept in memory !!!", fFileName.Data()));
+         delete fIORecord;
+         fIORecord = 0;
+      }
+   }
+   AliDebug(AliLog::kDebug, Form("Buffer depth %d on %s", fDepth, fTree ? fFileName.Data() : "memory"));
+   AliDebug(AliLog::kDebug + 5, "->");
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRecordBuffer::ExpandBins(Int_t bin)
+{
+   //
+   // Makes room for bins up to bin
+   //
+   if (bin < (Int_t)fNext.size()) return;
+   fNext.resize(bin + 1, 0);
+   fCount.resize(bin + 1, 0);
+   if (fTree) fTreeEntries.resize((bin + 1) * fDepth, -1);
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRecordBuffer::Add(Int_t bin, AliVEvent *ev, Long64_t entry)
+{
+   //
+   // Fills record from event and adds it to the ring of bin
+   //
+   if (bin < 0 || !fPrototype) return;
+   ExpandBins(bin);
+   Int_t index = bin * fDepth + fNext[bin];
+   AliMixEventRecord *rec = fIORecord;
+   if (!fTree) {
+      rec = (AliMixEventRecord *) fRecords.At(index);
+      if (!rec) {
+         rec = (AliMixEventRecord *) fPrototype->Clone();
+         fRecords.AddAtAndExpand(rec, index);
+      }
+   }
+   rec->Clear();
+   rec->Fill(ev);
+   rec->SetEntry(entry);
+   if (fTree) {
+      fTreeEntries[index] = fTree->GetEntries();
+      fTree->Fill();
+   }
+   fNext[bin] = (fNext[bin] + 1) % fDepth;
+   if (fCount[bin] < fDepth) {
+      fCount[bin]++;
+      fNLive++;
+   }
+   AliDebug(AliLog::kDebug + 1, Form("Entry %lld added to bin %d (%d records)", entry, bin, fCount[bin]));
+   // at least half of the tree entries belong to replaced records
+   if (fTree && fTree->GetEntries() >= 2 * fNLive) Compact();
+}
+
+//_________________________________________________________________________________________________
+TString AliMixEventRecordBuffer::DiskBufferName(Int_t generation) const
+{
+   //
+   // Returns name of disk buffer file (two names are used alternately)
+   //
+   if (generation % 2) return fFileName + ".1";
+   return fFileName;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventRecordBuffer::OpenDiskBuffer(TFile *&file, TTree *&tree)
+{
+   //
+   // Creates disk buffer file and tree for the current generation
+   //
+   TDirectory *savedDir = gDirectory;
+   TString name = DiskBufferName(fNCompactions);
+   file = TFile::Open(name.Data(), "RECREATE");
+   if (!file || file->IsZombie()) {
+      delete file;
+      file = 0;
+      tree = 0;
+      if (savedDir) savedDir->cd();
+      return kFALSE;
+   }
+   tree = new TTree("mixRecords", "Mix event records");
+   tree->SetDirectory(file);
+   tree->Branch("record", fIORecord->ClassName(), &fIORecord);
+   if (savedDir) savedDir->cd();
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRecordBuffer::Compact()
+{
+   //
+   // Copies the records which are still in the rings to a new
+   // disk buffer and removes the old one
+   //
+   TString oldName = DiskBufferName(fNCompactions);
+   TFile *oldFile = fFile;
+   TTree *oldTree = fTree;
+
+   fNCompactions++;
+   TFile *file = 0;
+   TTree *tree = 0;
+   if (!OpenDiskBuffer(file, tree)) {
+      AliError(Form("Cannot create file %s, disk buffer is not compacted !!!", DiskBufferName(fNCompactions).Data()));
+      fNCompactions--;
+      return;
+   }
+
+   // copy in the order of the old entries, so that the old tree is read sequentially
+   std::vector<std::pair<Long64_t, Int_t> > live;
+   live.reserve(fNLive);
+   for (Int_t i = 0; i < (Int_t)fTreeEntries.size(); i++) {
+      if (fTreeEntries[i] >= 0) live.push_back(std::make_pair(fTreeEntries[i], i));
+   }
+   std::sort(live.begin(), live.end());
+   for (UInt_t i = 0; i < live.size(); i++) {
+      oldTree->GetEntry(live[i].first);
+      fTreeEntries[live[i].second] = tree->GetEntries();
+      tree->Fill();
+   }
+   AliDebug(AliLog::kDebug, Form("Disk buffer compacted from %lld to %lld entries", oldTree->GetEntries(), tree->GetEntries()));
+
+   fFile = file;
+   fTree = tree;
+   oldFile->Close();
+   delete oldFile;
+   gSystem->Unlink(oldName.Data());
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventRecordBuffer::GetN(Int_t bin) const
+{
+   //
+   // Returns number of records in bin
+   //
+   if (bin < 0 || bin >= (Int_t)fCount.size()) return 0;
+   return fCount[bin];
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRecord *AliMixEventRecordBuffer::Get(Int_t bin, Int_t i)
+{
+   //
+   // Returns i-th newest record in bin (i=0 is the last added one)
+   //
+   if (i < 0 || i >= GetN(bin)) return 0;
+   Int_t index = bin * fDepth + (fNext[bin] - 1 - i + fDepth) % fDepth;
+   if (!fTree) return (AliMixEventRecord *) fRecords.At(index);
+   fTree->GetEntry(fTreeEntries[index]);
+   return fIORecord;
+}
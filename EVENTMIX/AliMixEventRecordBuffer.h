@@ -0,0 +1,69 @@
+//
+// Class AliMixEventRecordBuffer
+//
+// AliMixEventRecordBuffer keeps the last N event records
+// of every mixing bin in a ring. Records are kept in memory
+// or, when a file name is given, in a TTree on local disk
+// where only the entry numbers are kept in the ring. The
+// disk buffer is rewritten with the live records only when
+// the tree holds twice as many entries, so its size is bounded
+//
+
+#ifndef ALIMIXEVENTRECORDBUFFER_H
+#define ALIMIXEVENTRECORDBUFFER_H
+
+#include <vector>
+
+#include <TNamed.h>
+#include <TObjArray.h>
+#include <TString.h>
+
+class TFile;
+class TTree;
+class AliVEvent;
+class AliMixEventRecord;
+class AliMixEventRecordBuffer : public TNamed {
+public:
+   AliMixEventRecordBuffer(const char *name = "mixEventRecordBuffer", const char *title = "Mix event record buffer");
+   virtual ~AliMixEventRecordBuffer();
+
+   // prepares buffer with depth records per bin (fileName for disk buffer)
+   Bool_t              Init(const AliMixEventRecord *prototype, Int_t depth, const char *fileName = 0);
+
+   // fills record from event and adds it to the ring of bin (oldest record is replaced)
+   void                Add(Int_t bin, AliVEvent *ev, Long64_t entry);
+   // number of records in bin
+   Int_t               GetN(Int_t bin) const;
+   // i-th newest record in bin (for disk buffer valid until next Get or Add)
+   AliMixEventRecord  *Get(Int_t bin, Int_t i);
+
+   Int_t               GetDepth() const { return fDepth; }
+   Bool_t              IsOnDisk() const { return (fTree != 0); }
+
+private:
+
+   const AliMixEventRecord *fPrototype;    //! record cloned for every slot (not owned)
+   Int_t                    fDepth;        //  number of records per bin
+   TObjArray                fRecords;      //! records in memory (bin*fDepth+slot)
+   std::vector<Long64_t>    fTreeEntries;  //! entries of records in fTree (bin*fDepth+slot)
+   std::vector<Int_t>       fNext;         //! next slot to be filled in bin
+   std::vector<Int_t>       fCount;        //! number of records in bin
+   TString                  fFileName;     //  name of disk buffer file
+   TFile                   *fFile;         //! disk buffer file
+   TTree                   *fTree;         //! disk buffer tree
+   AliMixEventRecord       *fIORecord;     //! record connected to fTree
+   Long64_t                 fNLive;        //! number of records in all rings
+   Int_t                    fNCompactions; //! number of times the disk buffer was rewritten
+
+   void                     ExpandBins(Int_t bin);
+   TString                  DiskBufferName(Int_t generation) const;
+   Bool_t                   OpenDiskBuffer(TFile *&file, TTree *&tree);
+   void                     Compact();
+
+   AliMixEventRecordBuffer(const AliMixEventRecordBuffer &obj);
+   AliMixEventRecordBuffer &operator=(const AliMixEventRecordBuffer &obj);
+
+   ClassDef(AliMixEventRecordBuffer, 1)
+};
+
+#endif
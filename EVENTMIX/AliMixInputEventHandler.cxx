@@ -7,6 +7,8 @@
 //        Martin Vala (martin.vala@cern.ch)
 //
 
+#include <vector>
+
 #include <TFile.h>
 #include <TChain.h>
 #include <TChainElement.h>
@@ -17,6 +19,8 @@
 #include "AliInputEventHandler.h"
 
 #include "AliMixEventPool.h"
+#include "AliMixEventRecord.h"
+#include "AliMixEventRecordBuffer.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
 
@@ -37,13 +41,20 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fDoMixExtra(kTRUE),
    fDoMixIfNotEnoughEvents(kTRUE),
    fDoMixEventGetEntryAuto(kTRUE),
+   fMixRecord(0),
+   fMixRecordDepth(0),
+   fMixRecordFile(),
+   fReadAheadCacheSize(0),
+   fReadAheadAsync(kFALSE),
    fCurrentEntry(0),
    fCurrentEntryMain(0),
    fCurrentEntryMix(0),
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fMixRecordBuffer(0),
+   fCurrentMixRecord(0)
 {
    //
    // Default constructor.
@@ -59,6 +70,7 @@ AliMixInputEventHandler::~AliMixInputEventHandler() {
    // Destructor
    //
    fMixTrees.Clear();
+   delete fMixRecordBuffer;
 }
 
 //_____________________________________________________________________________
@@ -153,6 +165,7 @@ Bool_t AliMixInputEventHandler::Notify(const char *path)
    for (Int_t i = 0; i < fInputHandlers.GetEntries(); i++) {
       AliDebug(AliLog::kDebug + 5, Form("fInputHandlers[%d]", i));
       mixIHI = new AliMixInputHandlerInfo(fMixIntupHandlerInfoTmp->GetName(), fMixIntupHandlerInfoTmp->GetTitle());
+      mixIHI->SetReadAheadCacheSize(fReadAheadCacheSize, fReadAheadAsync);
       if (doPrepareEntry) mixIHI->PrepareEntry(che, -1, (AliInputEventHandler *)InputEventHandler(i), fAnalysisType);
       AliDebug(AliLog::kDebug + 5, Form("chain[%d]->GetEntries() = %lld", i, mixIHI->GetChain()->GetEntries()));
       fMixTrees.Add(mixIHI);
@@ -192,7 +205,10 @@ Bool_t AliMixInputEventHandler::GetEntry()
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
 
-   if (!fEventPool) {
+   if (fMixRecord) {
+      MixRecords();
+   }
+   else if (!fEventPool) {
       MixStd();
    }
    // if buffer size is higher then 1
@@ -248,6 +264,10 @@ Bool_t AliMixInputEventHandler::MixStd()
    AliMixInputHandlerInfo *mihi = 0;
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
+   std::vector<Long64_t> entriesMix;
+   if (fReadAheadCacheSize > 0) {
+      for (counter = 0; counter < mixNum && fEntryCounter - 1 - counter >= 0; counter++) entriesMix.push_back(fEntryCounter - 1 - counter);
+   }
    for (counter = 0; counter < mixNum; counter++) {
       entryMix = fEntryCounter - 1 - counter ;
       AliDebug(AliLog::kDebug + 5, Form("Handler[%d] entryMix %lld ", counter, entryMix));
@@ -258,7 +278,10 @@ Bool_t AliMixInputEventHandler::MixStd()
       if (!te) {
          AliError("te is null. this is error. tell to developer (#1)");
       } else {
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         if (fDoMixEventGetEntryAuto) {
+            mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+            if (!counter && entriesMix.size() > 1) ReadAheadMixEntries(mihi, te, &entriesMix[1], (Int_t)entriesMix.size() - 1);
+         }
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, 1, fEntryCounter, entryMixReal, fNumberMixed);
@@ -456,6 +479,10 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
    mihi = (AliMixInputHandlerInfo *) fMixTrees.At(0);
+   std::vector<Long64_t> entriesMix;
+   if (fReadAheadCacheSize > 0) {
+      for (counter = 0; counter < mixNum && elNum - 2 - counter >= 0; counter++) entriesMix.push_back(el->GetEntry(elNum - 2 - counter));
+   }
    // fills num for main events
    for (counter = 0; counter < mixNum; counter++) {
       fCurrentMixEntry.Reset();
@@ -471,7 +498,10 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
          AliError("te is null. this is error. tell to developer (#2)");
       } else {
          fCurrentMixEntry.Enter(entryMixReal);
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         if (fDoMixEventGetEntryAuto) {
+            mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+            if (!counter && entriesMix.size() > 1) ReadAheadMixEntries(mihi, te, &entriesMix[1], (Int_t)entriesMix.size() - 1);
+         }
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, entryMixReal, fNumberMixed);
@@ -495,6 +525,117 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithBuffer()
    return kFALSE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::MixRecords()
+{
+   //
+   // Mix with compact event records of previous events in the same bin.
+   // Mixed record is available via GetMixedRecord() in UserExecMix,
+   // full mixed event can still be read with GetEntryMixedEvent()
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   AliDebug(AliLog::kDebug + 1, "Mix method");
+   // get correct handler
+   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+   AliMultiInputEventHandler *mh = dynamic_cast<AliMultiInputEventHandler *>(mgr->GetInputEventHandler());
+   AliInputEventHandler *inEvHMain = 0;
+   if (mh) inEvHMain = dynamic_cast<AliInputEventHandler *>(mh->GetFirstInputEventHandler());
+   else inEvHMain = dynamic_cast<AliInputEventHandler *>(mgr->GetInputEventHandler());
+   if (!inEvHMain) return kFALSE;
+
+   // check for PhysSelection
+   if (!IsEventCurrentSelected()) return kFALSE;
+
+   if (!fMixRecordBuffer) {
+      Int_t depth = fMixRecordDepth;
+      if (depth < 1) depth = fDoMixExtra ? 2 * fMixNumber + 1 : fMixNumber;
+      fMixRecordBuffer = new AliMixEventRecordBuffer();
+      fMixRecordBuffer->Init(fMixRecord, depth > 0 ? depth : 1, fMixRecordFile.Data());
+   }
+
+   fCurrentMixEntry.Reset();
+   fCurrentMixRecord = 0;
+
+   // find out zero chain entries
+   Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
+   Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
+   AliVEvent *ev = inEvHMain->GetEvent();
+   // start of
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld (records) +++++++++++++++++++", fEntryCounter));
+   // reset mix number
+   fNumberMixed = 0;
+   Int_t idEntryList = 1;
+   if (fEventPool && !fEventPool->FindEntryList(ev, idEntryList)) {
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (el null) +++++++++++++++++++", fEntryCounter));
+      UserExecMixAllTasks(fEntryCounter, -1, currentMainEntry, -1, 0);
+      return kTRUE;
+   }
+   Int_t bin = idEntryList - 1;
+   Int_t nRecords = fMixRecordBuffer->GetN(bin);
+   Int_t mixNum = fMixNumber;
+   if (fDoMixExtra) {
+      if (nRecords <= 2 * fMixNumber) mixNum = nRecords;
+   }
+   if (!nRecords || (!fDoMixIfNotEnoughEvents && nRecords < fMixNumber)) {
+      if (!fDoMixIfNotEnoughEvents) idEntryList = -1;
+      UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, -1, 0);
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (%d records) +++++++++++++++++++", fEntryCounter, nRecords));
+   } else {
+      AliMixEventRecord *rec = 0;
+      for (Int_t counter = 0; counter < mixNum && counter < nRecords; counter++) {
+         rec = fMixRecordBuffer->Get(bin, counter);
+         if (!rec) break;
+         fCurrentMixEntry.Reset();
+         fCurrentMixEntry.Enter(rec->GetEntry());
+         fCurrentMixRecord = rec;
+         // runs UserExecMix for all tasks
+         fNumberMixed++;
+         UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, rec->GetEntry(), fNumberMixed);
+      }
+      fCurrentMixRecord = 0;
+   }
+   // current event is mixed with following events only
+   fMixRecordBuffer->Add(bin, ev, currentMainEntry);
+
+   AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   AliDebug(AliLog::kDebug + 5, "->");
+   return kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::ReadAheadMixEntries(AliMixInputHandlerInfo *mihi, TChainElement *te, const Long64_t *entries, Int_t n)
+{
+   //
+   // Read ahead of mixed entries (in chain of processed files) which are
+   // in the same file as te, which has to be prepared in mihi already
+   //
+   Long64_t first = -1, last = -1, entry;
+   for (Int_t i = 0; i < n; i++) {
+      entry = entries[i];
+      if (fMixIntupHandlerInfoTmp->GetEntryInTree(entry) != te) continue;
+      if (first < 0 || entry < first) first = entry;
+      if (entry > last) last = entry;
+   }
+   if (first >= 0) mihi->ReadAhead(first, last);
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::SetMixRecord(AliMixEventRecord *const record, Int_t depth, const char *fileName)
+{
+   //
+   // Sets event record used for mixing instead of full events.
+   // depth is number of records kept per bin (default is number of
+   // events needed for mixing) and when fileName is set records are
+   // kept in file on local disk instead of memory
+   //
+   fMixRecord = record;
+   fMixRecordDepth = depth;
+   fMixRecordFile = fileName ? fileName : "";
+   delete fMixRecordBuffer;
+   fMixRecordBuffer = 0;
+}
+
 //_____________________________________________________________________________
 Bool_t AliMixInputEventHandler::FinishEvent()
 {
@@ -13,6 +13,7 @@
 #include <TObjArray.h>
 #include <TEntryList.h>
 #include <TArrayI.h>
+#include <TString.h>
 
 #include <AliVEvent.h>
 
@@ -21,6 +22,8 @@
 class TChain;
 class TChainElement;
 class AliMixEventPool;
+class AliMixEventRecord;
+class AliMixEventRecordBuffer;
 class AliMixInputHandlerInfo;
 class AliInputEventHandler;
 class AliMixInputEventHandler : public AliMultiInputEventHandler {
@@ -73,6 +76,13 @@ public:
 
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
+
+   // mixing with compact event records instead of full events
+   void                    SetMixRecord(AliMixEventRecord *const record, Int_t depth = 0, const char *fileName = 0);
+   AliMixEventRecord      *GetMixedRecord() const { return fCurrentMixRecord; }
+
+   // tree cache with read ahead of mixed events (full events only)
+   void                    SetReadAhead(Long64_t cacheSize, Bool_t async = kFALSE) { fReadAheadCacheSize = cacheSize; fReadAheadAsync = async; }
 protected:
 
    TObjArray               fMixTrees;              // buffer of input handlers
@@ -89,6 +99,11 @@ private:
    Bool_t                  fDoMixExtra;            // mix extra events to get enough combinations
    Bool_t                  fDoMixIfNotEnoughEvents;// mix events if they don't have enough events to mix
    Bool_t                  fDoMixEventGetEntryAuto;// flag for preparing mixed events automatically (default on)
+   AliMixEventRecord      *fMixRecord;             // user's event record (mixing with records if set)
+   Int_t                   fMixRecordDepth;        // number of records per bin
+   TString                 fMixRecordFile;         // file for records (records in memory if empty)
+   Long64_t                fReadAheadCacheSize;    // tree cache size for mixed events (0 is off)
+   Bool_t                  fReadAheadAsync;        // use asynchronous prefetching of tree cache
 
    // mixing info
    Long64_t fCurrentEntry;       //! current entry number (adds 1 for every event processed on each worker)
@@ -100,17 +115,23 @@ private:
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
 
+   AliMixEventRecordBuffer *fMixRecordBuffer;  //! buffer of event records
+   AliMixEventRecord       *fCurrentMixRecord; //! current mixed record (valid in UserExecMix only)
+
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
+   virtual Bool_t          MixRecords();
+
+   void                    ReadAheadMixEntries(AliMixInputHandlerInfo *mihi, TChainElement *te, const Long64_t *entries, Int_t n);
 
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
@@ -7,10 +7,14 @@
 // author:
 //        Martin Vala (martin.vala@cern.ch)
 //
+#include <algorithm>
+
 #include <TTree.h>
 #include <TChain.h>
 #include <TFile.h>
+#include <TEnv.h>
 #include <TChainElement.h>
+#include <TTreeCache.h>
 
 #include "AliLog.h"
 #include "AliInputEventHandler.h"
@@ -24,7 +28,10 @@ AliMixInputHandlerInfo::AliMixInputHandlerInfo(const char *name, const char *tit
    fChain(0),
    fChainEntriesArray(),
    fZeroEntryNumber(0),
-   fNeedNotify(kFALSE)
+   fNeedNotify(kFALSE),
+   fReadAheadCacheSize(0),
+   fReadAheadAsync(kFALSE),
+   fChainEntriesOffsets(1, 0)
 {
    //
    // Default constructor.
@@ -81,6 +88,8 @@ void AliMixInputHandlerInfo::AddTreeToChain(const char *path)
    fChainEntriesArray.Set(lastIndex);
    AliDebug(AliLog::kDebug + 3, Form("Adding %lld to id %d", fChain->GetTree()->GetEntries(), lastIndex - 1));
    fChainEntriesArray.AddAt((Int_t)fChain->GetTree()->GetEntries(), (Int_t)lastIndex - 1);
+   fChainEntriesOffsets.resize(lastIndex + 1, 0);
+   fChainEntriesOffsets[lastIndex] = fChainEntriesOffsets[lastIndex - 1] + fChainEntriesArray.At(lastIndex - 1);
    AliDebug(AliLog::kDebug + 5, Form("-> %s", path));
 }
 
@@ -98,16 +107,15 @@ TChainElement *AliMixInputHandlerInfo::GetEntryInTree(Long64_t &entry)
       AliDebug(AliLog::kDebug + 5, "->");
       return 0;
    }
-   Long64_t sumTree = fZeroEntryNumber;
-   for (Int_t i = 0; i < fChainEntriesArray.GetSize() ; i++) {
-      sumTree += fChainEntriesArray.At(i);
-      if (sumTree > entry) {
-         sumTree = entry - sumTree + fChainEntriesArray.At(i);
-         AliDebug(AliLog::kDebug + 1, Form("Entry in current tree num is %lld with i=%d", sumTree, i));
-         entry = sumTree;
-         AliDebug(AliLog::kDebug + 5, "->");
-         return (TChainElement *) fChain->GetListOfFiles()->At(i);
-      }
+   // binary search in first entries of trees
+   Long64_t entryInChain = entry - fZeroEntryNumber;
+   std::vector<Long64_t>::const_iterator it = std::upper_bound(fChainEntriesOffsets.begin() + 1, fChainEntriesOffsets.end(), entryInChain);
+   if (it != fChainEntriesOffsets.end()) {
+      Int_t i = (Int_t)(it - fChainEntriesOffsets.begin()) - 1;
+      entry = entryInChain - fChainEntriesOffsets[i];
+      AliDebug(AliLog::kDebug + 1, Form("Entry in current tree num is %lld with i=%d", entry, i));
+      AliDebug(AliLog::kDebug + 5, "->");
+      return (TChainElement *) fChain->GetListOfFiles()->At(i);
    }
    entry = -1;
    AliDebug(AliLog::kDebug + 5, "->");
@@ -131,6 +139,7 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
          fChain = new TChain(te->GetName());
          fChain->AddFile(te->GetTitle());
          fChain->GetEntry(0);
+         SetupReadAhead();
          eh->Init(opt);
          eh->Init(fChain->GetTree(), opt);
       }
@@ -149,6 +158,7 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
          fChain = new TChain(te->GetName());
          fChain->AddFile(te->GetTitle());
          fChain->GetEntry(0);
+         SetupReadAhead();
          eh->Init(opt);
          eh->Init(fChain->GetTree(), opt);
          eh->Notify(te->GetTitle());
@@ -180,3 +190,42 @@ Long64_t AliMixInputHandlerInfo::GetEntries()
    if (fChain) return fChain->GetEntries();
    return -1;
 }
+
+//_____________________________________________________________________________
+void AliMixInputHandlerInfo::SetupReadAhead()
+{
+   //
+   // Creates tree cache for all branches of current tree.
+   // Asynchronous prefetching is read from gEnv when the cache is created,
+   // so it is switched on only for this cache and the previous value is restored.
+   //
+   if (fReadAheadCacheSize <= 0 || !fChain) return;
+   AliDebug(AliLog::kDebug, Form("Setting tree cache %lld for read ahead", fReadAheadCacheSize));
+   Int_t asyncPrefetching = gEnv->GetValue("TFile.AsyncPrefetching", 0);
+   if (fReadAheadAsync) gEnv->SetValue("TFile.AsyncPrefetching", 1);
+   fChain->SetCacheSize(fReadAheadCacheSize);
+   if (fReadAheadAsync) gEnv->SetValue("TFile.AsyncPrefetching", asyncPrefetching);
+   fChain->AddBranchToCache("*", kTRUE);
+   fChain->StopCacheLearningPhase();
+}
+
+//_____________________________________________________________________________
+void AliMixInputHandlerInfo::ReadAhead(Long64_t first, Long64_t last)
+{
+   //
+   // Fills tree cache with baskets of entries first..last of current tree,
+   // so that following PrepareEntry calls in this range are served from
+   // memory. Event content of input handler is not changed.
+   //
+   if (fReadAheadCacheSize <= 0 || !fChain || first < 0 || last < first) return;
+   TTree *tree = fChain->GetTree();
+   if (!tree || !tree->GetCurrentFile()) return;
+   TTreeCache *tc = dynamic_cast<TTreeCache *>(tree->GetCurrentFile()->GetCacheRead(tree));
+   if (!tc) return;
+   AliDebug(AliLog::kDebug + 1, Form("Reading ahead entries %lld-%lld", first, last));
+   Long64_t readEntry = tree->GetReadEntry();
+   tc->SetEntryRange(first, last + 1);
+   tree->LoadTree(first);
+   tc->FillBuffer();
+   tree->LoadTree(readEntry);
+}
@@ -9,6 +9,8 @@
 //
 #ifndef ALIMIXINPUTHANDLERINFO_H
 #define ALIMIXINPUTHANDLERINFO_H
+#include <vector>
+
 #include <TArrayI.h>
 #include <TNamed.h>
 
@@ -33,16 +35,26 @@ public:
    TChainElement *GetEntryInTree(Long64_t &entry);
    Long64_t      GetEntries();
 
+   // tree cache for mixed events (0 is off), optionally with asynchronous prefetching
+   void SetReadAheadCacheSize(Long64_t size, Bool_t async = kFALSE) { fReadAheadCacheSize = size; fReadAheadAsync = async; }
+   Long64_t GetReadAheadCacheSize() const { return fReadAheadCacheSize; }
+   void ReadAhead(Long64_t first, Long64_t last);
+
 private:
    TChain    *fChain;              // current chain
    TArrayI   fChainEntriesArray;   // array of entries of every chaing
    Long64_t  fZeroEntryNumber;     // zero entry number (will be used when we will delete not needed chains)
    Bool_t    fNeedNotify;          // flag if Notify is needed for current input handler
+   Long64_t  fReadAheadCacheSize;  // size of tree cache used for read ahead of mixed events
+   Bool_t    fReadAheadAsync;      // use asynchronous prefetching of tree cache
+   std::vector<Long64_t> fChainEntriesOffsets; //! first entry of every tree in chain (last is sum of all)
+
+   void SetupReadAhead();
 
    AliMixInputHandlerInfo(const AliMixInputHandlerInfo &handler);
    AliMixInputHandlerInfo &operator=(const AliMixInputHandlerInfo &handler);
 
-   ClassDef(AliMixInputHandlerInfo, 1); // Mix Input Handler info
+   ClassDef(AliMixInputHandlerInfo, 2); // Mix Input Handler info
 };
 
 #endif // ALIMIXINPUTHANDLERINFO_H
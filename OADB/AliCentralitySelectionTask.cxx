@@ -51,6 +51,7 @@
 #include "AliESDVertex.h"
 #include "AliCentrality.h"
 #include "AliOADBCentrality.h"
+#include "AliOADBCache.h"
 #include "AliOADBContainer.h"
 #include "AliMultiplicity.h"
 #include "AliAODHandler.h"
@@ -2008,14 +2009,14 @@ Int_t AliCentralitySelectionTask::SetupRun(const AliVEvent* const esd)
   TString fileName =(Form("%s/COMMON/CENTRALITY/data/centrality.root", AliAnalysisManager::GetOADBPath()));
   AliInfo(Form("Setup Centrality Selection for run %d with file %s\n",fCurrentRun,fileName.Data()));
 
-  AliOADBContainer *con = new AliOADBContainer("OADB");
-  con->InitFromFile(fileName,"Centrality");
+  // the container is read once per process and shared with other tasks
+  AliOADBCache* oadbCache = AliOADBCache::Instance();
 
   AliOADBCentrality*  centOADB = 0;
-  centOADB = (AliOADBCentrality*)(con->GetObject(fCurrentRun));
+  centOADB = (AliOADBCentrality*)(oadbCache->GetObject(fileName,"Centrality",fCurrentRun));
   if (!centOADB) {
     AliWarning(Form("Centrality OADB does not exist for run %d, using Default \n",fCurrentRun ));
-    centOADB  = (AliOADBCentrality*)(con->GetDefaultObject("oadbDefault"));
+    centOADB  = (AliOADBCentrality*)(oadbCache->GetDefaultObject(fileName,"Centrality","oadbDefault"));
   }
 
   Bool_t isHijing=kFALSE;
@@ -0,0 +1,178 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//-------------------------------------------------------------------------
+//     Process wide cache of OADB files, containers and objects
+//     See header for details.
+//-------------------------------------------------------------------------
+
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TMutex.h>
+#include <TSystem.h>
+#include <TVirtualMutex.h>
+#include "AliOADBCache.h"
+#include "AliOADBContainer.h"
+#include "AliLog.h"
+
+ClassImp(AliOADBCache)
+
+//______________________________________________________________________________
+AliOADBCache* AliOADBCache::Instance()
+{
+  // The instance is created on first use and lives until the end of the
+  // process, the files stay open for all later lookups
+  static AliOADBCache* instance = new AliOADBCache();
+  return instance;
+}
+
+//______________________________________________________________________________
+AliOADBCache::AliOADBCache() :
+  TObject(),
+  fMutex(new TMutex(kTRUE)),
+  fFiles(),
+  fContainers(),
+  fObjects()
+{
+  // ctor
+}
+
+//______________________________________________________________________________
+AliOADBCache::~AliOADBCache()
+{
+  // dtor, the containers own the resolved objects
+  for (std::map<TString,AliOADBContainer*>::iterator it = fContainers.begin(); it != fContainers.end(); ++it)
+    delete it->second;
+  for (std::map<TString,TFile*>::iterator it = fFiles.begin(); it != fFiles.end(); ++it) {
+    it->second->Close();
+    delete it->second;
+  }
+  delete fMutex;
+}
+
+//______________________________________________________________________________
+TString AliOADBCache::FileKey(const char* fileName)
+{
+  // expanded file name, so that "$ALICE_PHYSICS/..." and the full path share one entry
+  TString key(fileName);
+  gSystem->ExpandPathName(key);
+  return key;
+}
+
+//______________________________________________________________________________
+TFile* AliOADBCache::GetFile(const char* fileName)
+{
+  // Open the file on first request, later requests return the same file.
+  // Files which cannot be opened are not remembered.
+  R__LOCKGUARD(fMutex);
+  TString key = FileKey(fileName);
+  std::map<TString,TFile*>::iterator it = fFiles.find(key);
+  if (it != fFiles.end()) return it->second;
+
+  // TFile::Open changes the current directory, which the caller may be using
+  TDirectory* savedDir = gDirectory;
+  TFile* file = TFile::Open(key);
+  if (savedDir) savedDir->cd();
+  if (!file || !file->IsOpen() || file->IsZombie()) {
+    AliErrorClass(Form("Cannot open OADB file %s", key.Data()));
+    delete file;
+    return 0;
+  }
+  fFiles[key] = file;
+  return file;
+}
+
+//______________________________________________________________________________
+TObject* AliOADBCache::GetFileObject(const char* fileName, const char* objectName)
+{
+  // Object stored directly in the file, e.g. a calibration histogram
+  R__LOCKGUARD(fMutex);
+  TString key = FileKey(fileName) + "#" + objectName;
+  std::map<TString,TObject*>::iterator it = fObjects.find(key);
+  if (it != fObjects.end()) return it->second;
+
+  TFile* file = GetFile(fileName);
+  if (!file) return 0;
+  TObject* obj = file->Get(objectName);
+  fObjects[key] = obj;
+  return obj;
+}
+
+//______________________________________________________________________________
+AliOADBContainer* AliOADBCache::GetContainer(const char* fileName, const char* containerName)
+{
+  // The container is read from the file once
+  R__LOCKGUARD(fMutex);
+  TString key = FileKey(fileName) + "#" + containerName;
+  std::map<TString,AliOADBContainer*>::iterator it = fContainers.find(key);
+  if (it != fContainers.end()) return it->second;
+
+  TFile* file = GetFile(fileName);
+  if (!file) return 0;
+  AliOADBContainer* container = dynamic_cast<AliOADBContainer*>(file->Get(containerName));
+  if (!container) {
+    AliErrorClass(Form("Cannot fetch OADB container %s from %s", containerName, fileName));
+    return 0;
+  }
+  fContainers[key] = container;
+  return container;
+}
+
+//______________________________________________________________________________
+TObject* AliOADBCache::GetObject(const char* fileName, const char* containerName, Int_t run,
+                                 const char* defaultName, const char* passName)
+{
+  // Object of the container for the run and pass, resolved once per
+  // (file, container, run, pass, default). Missing objects are remembered as well.
+  R__LOCKGUARD(fMutex);
+  TString key = Form("%s#%s#%d#%s#%s", FileKey(fileName).Data(), containerName, run, passName, defaultName);
+  std::map<TString,TObject*>::iterator it = fObjects.find(key);
+  if (it != fObjects.end()) return it->second;
+
+  AliOADBContainer* container = GetContainer(fileName, containerName);
+  if (!container) return 0;
+  TObject* obj = container->GetObject(run, defaultName, passName);
+  fObjects[key] = obj;
+  return obj;
+}
+
+//______________________________________________________________________________
+TObject* AliOADBCache::GetDefaultObject(const char* fileName, const char* containerName, const char* defaultName)
+{
+  // Default object of the container
+  R__LOCKGUARD(fMutex);
+  TString key = Form("%s#%s#default#%s", FileKey(fileName).Data(), containerName, defaultName);
+  std::map<TString,TObject*>::iterator it = fObjects.find(key);
+  if (it != fObjects.end()) return it->second;
+
+  AliOADBContainer* container = GetContainer(fileName, containerName);
+  if (!container) return 0;
+  TObject* obj = container->GetDefaultObject(defaultName);
+  fObjects[key] = obj;
+  return obj;
+}
+
+//______________________________________________________________________________
+void AliOADBCache::Print(Option_t* /*option*/) const
+{
+  // list the cached files and containers
+  R__LOCKGUARD(fMutex);
+  Printf("AliOADBCache: %d files, %d containers, %d objects",
+         (Int_t)fFiles.size(), (Int_t)fContainers.size(), (Int_t)fObjects.size());
+  for (std::map<TString,TFile*>::const_iterator it = fFiles.begin(); it != fFiles.end(); ++it)
+    Printf("  file      %s", it->first.Data());
+  for (std::map<TString,AliOADBContainer*>::const_iterator it = fContainers.begin(); it != fContainers.end(); ++it)
+    Printf("  container %s", it->first.Data());
+}
@@ -0,0 +1,63 @@
+#ifndef ALIOADBCACHE_H
+#define ALIOADBCACHE_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//     Process wide cache of OADB files, containers and objects
+//
+//     Every OADB file is opened once per process and every container is
+//     read once. The object of a container for a given (run, pass) is
+//     resolved once and the same instance is returned to all callers,
+//     e.g. all wagons of a train asking for the physics selection of the
+//     same run:
+//
+//       AliOADBPhysicsSelection* ps = (AliOADBPhysicsSelection*)
+//         AliOADBCache::Instance()->GetObject(fileName,"physSel",run,"oadbDefaultPP");
+//
+//     The returned objects belong to the cache and are shared: they must
+//     not be deleted nor modified by the caller (Clone() them if needed).
+//     All methods are serialised with a mutex.
+//-------------------------------------------------------------------------
+
+#include <map>
+#include <TObject.h>
+#include <TString.h>
+
+class TFile;
+class TMutex;
+class AliOADBContainer;
+
+class AliOADBCache : public TObject
+{
+ public :
+  static AliOADBCache* Instance();
+  virtual ~AliOADBCache();
+
+  TFile*            GetFile(const char* fileName);
+  TObject*          GetFileObject(const char* fileName, const char* objectName);
+  AliOADBContainer* GetContainer(const char* fileName, const char* containerName);
+  TObject*          GetObject(const char* fileName, const char* containerName, Int_t run,
+                              const char* defaultName = "", const char* passName = "");
+  TObject*          GetDefaultObject(const char* fileName, const char* containerName, const char* defaultName);
+
+  Int_t GetNFiles()   const {return fFiles.size();}
+  Int_t GetNObjects() const {return fObjects.size();}
+  virtual void Print(Option_t* option = "") const;
+
+ private:
+  AliOADBCache();
+  AliOADBCache(const AliOADBCache& cache);
+  AliOADBCache& operator=(const AliOADBCache& cache);
+
+  static TString FileKey(const char* fileName);
+
+  TMutex*                             fMutex;      //! serialises all lookups
+  std::map<TString,TFile*>            fFiles;      //! open files by expanded name
+  std::map<TString,AliOADBContainer*> fContainers; //! containers by file and name
+  std::map<TString,TObject*>          fObjects;    //! resolved objects, including misses (0)
+
+  ClassDef(AliOADBCache, 1);
+};
+
+#endif
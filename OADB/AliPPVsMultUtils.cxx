@@ -23,6 +23,7 @@
 #include "AliESDtrackCuts.h"
 #include "AliPPVsMultUtils.h"
 #include <TFile.h>
+#include "AliOADBCache.h"
 #include "AliAODHeader.h"
 #include "AliInputEventHandler.h"
 #include "AliAnalysisManager.h"
@@ -297,129 +298,47 @@ Bool_t AliPPVsMultUtils::LoadCalibration(Int_t lLoadThisCalibration)
     }
 
     AliInfo(Form( "Loading calibration file for run %i",lLoadThisCalibration) );
-    TFile *lCalibFile_V0M = 0x0;
-    TFile *lCalibFile_V0A = 0x0;
-    TFile *lCalibFile_V0C = 0x0;
-    TFile *lCalibFile_V0MEq = 0x0;
-    TFile *lCalibFile_V0AEq = 0x0;
-    TFile *lCalibFile_V0CEq = 0x0;
-    TFile *lCalibFile_V0B = 0x0;
-    TFile *lCalibFile_V0Apartial = 0x0;
-    TFile *lCalibFile_V0Cpartial = 0x0;
-    TFile *lCalibFile_V0S = 0x0;
-    TFile *lCalibFile_V0SB = 0x0;
-    TFile *lCalibFile_Averages = 0x0;
-
-    //AliInfo("Calling TFile::Open");
-    lCalibFile_V0M = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0M.root");
-    lCalibFile_V0A = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0A.root");
-    lCalibFile_V0C = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0C.root");
-    lCalibFile_V0MEq = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0MEq.root");
-    lCalibFile_V0AEq = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0AEq.root");
-    lCalibFile_V0CEq = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0CEq.root");
-    lCalibFile_V0B = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0B.root");
-    lCalibFile_V0Apartial = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0Apartial.root");
-    lCalibFile_V0Cpartial = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0Cpartial.root");
-    lCalibFile_V0S = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0S.root");
-    lCalibFile_V0SB = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calibration_adaptive_V0SB.root");
-    lCalibFile_Averages = TFile::Open("$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/calib-averages.root");
-
-    //AliInfo("Casting");
-    fBoundaryHisto_V0M        = dynamic_cast<TH1F *>(lCalibFile_V0M  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0A        = dynamic_cast<TH1F *>(lCalibFile_V0A  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0C        = dynamic_cast<TH1F *>(lCalibFile_V0C  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0MEq      = dynamic_cast<TH1F *>(lCalibFile_V0MEq  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0AEq      = dynamic_cast<TH1F *>(lCalibFile_V0AEq  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0CEq      = dynamic_cast<TH1F *>(lCalibFile_V0CEq  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0B        = dynamic_cast<TH1F *>(lCalibFile_V0B  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0Apartial = dynamic_cast<TH1F *>(lCalibFile_V0Apartial  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0Cpartial = dynamic_cast<TH1F *>(lCalibFile_V0Cpartial  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0S        = dynamic_cast<TH1F *>(lCalibFile_V0S  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
-    fBoundaryHisto_V0SB       = dynamic_cast<TH1F *>(lCalibFile_V0SB  -> Get(Form("histocalib%i",lLoadThisCalibration)) );
+    //The calibration files are opened once per process and shared with the
+    //other tasks (AliOADBCache), the histograms of this run are copied
+    AliOADBCache *lOADBCache = AliOADBCache::Instance();
+    const TString lCalibPath = "$ALICE_PHYSICS/PWGLF/STRANGENESS/Cascades/corrections/";
+    const TString lHistoName = Form("histocalib%i",lLoadThisCalibration);
+
+    TH1F *lBoundaryHisto_V0M = dynamic_cast<TH1F *>(lOADBCache->GetFileObject(lCalibPath+"calibration_adaptive_V0M.root",lHistoName));
+    TH1F *lBoundaryHisto_V0A = dynamic_cast<TH1F *>(lOADBCache->GetFileObject(lCalibPath+"calibration_adaptive_V0A.root",lHistoName));
+    TH1F *lBoundaryHisto_V0C = dynamic_cast<TH1F *>(lOADBCache->GetFileObject(lCalibPath+"calibration_adaptive_V0C.root",lHistoName));
+    TH1F *lBoundaryHisto_V0MEq = dynamic_cast<TH1F *>(lOADBCache->GetFileObject(lCalibPath+"calibration_adaptive_V0MEq.root",lHistoName));
+    TH1F *lBoundaryHisto_V0AEq = dynamic_cast<TH1F *>(lOADBCache->GetFileObject(lCalibPath+"calibration_adaptive_V0AEq.root",lHistoName));
+    TH1F *lBoundaryHisto_V0CEq = dynamic_cast<TH1F *>(lOADBCache->GetFileObject(lCalibPath+"calibration_adaptive_V0CEq.root",lHistoName));
+    TH1F *lBoundaryHisto_V0B = dynamic_cast<TH1F *>(lOADBCache->GetFileObject(lCalibPath+"calibration_adaptive_V0B.root",lHistoName));
+    TH1F *lBoundaryHisto_V0Apartial = dynamic_cast<TH1F *>(lOADBCache->GetFileObject(lCalibPath+"calibration_adaptive_V0Apartial.root",lHistoName));
+    TH1F *lBoundaryHisto_V0Cpartial = dynamic_cast<TH1F *>(lOADBCache->GetFileObject(lCalibPath+"calibration_adaptive_V0Cpartial.root",lHistoName));
+    TH1F *lBoundaryHisto_V0S = dynamic_cast<TH1F *>(lOADBCache->GetFileObject(lCalibPath+"calibration_adaptive_V0S.root",lHistoName));
+    TH1F *lBoundaryHisto_V0SB = dynamic_cast<TH1F *>(lOADBCache->GetFileObject(lCalibPath+"calibration_adaptive_V0SB.root",lHistoName));
 
     //Average Amplitudes for weighting
-    fAverageAmplitudes       = dynamic_cast<TH1D *>(lCalibFile_Averages  -> Get(Form("hcalib_averages_%i",lLoadThisCalibration)) );
+    TH1D *lAverageAmplitudes = dynamic_cast<TH1D *>(lOADBCache->GetFileObject(lCalibPath+"calib-averages.root",Form("hcalib_averages_%i",lLoadThisCalibration)));
 
-    if ( !fBoundaryHisto_V0M   || !fBoundaryHisto_V0A   || !fBoundaryHisto_V0C ||
-            !fBoundaryHisto_V0MEq || !fBoundaryHisto_V0AEq || !fBoundaryHisto_V0CEq || !fBoundaryHisto_V0B || !fBoundaryHisto_V0Apartial || !fBoundaryHisto_V0Cpartial ||
-            !fBoundaryHisto_V0S || !fBoundaryHisto_V0SB || !fAverageAmplitudes ) {
+    if ( !lBoundaryHisto_V0M   || !lBoundaryHisto_V0A   || !lBoundaryHisto_V0C ||
+            !lBoundaryHisto_V0MEq || !lBoundaryHisto_V0AEq || !lBoundaryHisto_V0CEq || !lBoundaryHisto_V0B || !lBoundaryHisto_V0Apartial || !lBoundaryHisto_V0Cpartial ||
+            !lBoundaryHisto_V0S || !lBoundaryHisto_V0SB || !lAverageAmplitudes ) {
         AliInfo(Form("No calibration for run %i exists at the moment!",lLoadThisCalibration));
-        if( lCalibFile_V0M ) {
-            lCalibFile_V0M->Close();
-            lCalibFile_V0M->Delete();
-            delete lCalibFile_V0M;
-        }
-        if( lCalibFile_V0A ) {
-            lCalibFile_V0A->Close();
-            lCalibFile_V0A->Delete();
-            delete lCalibFile_V0A;
-        }
-        if( lCalibFile_V0C ) {
-            lCalibFile_V0C->Close();
-            lCalibFile_V0C->Delete();
-            delete lCalibFile_V0C;
-        }
-        if( lCalibFile_V0MEq ) {
-            lCalibFile_V0MEq->Close();
-            lCalibFile_V0MEq->Delete();
-            delete lCalibFile_V0MEq;
-        }
-        if( lCalibFile_V0AEq ) {
-            lCalibFile_V0AEq->Close();
-            lCalibFile_V0AEq->Delete();
-            delete lCalibFile_V0AEq;
-        }
-        if( lCalibFile_V0CEq ) {
-            lCalibFile_V0CEq->Close();
-            lCalibFile_V0CEq->Delete();
-            delete lCalibFile_V0CEq;
-        }
-        if( lCalibFile_V0B ) {
-            lCalibFile_V0B->Close();
-            lCalibFile_V0B->Delete();
-            delete lCalibFile_V0B;
-        }
-        if( lCalibFile_V0Apartial ) {
-            lCalibFile_V0Apartial->Close();
-            lCalibFile_V0Apartial->Delete();
-            delete lCalibFile_V0Apartial;
-        }
-        if( lCalibFile_V0Cpartial ) {
-            lCalibFile_V0Cpartial->Close();
-            lCalibFile_V0Cpartial->Delete();
-            delete lCalibFile_V0Cpartial;
-        }
-        if( lCalibFile_V0S ) {
-            lCalibFile_V0S->Close();
-            lCalibFile_V0S->Delete();
-            delete lCalibFile_V0S;
-        }
-        if( lCalibFile_V0SB ) {
-            lCalibFile_V0SB->Close();
-            lCalibFile_V0SB->Delete();
-            delete lCalibFile_V0SB;
-        }
-        if( lCalibFile_Averages ) {
-            lCalibFile_Averages->Close();
-            lCalibFile_Averages->Delete();
-            delete lCalibFile_Averages;
-        }
         fRunNumber = lLoadThisCalibration;
         return kFALSE; //return denial
     }
 
-    fBoundaryHisto_V0M->SetName("fBoundaryHisto_V0M");
-    fBoundaryHisto_V0A->SetName("fBoundaryHisto_V0A");
-    fBoundaryHisto_V0C->SetName("fBoundaryHisto_V0C");
-    fBoundaryHisto_V0MEq->SetName("fBoundaryHisto_V0MEq");
-    fBoundaryHisto_V0AEq->SetName("fBoundaryHisto_V0AEq");
-    fBoundaryHisto_V0CEq->SetName("fBoundaryHisto_V0CEq");
-    fBoundaryHisto_V0B->SetName("fBoundaryHisto_V0B");
-    fBoundaryHisto_V0Apartial->SetName("fBoundaryHisto_V0Apartial");
-    fBoundaryHisto_V0Cpartial->SetName("fBoundaryHisto_V0Cpartial");
-    fBoundaryHisto_V0S->SetName("fBoundaryHisto_V0S");
-    fBoundaryHisto_V0SB->SetName("fBoundaryHisto_V0SB");
-    fAverageAmplitudes->SetName("fBoundaryHisto_V0SB");
+    fBoundaryHisto_V0M = (TH1F*) lBoundaryHisto_V0M->Clone("fBoundaryHisto_V0M");
+    fBoundaryHisto_V0A = (TH1F*) lBoundaryHisto_V0A->Clone("fBoundaryHisto_V0A");
+    fBoundaryHisto_V0C = (TH1F*) lBoundaryHisto_V0C->Clone("fBoundaryHisto_V0C");
+    fBoundaryHisto_V0MEq = (TH1F*) lBoundaryHisto_V0MEq->Clone("fBoundaryHisto_V0MEq");
+    fBoundaryHisto_V0AEq = (TH1F*) lBoundaryHisto_V0AEq->Clone("fBoundaryHisto_V0AEq");
+    fBoundaryHisto_V0CEq = (TH1F*) lBoundaryHisto_V0CEq->Clone("fBoundaryHisto_V0CEq");
+    fBoundaryHisto_V0B = (TH1F*) lBoundaryHisto_V0B->Clone("fBoundaryHisto_V0B");
+    fBoundaryHisto_V0Apartial = (TH1F*) lBoundaryHisto_V0Apartial->Clone("fBoundaryHisto_V0Apartial");
+    fBoundaryHisto_V0Cpartial = (TH1F*) lBoundaryHisto_V0Cpartial->Clone("fBoundaryHisto_V0Cpartial");
+    fBoundaryHisto_V0S = (TH1F*) lBoundaryHisto_V0S->Clone("fBoundaryHisto_V0S");
+    fBoundaryHisto_V0SB = (TH1F*) lBoundaryHisto_V0SB->Clone("fBoundaryHisto_V0SB");
+    fAverageAmplitudes = (TH1D*) lAverageAmplitudes->Clone("fBoundaryHisto_V0SB");
 
     //Careful with manual cleanup if needed: to be implemented
     fBoundaryHisto_V0M->SetDirectory(0);
@@ -435,68 +354,6 @@ Bool_t AliPPVsMultUtils::LoadCalibration(Int_t lLoadThisCalibration)
     fBoundaryHisto_V0SB->SetDirectory(0);
     fAverageAmplitudes->SetDirectory(0);
 
-    //AliInfo("Closing");
-    if( lCalibFile_V0M ) {
-        lCalibFile_V0M->Close();
-        lCalibFile_V0M->Delete();
-        delete lCalibFile_V0M;
-    }
-    if( lCalibFile_V0A ) {
-        lCalibFile_V0A->Close();
-        lCalibFile_V0A->Delete();
-        delete lCalibFile_V0A;
-    }
-    if( lCalibFile_V0C ) {
-        lCalibFile_V0C->Close();
-        lCalibFile_V0C->Delete();
-        delete lCalibFile_V0C;
-    }
-    if( lCalibFile_V0MEq ) {
-        lCalibFile_V0MEq->Close();
-        lCalibFile_V0MEq->Delete();
-        delete lCalibFile_V0MEq;
-    }
-    if( lCalibFile_V0AEq ) {
-        lCalibFile_V0AEq->Close();
-        lCalibFile_V0AEq->Delete();
-        delete lCalibFile_V0AEq;
-    }
-    if( lCalibFile_V0CEq ) {
-        lCalibFile_V0CEq->Close();
-        lCalibFile_V0CEq->Delete();
-        delete lCalibFile_V0CEq;
-    }
-    if( lCalibFile_V0B ) {
-        lCalibFile_V0B->Close();
-        lCalibFile_V0B->Delete();
-        delete lCalibFile_V0B;
-    }
-    if( lCalibFile_V0Apartial ) {
-        lCalibFile_V0Apartial->Close();
-        lCalibFile_V0Apartial->Delete();
-        delete lCalibFile_V0Apartial;
-    }
-    if( lCalibFile_V0Cpartial ) {
-        lCalibFile_V0Cpartial->Close();
-        lCalibFile_V0Cpartial->Delete();
-        delete lCalibFile_V0Cpartial;
-    }
-    if( lCalibFile_V0S ) {
-        lCalibFile_V0S->Close();
-        lCalibFile_V0S->Delete();
-        delete lCalibFile_V0S;
-    }
-    if( lCalibFile_V0SB ) {
-        lCalibFile_V0SB->Close();
-        lCalibFile_V0SB->Delete();
-        delete lCalibFile_V0SB;
-    }
-    if( lCalibFile_Averages ) {
-        lCalibFile_Averages->Close();
-        lCalibFile_Averages->Delete();
-        delete lCalibFile_Averages;
-    }
-
     fRunNumber = lLoadThisCalibration; //Loaded!
     AliInfo(Form("Finished loading calibration for run %i",lLoadThisCalibration));
     return kTRUE;
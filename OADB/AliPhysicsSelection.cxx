@@ -95,6 +95,7 @@
 #include "AliAnalysisManager.h"
 #include "TPRegexp.h"
 #include "TFile.h"
+#include "AliOADBCache.h"
 #include "AliOADBContainer.h"
 #include "AliOADBPhysicsSelection.h"
 #include "AliOADBFillingScheme.h"
@@ -131,6 +132,8 @@ fHistStat(0),
 fPSOADB(0),
 fFillOADB(0),
 fTriggerOADB(0),
+fPSOADBShared(kFALSE),
+fFillOADBShared(kFALSE),
 fTriggerToFormula(new StringToFormula()),
 fTriggerToRegexp(new StringToRegexp())
 {
@@ -161,6 +164,8 @@ AliPhysicsSelection::AliPhysicsSelection(const char *name) :
  fPSOADB(0),
  fFillOADB(0),
  fTriggerOADB(0),
+ fPSOADBShared(kFALSE),
+ fFillOADBShared(kFALSE),
  fTriggerToFormula(new StringToFormula()),
  fTriggerToRegexp(new StringToRegexp())
  {
@@ -174,8 +179,8 @@ AliPhysicsSelection::AliPhysicsSelection(const char *name) :
  }
 
 AliPhysicsSelection::~AliPhysicsSelection(){
-  if (fPSOADB)       delete fPSOADB;
-  if (fFillOADB)     delete fFillOADB;
+  if (fPSOADB && !fPSOADBShared)     delete fPSOADB;
+  if (fFillOADB && !fFillOADBShared) delete fFillOADB;
   if (fTriggerOADB)  delete fTriggerOADB;
   delete fTriggerToFormula;
   delete fTriggerToRegexp;
@@ -358,32 +363,36 @@ Bool_t AliPhysicsSelection::Initialize(Int_t runNumber){
   Bool_t oldStatus = TH1::AddDirectoryStatus();
   TH1::AddDirectory(kFALSE);
   
-  /// Open OADB file and fetch OADB objects
+  /// Fetch OADB objects, the file and the containers are shared by all
+  /// instances in the process through AliOADBCache
   TString oadbfilename = AliPhysicsSelection::GetOADBFileName();
-  
-  TFile * foadb = TFile::Open(oadbfilename);
-  if(!foadb->IsOpen()) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
+  AliOADBCache* oadbCache = AliOADBCache::Instance();
+  if(!oadbCache->GetFile(oadbfilename)) AliFatal(Form("Cannot open OADB file %s", oadbfilename.Data()));
   
   if(!fPSOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
     AliInfo("Using Standard OADB");
-    AliOADBContainer * psContainer = (AliOADBContainer*) foadb->Get("physSel");
-    if (!psContainer) AliFatal("Cannot fetch OADB container for Physics selection");
-    fPSOADB = (AliOADBPhysicsSelection*) psContainer->GetObject(runNumber, fIsPP ? "oadbDefaultPP" : "oadbDefaultPbPb",fPassName);
+    if (!oadbCache->GetContainer(oadbfilename,"physSel")) AliFatal("Cannot fetch OADB container for Physics selection");
+    if (fPSOADB && !fPSOADBShared) delete fPSOADB;
+    fPSOADB = (AliOADBPhysicsSelection*) oadbCache->GetObject(oadbfilename,"physSel",runNumber, fIsPP ? "oadbDefaultPP" : "oadbDefaultPbPb",fPassName);
+    fPSOADBShared = kTRUE;
     if (!fPSOADB) AliFatal(Form("Cannot find physics selection object for run %d", runNumber));
   } else {
     AliInfo("Using Custom OADB");
   }
   if(!fFillOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
-    AliOADBContainer * fillContainer = (AliOADBContainer*) foadb->Get("fillScheme");
-    if (!fillContainer) AliFatal("Cannot fetch OADB container for filling scheme");
-    fFillOADB = (AliOADBFillingScheme*) fillContainer->GetObject(runNumber, "Default",fPassName);
+    if (!oadbCache->GetContainer(oadbfilename,"fillScheme")) AliFatal("Cannot fetch OADB container for filling scheme");
+    if (fFillOADB && !fFillOADBShared) delete fFillOADB;
+    fFillOADB = (AliOADBFillingScheme*) oadbCache->GetObject(oadbfilename,"fillScheme",runNumber, "Default",fPassName);
+    fFillOADBShared = kTRUE;
     if (!fFillOADB) AliFatal(Form("Cannot find  filling scheme object for run %d", runNumber));
   }
   if(!fTriggerOADB || !fUsingCustomClasses) { // if it's already set and custom class is required, we use the one provided by the user
-    AliOADBContainer * triggerContainer = (AliOADBContainer*) foadb->Get("trigAnalysis");
-    if (!triggerContainer) AliFatal("Cannot fetch OADB container for trigger analysis");
-    fTriggerOADB = (AliOADBTriggerAnalysis*) triggerContainer->GetObject(runNumber, "Default",fPassName);
-    if (!fTriggerOADB) AliFatal(Form("Cannot find  trigger analysis object for run %d", runNumber));
+    if (!oadbCache->GetContainer(oadbfilename,"trigAnalysis")) AliFatal("Cannot fetch OADB container for trigger analysis");
+    AliOADBTriggerAnalysis* triggerOADB = (AliOADBTriggerAnalysis*) oadbCache->GetObject(oadbfilename,"trigAnalysis",runNumber, "Default",fPassName);
+    if (!triggerOADB) AliFatal(Form("Cannot find  trigger analysis object for run %d", runNumber));
+    // private copy, the thresholds may be updated from the OCDB below
+    delete fTriggerOADB;
+    fTriggerOADB = (AliOADBTriggerAnalysis*) triggerOADB->Clone();
     fTriggerOADB->Print();
   }
   
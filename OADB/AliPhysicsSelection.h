@@ -86,7 +86,7 @@ public:
   
   void SetAnalyzeMC(Bool_t flag = kTRUE) { fMC = flag; }
   void SetUseBXNumbers(Bool_t flag = kTRUE) {fUseBXNumbers = flag;}
-  void SetCustomOADBObjects(AliOADBPhysicsSelection * oadbPS, AliOADBFillingScheme * oadbFS, AliOADBTriggerAnalysis * oadbTA = 0) { fPSOADB = oadbPS; fFillOADB = oadbFS; fTriggerOADB = oadbTA; fUsingCustomClasses = kTRUE;}
+  void SetCustomOADBObjects(AliOADBPhysicsSelection * oadbPS, AliOADBFillingScheme * oadbFS, AliOADBTriggerAnalysis * oadbTA = 0) { fPSOADB = oadbPS; fFillOADB = oadbFS; fTriggerOADB = oadbTA; fPSOADBShared = kFALSE; fFillOADBShared = kFALSE; fUsingCustomClasses = kTRUE;}
   
   virtual TObject *GetStatistics(const Option_t *option) const { return fHistList.FindObject("fHistStat"); }
   void SetBin0Callback( const char * cb) { AliError("This method is deprecated"); } 
@@ -121,6 +121,8 @@ protected:
   AliOADBPhysicsSelection* fPSOADB;      // Physics selection OADB object
   AliOADBFillingScheme*    fFillOADB;    // Filling scheme OADB object
   AliOADBTriggerAnalysis*  fTriggerOADB; // Trigger analysis OADB object
+  Bool_t fPSOADBShared;                   //! fPSOADB belongs to AliOADBCache
+  Bool_t fFillOADBShared;                 //! fFillOADB belongs to AliOADBCache
 
   StringToFormula *fTriggerToFormula; //! Map trigger strings to TFormulas
   FormulaAndBits& FindForumla(const char* triggerLogic); //! Returns pair of TFormula and trigger bits
@@ -128,7 +130,7 @@ protected:
   StringToRegexp* fTriggerToRegexp; //!
   TPRegexp& FindRegexp(const std::string& triggers) const;
 
-  ClassDef(AliPhysicsSelection, 24)
+  ClassDef(AliPhysicsSelection, 25)
 private:
   AliPhysicsSelection(const AliPhysicsSelection&);
   AliPhysicsSelection& operator=(const AliPhysicsSelection&);
@@ -20,18 +20,187 @@
 #include "TBrowser.h"
 #include "TFormula.h"
 #include "RVersion.h"
+#include <cstdlib>
+#include <cstring>
 
 ClassImp(AliMultEstimator);
+
+namespace {
+    //Instruction set of the compiled estimator definitions. Operands follow
+    //their op code in the program: kPushConst <index in constants>,
+    //kPushVar <index of the input variable>
+    enum EOpCode {
+        kPushConst, kPushVar,
+        kAdd, kSub, kMul, kDiv, kNeg, kNot,
+        kLess, kGreater, kLessEq, kGreaterEq, kEqual, kNotEqual,
+        kAnd, kOr, kSelect
+    };
+    const Int_t kMaxStack = 64;
+    
+    //Recursive descent parser for the subset of the TFormula syntax used in
+    //estimator definitions: numbers, parameters [i], + - * /, unary - + !,
+    //comparisons, && || and the ternary operator, with C precedence.
+    //Anything else makes the compilation fail.
+    class AliMultEstimatorCompiler {
+    public:
+        AliMultEstimatorCompiler(const char* lExpr, std::vector<Int_t>& lCode, std::vector<Double_t>& lConstants)
+        : fExpr(lExpr), fPos(0), fDepth(0), fMaxDepth(0), fCode(lCode), fConstants(lConstants) {}
+        
+        Bool_t Run() {
+            fCode.clear();
+            fConstants.clear();
+            if (!Ternary()) return kFALSE;
+            SkipSpaces();
+            return fExpr[fPos] == 0 && fDepth == 1 && fMaxDepth <= kMaxStack;
+        }
+        
+    private:
+        void SkipSpaces() { while (fExpr[fPos] == ' ' || fExpr[fPos] == '\t') fPos++; }
+        Bool_t Accept(const char* lToken) {
+            SkipSpaces();
+            Int_t n = strlen(lToken);
+            if (strncmp(fExpr+fPos, lToken, n) != 0) return kFALSE;
+            fPos += n;
+            return kTRUE;
+        }
+        void Push(Int_t lOp, Int_t lOperand) {
+            fCode.push_back(lOp);
+            fCode.push_back(lOperand);
+            if (++fDepth > fMaxDepth) fMaxDepth = fDepth;
+        }
+        void Emit(Int_t lOp, Int_t lNPop) {
+            fCode.push_back(lOp);
+            fDepth -= lNPop-1;
+        }
+        
+        Bool_t Ternary() {
+            if (!Or()) return kFALSE;
+            if (!Accept("?")) return kTRUE;
+            if (!Ternary()) return kFALSE;
+            if (!Accept(":")) return kFALSE;
+            if (!Ternary()) return kFALSE;
+            Emit(kSelect, 3);
+            return kTRUE;
+        }
+        Bool_t Or() {
+            if (!And()) return kFALSE;
+            while (Accept("||")) { if (!And()) return kFALSE; Emit(kOr, 2); }
+            return kTRUE;
+        }
+        Bool_t And() {
+            if (!Equality()) return kFALSE;
+            while (Accept("&&")) { if (!Equality()) return kFALSE; Emit(kAnd, 2); }
+            return kTRUE;
+        }
+        Bool_t Equality() {
+            if (!Relational()) return kFALSE;
+            for (;;) {
+                Int_t lOp;
+                if      (Accept("==")) lOp = kEqual;
+                else if (Accept("!=")) lOp = kNotEqual;
+                else return kTRUE;
+                if (!Relational()) return kFALSE;
+                Emit(lOp, 2);
+            }
+        }
+        Bool_t Relational() {
+            if (!Additive()) return kFALSE;
+            for (;;) {
+                Int_t lOp;
+                if      (Accept("<=")) lOp = kLessEq;
+                else if (Accept(">=")) lOp = kGreaterEq;
+                else if (Accept("<"))  lOp = kLess;
+                else if (Accept(">"))  lOp = kGreater;
+                else return kTRUE;
+                if (!Additive()) return kFALSE;
+                Emit(lOp, 2);
+            }
+        }
+        Bool_t Additive() {
+            if (!Multiplicative()) return kFALSE;
+            for (;;) {
+                Int_t lOp;
+                if      (Accept("+")) lOp = kAdd;
+                else if (Accept("-")) lOp = kSub;
+                else return kTRUE;
+                if (!Multiplicative()) return kFALSE;
+                Emit(lOp, 2);
+            }
+        }
+        Bool_t Multiplicative() {
+            if (!Unary()) return kFALSE;
+            for (;;) {
+                Int_t lOp;
+                if      (Accept("*")) lOp = kMul;
+                else if (Accept("/")) lOp = kDiv;
+                else return kTRUE;
+                if (!Unary()) return kFALSE;
+                Emit(lOp, 2);
+            }
+        }
+        Bool_t Unary() {
+            SkipSpaces();
+            //"!=" is not a unary operator
+            if (fExpr[fPos] == '!' && fExpr[fPos+1] != '=') {
+                fPos++;
+                if (!Unary()) return kFALSE;
+                Emit(kNot, 1);
+                return kTRUE;
+            }
+            if (Accept("-")) {
+                if (!Unary()) return kFALSE;
+                Emit(kNeg, 1);
+                return kTRUE;
+            }
+            if (Accept("+")) return Unary();
+            return Primary();
+        }
+        Bool_t Primary() {
+            SkipSpaces();
+            const char c = fExpr[fPos];
+            if (c == '(') {
+                fPos++;
+                if (!Ternary()) return kFALSE;
+                return Accept(")");
+            }
+            if (c == '[') {
+                char* lEnd = 0;
+                long lIndex = strtol(fExpr+fPos+1, &lEnd, 10);
+                if (lEnd == fExpr+fPos+1 || *lEnd != ']' || lIndex < 0) return kFALSE;
+                fPos = lEnd+1-fExpr;
+                Push(kPushVar, lIndex);
+                return kTRUE;
+            }
+            if ((c >= '0' && c <= '9') || c == '.') {
+                char* lEnd = 0;
+                Double_t lValue = strtod(fExpr+fPos, &lEnd);
+                if (lEnd == fExpr+fPos) return kFALSE;
+                fPos = lEnd-fExpr;
+                fConstants.push_back(lValue);
+                Push(kPushConst, fConstants.size()-1);
+                return kTRUE;
+            }
+            return kFALSE;
+        }
+        
+        const char* fExpr;
+        Int_t fPos;
+        Int_t fDepth;
+        Int_t fMaxDepth;
+        std::vector<Int_t>& fCode;
+        std::vector<Double_t>& fConstants;
+    };
+}
 //________________________________________________________________
 AliMultEstimator::AliMultEstimator() :
-  TNamed(), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+  TNamed(), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0), fCode(), fConstants(),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
   // Constructor
   
 }
 AliMultEstimator::AliMultEstimator(const char * name, const char * title, TString lInitDef):
-TNamed(name,title), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+TNamed(name,title), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0), fCode(), fConstants(),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
     //Named, titled, definition constructor
@@ -46,6 +215,8 @@ fValue(e.fValue),
 fMean(e.fMean),
 fPercentile(e.fPercentile),
 fFormula(0),
+fCode(e.fCode),
+fConstants(e.fConstants),
 fkUseAnchor(e.fkUseAnchor),
 fAnchorPoint(e.fAnchorPoint),
 fAnchorPercentile(e.fAnchorPercentile)
@@ -67,6 +238,8 @@ AliMultEstimator& AliMultEstimator::operator=(const AliMultEstimator& e)
     if (fFormula) delete fFormula;
     fFormula = 0;
     if (e.fFormula) fFormula = new TFormula(*e.fFormula);
+    fCode        = e.fCode;
+    fConstants   = e.fConstants;
     
     //Anchor point configs
     fkUseAnchor         = e.fkUseAnchor;
@@ -121,20 +294,70 @@ void AliMultEstimator::SetupFormula(const AliMultInput* lInput)
         lVarName.Prepend("(");
         expr.ReplaceAll(lVarName, repl);
     }
+    if (fFormula) delete fFormula;
+    fFormula = 0;
+    //The known syntax is compiled once, other definitions go through TFormula
+    if (Compile(expr)) return;
     fFormula = new TFormula(Form("e%s", GetName()), expr);
 #if ROOT_VERSION_CODE < ROOT_VERSION(5,99,4)
     fFormula->Optimize();
 #endif
 }
 //________________________________________________________________
+Bool_t AliMultEstimator::Compile(const TString& lExpression)
+{
+    AliMultEstimatorCompiler lCompiler(lExpression.Data(), fCode, fConstants);
+    if (lCompiler.Run()) return kTRUE;
+    fCode.clear();
+    fConstants.clear();
+    return kFALSE;
+}
+//________________________________________________________________
+Double_t AliMultEstimator::Execute(const Double_t* lValues, Long_t lNValues) const
+{
+    Double_t lStack[kMaxStack];
+    Int_t    lTop = -1;
+    const Int_t* lCode = &fCode[0];
+    const Int_t  lSize = fCode.size();
+    for (Int_t i = 0; i < lSize; i++) {
+        switch (lCode[i]) {
+            case kPushConst: lStack[++lTop] = fConstants[lCode[++i]]; break;
+            case kPushVar: {
+                const Int_t lIdx = lCode[++i];
+                lStack[++lTop] = lIdx < lNValues ? lValues[lIdx] : 0.;
+                break;
+            }
+            case kAdd:       lTop--; lStack[lTop] += lStack[lTop+1]; break;
+            case kSub:       lTop--; lStack[lTop] -= lStack[lTop+1]; break;
+            case kMul:       lTop--; lStack[lTop] *= lStack[lTop+1]; break;
+            case kDiv:       lTop--; lStack[lTop] /= lStack[lTop+1]; break;
+            case kNeg:       lStack[lTop] = -lStack[lTop]; break;
+            case kNot:       lStack[lTop] = !lStack[lTop]; break;
+            case kLess:      lTop--; lStack[lTop] = lStack[lTop] <  lStack[lTop+1]; break;
+            case kGreater:   lTop--; lStack[lTop] = lStack[lTop] >  lStack[lTop+1]; break;
+            case kLessEq:    lTop--; lStack[lTop] = lStack[lTop] <= lStack[lTop+1]; break;
+            case kGreaterEq: lTop--; lStack[lTop] = lStack[lTop] >= lStack[lTop+1]; break;
+            case kEqual:     lTop--; lStack[lTop] = lStack[lTop] == lStack[lTop+1]; break;
+            case kNotEqual:  lTop--; lStack[lTop] = lStack[lTop] != lStack[lTop+1]; break;
+            case kAnd:       lTop--; lStack[lTop] = lStack[lTop] && lStack[lTop+1]; break;
+            case kOr:        lTop--; lStack[lTop] = lStack[lTop] || lStack[lTop+1]; break;
+            case kSelect:    lTop -= 2; lStack[lTop] = lStack[lTop] ? lStack[lTop+1] : lStack[lTop+2]; break;
+        }
+    }
+    return lStack[0];
+}
+//________________________________________________________________
 Float_t AliMultEstimator::Evaluate(const AliMultInput* lInput)
 {
+    std::vector<Double_t> lValues;
+    lInput->GetValues(lValues);
+    return Evaluate(lValues.empty() ? 0 : &lValues[0], lValues.size());
+}
+//________________________________________________________________
+Float_t AliMultEstimator::Evaluate(const Double_t* lValues, Long_t lNValues)
+{
+    if (!fCode.empty()) return fValue = Execute(lValues, lNValues);
     if (!fFormula) return fValue = 0;
-    for (Int_t i = 0; i < lInput->GetNVariables(); i++) {
-        AliMultVariable* v = lInput->GetVariable(i);
-        fFormula->SetParameter(i, v->IsInteger() ?
-                               v->GetValueInteger() :
-                               v->GetValue());
-    }
+    for (Long_t i = 0; i < lNValues; i++) fFormula->SetParameter(i, lValues[i]);
     return fValue = fFormula->Eval(0);
 }
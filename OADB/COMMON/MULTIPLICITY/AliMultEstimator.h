@@ -1,5 +1,6 @@
 #ifndef AliMultEstimator_H
 #define AliMultEstimator_H
+#include <vector>
 #include <TNamed.h>
 class AliMultInput;
 class TFormula;
@@ -43,6 +44,10 @@ public:
     //Pre-processing for speed
     void SetupFormula(const AliMultInput* lInput);
     Float_t Evaluate(const AliMultInput* lInput);
+    //Evaluation from the values of all input variables, in input order
+    //(see AliMultInput::GetValues)
+    Float_t Evaluate(const Double_t* lValues, Long_t lNValues);
+    Bool_t  IsCompiled() const { return !fCode.empty(); }
     
 private:
     TString fDefinition; //How to evaluate based on AliMultVariables
@@ -53,6 +58,12 @@ private:
     Float_t fPercentile;   //Percentile
     TFormula* fFormula; //!
     
+    //Definition compiled to a stack program, TFormula is only the fallback
+    Bool_t   Compile(const TString& lExpression);
+    Double_t Execute(const Double_t* lValues, Long_t lNValues) const;
+    std::vector<Int_t>    fCode;      //! op codes and operands
+    std::vector<Double_t> fConstants; //! numerical constants of the program
+    
     //Anchor point definition
     Bool_t  fkUseAnchor;        //Use Anchor Logic (default: No)
     Float_t fAnchorPoint;       //Raw value below which
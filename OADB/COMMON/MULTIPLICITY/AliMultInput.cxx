@@ -92,6 +92,20 @@ AliMultVariable* AliMultInput::GetVariable (Long_t iIdx) const
     return static_cast<AliMultVariable*>(fVariableList->At(iIdx));
 }
 
+void AliMultInput::GetValues(std::vector<Double_t>& lValues) const
+{
+    //Values of all variables in input order, in one pass over the list
+    //(integer variables are converted)
+    lValues.resize(fNVars);
+    if (!fVariableList) return;
+    TIter next(fVariableList);
+    AliMultVariable* var = 0;
+    Long_t i = 0;
+    while ((var = static_cast<AliMultVariable*>(next())) && i < fNVars) {
+        lValues[i++] = var->IsInteger() ? var->GetValueInteger() : var->GetValue();
+    }
+}
+
 void AliMultInput::Clear(Option_t* option)
 {
     TIter next(fVariableList);
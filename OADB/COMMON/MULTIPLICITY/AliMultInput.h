@@ -1,5 +1,6 @@
 #ifndef AliMultInput_H
 #define AliMultInput_H
+#include <vector>
 #include <TNamed.h>
 #include "AliMultVariable.h"
 
@@ -16,6 +17,7 @@ public:
     AliMultVariable* GetVariable (const TString& lName) const;
     AliMultVariable* GetVariable (Long_t iIdx) const;
     Long_t GetNVariables         () const { return fNVars; }
+    void GetValues (std::vector<Double_t>& lValues) const;
     void Clear(Option_t* option="");
     void Set(const AliMultInput* other);
     void Print(Option_t* option="") const;
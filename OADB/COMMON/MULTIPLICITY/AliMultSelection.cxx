@@ -239,11 +239,18 @@ void AliMultSelection::Evaluate( AliMultInput *lInput )
 //Master function to evaluate all existing estimators based on
 //a set of input variables. Error handling to be done with care...
 {
+    //Read all input variables once, then run each (compiled) estimator
+    //definition on the same value array
+    std::vector<Double_t> lValues;
+    lInput->GetValues(lValues);
+    const Double_t* lValueArray = lValues.empty() ? 0 : &lValues[0];
+    const Long_t    lNValues    = lValues.size();
+    
     //Loop over estimators defined in the acquired list
     AliMultEstimator* estimator = 0;
     TIter             next(fEstimatorList);
     while ((estimator = static_cast<AliMultEstimator*>(next())))
-        estimator->Evaluate(lInput);
+        estimator->Evaluate(lValueArray, lNValues);
 
 //deprecated evaluation
 #if 0
@@ -26,14 +26,134 @@
 #include "TList.h"
 #include "TFile.h"
 #include "TStopwatch.h"
+#include "TMath.h"
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <thread>
+#include <atomic>
 
 ClassImp(AliMultSelectionCalibrator);
 
+namespace {
+    //Values of one estimator in one run (range), filled once per accepted event
+    //in the single pass over fTreeEvent.
+    // - integer estimators: exact count per value
+    // - tolerance zero: all values are kept and sorted, as with the former
+    //   TTree::Draw + TMath::Sort procedure
+    // - tolerance > 0: values are counted in logarithmic buckets of relative
+    //   width lTolerance, any quantile is reproduced to within lTolerance of
+    //   the exact value with memory independent of the number of events
+    //   (default, see SetTolerance)
+    class AliMultCalibSample {
+    public:
+        AliMultCalibSample(Bool_t lIsInteger, Double_t lTolerance, Bool_t lUseAnchor, Float_t lAnchorPoint) :
+        fIsInteger(lIsInteger), fUseAnchor(lUseAnchor), fAnchorPoint(lAnchorPoint),
+        fLogGamma(0), fGamma(1), fEntries(0), fAccepted(0), fSum(0),
+        fMin(1e+6), fMax(-1e+3), fNZero(0), fSorted(kFALSE)
+        {
+            if ( !lIsInteger && lTolerance > 0 && lTolerance < 1 ){
+                fGamma    = (1.+lTolerance)/(1.-lTolerance);
+                fLogGamma = TMath::Log(fGamma);
+            }
+        }
+        
+        void Fill( Float_t lValue ){
+            fEntries++;
+            fSum += lValue;
+            if( lValue < fMin ) fMin = lValue;
+            if( lValue > fMax ) fMax = lValue;
+            if( fUseAnchor && lValue > fAnchorPoint ) fAccepted++;
+            if( fIsInteger ){
+                fCounts[lValue]++;
+            }else if( fLogGamma <= 0 ){
+                fValues.push_back(lValue);
+                fSorted = kFALSE;
+            }else if( lValue > 0 ){
+                fPositive[ Bucket(lValue) ]++;
+            }else if( lValue < 0 ){
+                fNegative[ Bucket(-lValue) ]++;
+            }else{
+                fNZero++;
+            }
+        }
+        
+        //Needed before GetValueAt in exact mode, thread-safe across samples
+        void Sort(){
+            if( fSorted ) return;
+            std::sort(fValues.begin(), fValues.end(), std::greater<Float_t>());
+            fSorted = kTRUE;
+        }
+        
+        //Value at position lPosition of the sample sorted in descending order
+        Float_t GetValueAt( Long64_t lPosition ) const {
+            if( fEntries < 1 ) return 0;
+            if( lPosition < 0 ) lPosition = 0;
+            if( lPosition > fEntries-1 ) lPosition = fEntries-1;
+            if( fLogGamma <= 0 ) return fValues[lPosition];
+            Long64_t lSeen = 0;
+            for( std::map<Int_t,Long64_t>::const_reverse_iterator it = fPositive.rbegin(); it != fPositive.rend(); ++it ){
+                lSeen += it->second;
+                if( lSeen > lPosition ) return Representative(it->first);
+            }
+            lSeen += fNZero;
+            if( lSeen > lPosition ) return 0;
+            for( std::map<Int_t,Long64_t>::const_iterator it = fNegative.begin(); it != fNegative.end(); ++it ){
+                lSeen += it->second;
+                if( lSeen > lPosition ) return -Representative(it->first);
+            }
+            return fMin;
+        }
+        
+        //Fill histogram with the exact distribution of an integer estimator
+        void FillHisto( TH1* lHisto ) const {
+            for( std::map<Float_t,Long64_t>::const_iterator it = fCounts.begin(); it != fCounts.end(); ++it )
+                lHisto->Fill( it->first, (Double_t) it->second );
+        }
+        
+        Long64_t GetEntries()  const { return fEntries;  }
+        Long64_t GetAccepted() const { return fAccepted; }
+        Double_t GetSum()      const { return fSum;      }
+        Double_t GetMin()      const { return fMin;      }
+        Double_t GetMax()      const { return fMax;      }
+        
+    private:
+        Int_t Bucket( Float_t lAbsValue ) const { return (Int_t) TMath::Ceil( TMath::Log(lAbsValue)/fLogGamma ); }
+        Float_t Representative( Int_t lBucket ) const { return 2.*TMath::Exp(lBucket*fLogGamma)/(fGamma+1.); }
+        
+        Bool_t   fIsInteger;
+        Bool_t   fUseAnchor;
+        Float_t  fAnchorPoint;
+        Double_t fLogGamma;  //log of bucket width, 0 for exact mode
+        Double_t fGamma;
+        Long64_t fEntries;
+        Long64_t fAccepted;  //entries above anchor point
+        Double_t fSum;
+        Double_t fMin;
+        Double_t fMax;
+        Long64_t fNZero;
+        Bool_t   fSorted;
+        std::vector<Float_t>     fValues;   //exact mode
+        std::map<Int_t,Long64_t> fPositive; //bucket counts, positive values
+        std::map<Int_t,Long64_t> fNegative; //bucket counts, negative values
+        std::map<Float_t,Long64_t> fCounts; //integer estimators
+    };
+    
+    //One sample per estimator of the AliMultSelection used for a run (range)
+    void AddRunSamples( std::vector< std::vector<AliMultCalibSample> >& lSamples, AliMultSelection* lSel, Double_t lTolerance ){
+        lSamples.push_back( std::vector<AliMultCalibSample>() );
+        for( Int_t iEst=0; iEst<lSel->GetNEstimators(); iEst++){
+            AliMultEstimator *lEst = lSel->GetEstimator(iEst);
+            lSamples.back().push_back( AliMultCalibSample(lEst->IsInteger(), lTolerance, lEst->GetUseAnchor(), lEst->GetAnchorPoint()) );
+        }
+    }
+}
+
 AliMultSelectionCalibrator::AliMultSelectionCalibrator() :
     TNamed(), fInputFileName(""), fBufferFileName("buffer.root"),
     fOutputFileName(""), fInput(0), fSelection(0), fMultSelectionCuts(0), fCalibHists(0),
     lNDesiredBoundaries(0), lDesiredBoundaries(0), fRunToUseAsDefault(-1),
-    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0)
+    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0), fTolerance(1e-3), fNThreads(0)
 {
     // Constructor
 
@@ -60,7 +180,7 @@ AliMultSelectionCalibrator::AliMultSelectionCalibrator(const char * name, const
     TNamed(name,title), fInputFileName(""), fBufferFileName("buffer.root"),
     fOutputFileName(""), fInput(0), fSelection(0), fMultSelectionCuts(0), fCalibHists(0),
     lNDesiredBoundaries(0), lDesiredBoundaries(0), fRunToUseAsDefault(-1),
-    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0)
+    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0), fTolerance(1e-3), fNThreads(0)
 {
     // Named Constructor
 
@@ -140,12 +260,13 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
     // Steps involved:
     //  (1) Set up basic I/O
     //  (2) Detect Runs From Input File
-    //  (3) Determine Averages
-    //     (3a) Create run-by-run buffer files with averages
-    //  (4) Determine Quantile Boundaries
-    //     (4a) Create run-by-run buffer files (requires averages)
-    //     (4b) Compute Quantile Boundaries for all estimators
-    //  (4) Save Quantiles + AliMultSelectionCuts to OADB File
+    //  (3) Single pass over the input: evaluate all estimators of accepted
+    //      events, keep run-by-run quantile sketches (or all values in
+    //      exact mode, see SetTolerance), sums, extremes and anchor counts
+    //      in memory
+    //  (4) Determine Averages, sort kept values in parallel over runs
+    //  (5) Determine Quantile Boundaries for all estimators
+    //  (6) Save Quantiles + AliMultSelectionCuts to OADB File
 
     cout<<"=== STARTING CALIBRATION PROCEDURE ==="<<endl;
     cout<<" * Input File.....: "<<fInputFileName.Data()<<endl;
@@ -236,7 +357,7 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
     Long64_t lNEv = fTree->GetEntries();
     cout<<"(1) File opened, event count is "<<lNEv<<endl;
     
-    cout<<"(2) Creating buffer, computing averages"<<endl;
+    cout<<"(2) Reading events, evaluating estimators"<<endl;
     const int lMax = 1000;
     const int lMaxQuantiles = 10000;
     Int_t lRunNumbers[lMaxQuantiles];
@@ -249,34 +370,24 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
     
     Int_t lNRuns = 0;
     Bool_t lNewRun = kTRUE;
-    Int_t lThisRunIndex = -1;
-    //Buffer file with run-by-run TTree objects needed for later processing
-
-    TFile *fOutput = new TFile (fBufferFileName.Data(), "RECREATE");
-    TTree *sTree[lMaxQuantiles];
-    cout<<"Creating Trees..."<<endl;
+    //Estimator values per run (range) and estimator, filled in a single pass
+    //over the input tree: no buffer file and no TTree::Draw per estimator
+    std::vector< std::vector<AliMultCalibSample> > lSamples;
+    cout<<"Preparing estimators..."<<endl;
     //N.B. No need to Exceed Run Ranges in Calibration Code here!
-    Int_t lNTrees = 0;
     if( !lAutoDiscover ){
-        lNTrees = fNRunRanges;
+        for(Int_t iRun=0; iRun<fNRunRanges; iRun++) {
+            AliMultSelection *lSel = (AliMultSelection*) fMultSelectionList->At(iRun);
+            lSel->Setup ( fInput );
+            AddRunSamples( lSamples, lSel, fTolerance );
+        }
     }else{
-        lNTrees = lMax;
+        fSelection->Setup ( fInput );
     }
-    for(Int_t iRun=0; iRun<lNTrees; iRun++) {
-        sTree[iRun] = new TTree(Form("sTree%i",iRun),Form("sTree%i",iRun));
-        
-        //useful for debugging / cross-checking
-        sTree[iRun]->Branch("fRunNumber", &fRunNumber, "fRunNumber/I");
-        
-        for( Int_t iQvar = 0; iQvar<fInput->GetNVariables(); iQvar++) {
-            if( !fInput->GetVariable(iQvar)->IsInteger() ) {
-                sTree[iRun]->Branch(Form("%s", fInput->GetVariable(iQvar)->GetName()  ),
-                                    &fInput->GetVariable(iQvar)->GetRValue(),Form("%s/F",fInput->GetVariable(iQvar)->GetName()));
-            } else {
-                sTree[iRun]->Branch(Form("%s", fInput->GetVariable(iQvar)->GetName()  ),
-                                    &fInput->GetVariable(iQvar)->GetRValueInteger(),Form("%s/I",fInput->GetVariable(iQvar)->GetName()));
-            }
-        }
+    if( fTolerance > 0 ){
+        cout<<"Quantiles determined with relative tolerance "<<fTolerance<<endl;
+    }else{
+        cout<<"Quantiles determined exactly"<<endl;
     }
 
     //const int lNEstimators = fSelection->GetNEstimators();
@@ -373,27 +484,35 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
                 lIndex = lNRuns;
                 lNRuns++;
                 fNRunRanges++;
+                AddRunSamples( lSamples, fSelection, fTolerance );
             }
         }
         if ( lSaveThisEvent ) {
-            sTree [ lIndex ] -> Fill();
+            //Evaluate all estimators of this run (range) once, keep the values
+            AliMultSelection *lSel = lAutoDiscover ? fSelection : (AliMultSelection*) fMultSelectionList->At(lIndex);
+            lSel->Evaluate ( fInput );
+            std::vector<AliMultCalibSample>& lRunSamples = lSamples[lIndex];
+            for(UInt_t iEst=0; iEst<lRunSamples.size(); iEst++) lRunSamples[iEst].Fill( lSel->GetEstimator(iEst)->GetValue() );
         }
             
     }
     
-    //Write buffer to file
-    for(Int_t iRun=0; iRun<lNRuns; iRun++) sTree[iRun]->Write();
+    //Events accepted per run (range)
+    std::vector<Long64_t> lNAccepted(fNRunRanges,0);
+    for(Int_t iRun=0; iRun<fNRunRanges; iRun++) {
+        if( !lSamples[iRun].empty() ) lNAccepted[iRun] = lSamples[iRun][0].GetEntries();
+    }
 
     if(!lAutoDiscover){
     cout<<"(3) Inspect Run Ranges and corresponding statistics: "<<endl;
     for(Int_t iRun = 0; iRun<fNRunRanges; iRun++) {
-        cout<<" --- Range #"<<iRun<<", ("<<fFirstRun[iRun]<<" - "<<fLastRun[iRun]<<"), N(events) = "<<sTree[iRun]->GetEntries()<<endl;
+        cout<<" --- Range #"<<iRun<<", ("<<fFirstRun[iRun]<<" - "<<fLastRun[iRun]<<"), N(events) = "<<lNAccepted[iRun]<<endl;
     }
     cout<<endl;
     }else{
         cout<<"(3) Inspect Runs and corresponding statistics: "<<endl;
         for(Int_t iRun = 0; iRun<fNRunRanges; iRun++) {
-            cout<<" --- Run #"<<iRun<<", (#"<<lRunNumbers[iRun]<<"), N(events) = "<<sTree[iRun]->GetEntries()<<endl;
+            cout<<" --- Run #"<<iRun<<", (#"<<lRunNumbers[iRun]<<"), N(events) = "<<lNAccepted[iRun]<<endl;
         }
         cout<<endl;
     }
@@ -408,8 +527,23 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
     }
 
     // STEP 4: Actual determination of boundaries...
-    Long64_t *index;
-    Double_t *lValues; 
+    
+    //Sort kept values (exact mode), runs are independent: one run per thread at a time
+    if( fTolerance <= 0 ){
+        Int_t lNThreads = fNThreads > 0 ? fNThreads : (Int_t) std::thread::hardware_concurrency();
+        if( lNThreads < 1 ) lNThreads = 1;
+        if( lNThreads > fNRunRanges ) lNThreads = fNRunRanges;
+        cout<<"Sorting estimator values of "<<fNRunRanges<<" runs with "<<lNThreads<<" threads..."<<endl;
+        std::atomic<Int_t> lNextRun(0);
+        std::vector<std::thread> lWorkers;
+        for(Int_t iThread=0; iThread<lNThreads; iThread++) {
+            lWorkers.push_back( std::thread( [&lSamples, &lNextRun, this](){
+                for(Int_t iRun = lNextRun++; iRun<fNRunRanges; iRun = lNextRun++)
+                    for(UInt_t iEst=0; iEst<lSamples[iRun].size(); iEst++) lSamples[iRun][iEst].Sort();
+            } ) );
+        }
+        for(UInt_t iThread=0; iThread<lWorkers.size(); iThread++) lWorkers[iThread].join();
+    }
 
     //Histograms to store calibration information
     TH1F *hCalib[1000][lNEstimators];
@@ -420,37 +554,24 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
         //Contextualize AliMultSelection for this run
         if ( !lAutoDiscover ) fSelection = (AliMultSelection*) fMultSelectionList->At(iRun);
 
-        // Calibration pre-optimization and setup
-        fSelection->Setup ( fInput );
-
         const Int_t lNEstimatorsThis = fSelection->GetNEstimators();
 	
-        const Long64_t ntot = (Long64_t) sTree[iRun]->GetEntries();
+        const Long64_t ntot = lNAccepted[iRun];
         if ( !lAutoDiscover ){
             cout<<"--- Processing run range "<<fFirstRun[iRun]<<"-"<<fLastRun[iRun]<<" ("<<iRun<<"/"<<fNRunRanges<<"), with "<<ntot<<" events..."<<endl;
         }else{
             cout<<"--- Processing run "<<lRunNumbers[iRun]<<" ("<<iRun<<"/"<<fNRunRanges<<"), with "<<ntot<<" events..."<<endl;
         }
-        sTree[iRun]->SetEstimate(ntot+1);
-        //Cast Run Number into drawing conditions
         for(Int_t iEst=0; iEst<lNEstimatorsThis; iEst++) {
-            lRunStats[iRun] = sTree[iRun]->Draw(fSelection->GetEstimator(iEst)->GetDefinition(),"","goff");
-            lValues = sTree[iRun]->GetV1();
+            const AliMultCalibSample& lSample = lSamples[iRun][iEst];
+            lRunStats[iRun] = ntot;
             cout<<"--- Calculating averages: "<<flush;
-            for( Long64_t iEntry=0; iEntry<ntot; iEntry++) {
-                Float_t lThisVal = lValues[iEntry]; //Test
-                lAvEst[iEst][iRun] += lThisVal;
-                if( lThisVal < lMinEst[iEst][iRun] ) {
-                    lMinEst[iEst][iRun] = lThisVal;
-                }
-                if( lThisVal > lMaxEst[iEst][iRun] ) {
-                    lMaxEst[iEst][iRun] = lThisVal;
-                }
-            }
-            if( sTree[iRun]->GetEntries() < 1 ) {
+            lMinEst[iEst][iRun] = lSample.GetMin();
+            lMaxEst[iEst][iRun] = lSample.GetMax();
+            if( ntot < 1 ) {
                 lAvEst[iEst][iRun] = -1;
             } else {
-                lAvEst[iEst][iRun] /= ( (Double_t) (sTree[iRun]->GetEntries()) );
+                lAvEst[iEst][iRun] = lSample.GetSum() / ( (Double_t) ntot );
             }
             cout<<" Min = "<<lMinEst[iEst][iRun]<<", Max = "<<lMaxEst[iEst][iRun]<<", Av = "<<lAvEst[iEst][iRun]<<endl;
             
@@ -489,33 +610,24 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
 	
         const Int_t lNEstimatorsThis = fSelection->GetNEstimators(); 
 
-        const Long64_t ntot = (Long64_t) sTree[iRun]->GetEntries();
+        const Long64_t ntot = lNAccepted[iRun];
         if ( !lAutoDiscover ){
             cout<<"--- Processing run range "<<fFirstRun[iRun]<<"-"<<fLastRun[iRun]<<" ("<<iRun<<"/"<<fNRunRanges<<"), with "<<ntot<<" events..."<<endl;
         }else{
             cout<<"--- Processing run "<<lRunNumbers[iRun]<<" ("<<iRun<<"/"<<fNRunRanges<<"), with "<<ntot<<" events..."<<endl;
         }
-        sTree[iRun]->SetEstimate(ntot+1);
-        // Memory allocation: don't repeat it per estimator! only per run
-        index = new Long64_t[ntot];
-        //Cast Run Number into drawing conditions
         for(Int_t iEst=0; iEst<lNEstimatorsThis; iEst++) {
+            const AliMultCalibSample& lSample = lSamples[iRun][iEst];
             if( ! ( fSelection->GetEstimator(iEst)->IsInteger() ) ) {
                 //==== Floating Point Calibration Engine ====
-                lRunStats[iRun] = sTree[iRun]->Draw(fSelection->GetEstimator(iEst)->GetDefinition(),"","goff");
-                cout<<"--- Sorting estimator "<<fSelection->GetEstimator(iEst)->GetName()<<"..."<<flush;
-                
-                TMath::Sort(ntot,sTree[iRun]->GetV1(),index);
-                cout<<" Done! Getting Boundaries... "<<flush;
+                lRunStats[iRun] = ntot;
+                cout<<"--- Getting Boundaries for estimator "<<fSelection->GetEstimator(iEst)->GetName()<<"... "<<flush;
                 
                 //Special override in case anchored estimator
                 if( fSelection->GetEstimator(iEst)->GetUseAnchor() ){
                     cout<<"Anchoring... "<<flush;
-                    //Require determination of index after which values are to be discarded
-                    //Count fraction of accepted
-                    TString lCondition = fSelection->GetEstimator(iEst)->GetDefinition();
-                    lCondition.Append(Form("> %.10f",fSelection->GetEstimator(iEst)->GetAnchorPoint() ) );
-                    lAcceptedEvents = sTree[iRun]->Draw(fSelection->GetEstimator(iEst)->GetDefinition(),lCondition.Data(),"goff");
+                    //Fraction of events above the anchor point, counted exactly during the event loop
+                    lAcceptedEvents = lSample.GetAccepted();
                     lRunStats[iRun] = lAcceptedEvents;
                 }
                 lNrawBoundaries[0] = 0.0; //Defined OK even if anchored
@@ -538,11 +650,7 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
                         if(position > ntot-1 ) position = ntot-1; //protection !
                     }
                     //cout<<"Position requested: "<<position<<flush;
-                    sTree[iRun]->GetEntry( index[position] );
-                    //Calculate the estimator with this input, please
-                    fSelection->Evaluate ( fInput );
-                    //fSelection->PrintInfo();
-                    lNrawBoundaries[lB] = fSelection->GetEstimator(iEst)->GetValue();
+                    lNrawBoundaries[lB] = lSample.GetValueAt( position );
                 }
                 //Cross-check correct rejection of anything beyond anchor point
                 if( fSelection->GetEstimator(iEst)->GetUseAnchor() && ntot != 0 ){
@@ -594,14 +702,15 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
                 Float_t lLowEdge = lMinEst[iEst][iRun]-0.5;
                 Float_t lHighEdge= lMaxEst[iEst][iRun]+0.5;
                 cout<<"Inspect: "<<lNBins<<", low "<<lLowEdge<<", high "<<lHighEdge<<endl;
-                if( sTree[iRun]->GetEntries() < 1 ) {
+                if( ntot < 1 ) {
                     //Case of an empty run!
                     hCalib[iRun][iEst] = new TH1F(Form("hCalib_%i_%s",lRunNumbers[iRun],fSelection->GetEstimator(iEst)->GetName()),"",1,0,1);
                     hCalib[iRun][iEst]->SetDirectory(0);
                 } else {
                     TH1F *hTemporary = new TH1F("hTemporary", "", lNBins, lMinEst[iEst][iRun]-0.5, lMaxEst[iEst][iRun]+0.5 );
                     //hTemporary->SetDirectory(0);
-                    lRunStats[iRun] = sTree[iRun]->Draw(Form("%s>>hTemporary",fSelection->GetEstimator(iEst)->GetDefinition().Data()),"","goff");
+                    lSample.FillHisto( hTemporary );
+                    lRunStats[iRun] = ntot;
                     cout<<"entries = "<<lRunStats[iRun]<<endl;
                     //In memory now: histogram with content, please normalize to unity
                     hTemporary->Scale(1./((double)(lRunStats[iRun])));
@@ -621,6 +730,8 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
                 }
             }
         }
+        //Boundaries of this run are known: release its values (exact mode)
+        std::vector<AliMultCalibSample>().swap( lSamples[iRun] );
 
         //Write OADB object
         if ( !lAutoDiscover ){
@@ -702,8 +813,6 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
             //DEFAULT OADB Object saving procedure ENDS here
             //========================================================================
         }
-        //Cleanup: Delete index variable
-        delete[] index;
     }
     
     if( fRunToUseAsDefault < 0 ){
@@ -24,6 +24,7 @@ public:
   
     //Set Filenames
     void SetInputFile ( TString lFile ) { fInputFileName = lFile.Data(); } 
+    //Kept for existing macros: calibration does not use a buffer file anymore
     void SetBufferFile ( TString lFile ) { fBufferFileName = lFile.Data(); } 
     void SetOutputFile ( TString lFile ) { fOutputFileName = lFile.Data(); }
     //Set Boundaries to find
@@ -36,6 +37,15 @@ public:
         lNDesiredBoundaries = lNB;
     }
     
+    //Relative tolerance on the boundaries. > 0 (default 1e-3): logarithmic
+    //bucket sketch, memory independent of the number of events. 0: exact
+    //quantiles, all estimator values of all runs kept in memory until the
+    //boundaries are determined (opt-in, memory grows with the statistics)
+    void SetTolerance ( Double_t lTolerance ) { fTolerance = lTolerance; }
+    Double_t GetTolerance() const { return fTolerance; }
+    //Threads used to sort the values of different runs (0: all cores)
+    void SetNThreads ( Int_t lNThreads ) { fNThreads = lNThreads; }
+    
     //Run Ranges Interface
     Long_t GetNRunRanges() const {return fNRunRanges; }
     void AddRunRange ( Int_t lFirst, Int_t lLast, AliMultSelection *lMultSelProvided );
@@ -94,11 +104,15 @@ private:
     
     // TList object for storing histograms
     TList *fCalibHists; 
+    
+    Double_t fTolerance; // Relative tolerance on the boundaries (0: exact, default 1e-3)
+    Int_t    fNThreads;  // Threads for per-run processing (0: all cores)
 
-    ClassDef(AliMultSelectionCalibrator, 2);
+    ClassDef(AliMultSelectionCalibrator, 3);
     //(this classdef is only for bookkeeping, class will not usually
     // be streamed according to current workflow except in very specific
     // tests!) 
     //2 - Adjustments of extra event selections
+    //3 - Single-pass calibration, tolerance and threads
 };
 #endif
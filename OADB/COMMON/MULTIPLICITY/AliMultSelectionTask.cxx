@@ -1654,13 +1654,12 @@ void AliMultSelectionTask::UserExec(Option_t *)
 
         //Determine Quantiles from calibration histogram
         TH1F *lThisCalibHisto = 0x0;
-        TString lThisCalibHistoName;
         Float_t lThisQuantile = -1;
         for(Long_t iEst=0; iEst<lSelection->GetNEstimators(); iEst++) {
             //Changed: no need for run number, object already matches required one
-            lThisCalibHistoName = Form("hCalib_%s",lSelection->GetEstimator(iEst)->GetName());
+            //Estimator to histogram map is filled once per run (AliOADBMultSelection::Setup)
             lThisCalibHisto = 0x0;
-            lThisCalibHisto = fOadbMultSelection->GetCalibHisto( lThisCalibHistoName );
+            lThisCalibHisto = fOadbMultSelection->FindHisto( lSelection->GetEstimator(iEst) );
             if ( ! lThisCalibHisto ) {
                 lThisQuantile = AliMultSelectionCuts::kNoCalib;
                 if( iEst < fNDebug ) fQuantiles[iEst] = lThisQuantile;
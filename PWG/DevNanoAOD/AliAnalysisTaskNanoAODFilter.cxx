@@ -62,6 +62,7 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter() // All data members
   fSaveCutsFlag(0),
   fSaveAODZDC(kFALSE),
   fSaveVzero(kFALSE),
+  fFillColumns(kFALSE),
   fInputArrayName(""),
   fOutputArrayName("")
 {
@@ -82,6 +83,7 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter(const char *name, Boo
    fSaveCutsFlag(saveCutsFlag),
    fSaveAODZDC(kFALSE),
    fSaveVzero(kFALSE),
+   fFillColumns(kFALSE),
    fInputArrayName(""),
    fOutputArrayName("")
 
@@ -140,6 +142,7 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
   rep->SetCustomSetter(fSetter);
   if (fSaveVzero) rep->SetVzero(1);
   if (fSaveAODZDC) rep->SetAODZDC(1);
+  if (fFillColumns) rep->SetFillColumns(kTRUE);
   if (fVarListHeader_fTC) rep->SetVarListHeaderStringVariable(fVarListHeader_fTC);
   if (!fInputArrayName.IsNull()) rep->SetInputArrayName(fInputArrayName);
   if (!fOutputArrayName.IsNull()) rep->SetOutputArrayName(fOutputArrayName);
@@ -151,6 +154,7 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
   ext->FilterBranch("tracks",rep);
   ext->FilterBranch("vertices",rep);  
   ext->FilterBranch("header",rep);  
+  if (fFillColumns) ext->FilterBranch("trackColumns",rep);
             
   if ( fMCMode > 0 ) 
     {
@@ -56,6 +56,7 @@ public:
   void  SetVarFiredTriggerClasses (TString var          ) { fVarListHeader_fTC = var;}
   void  ReplicatorSaveVzero(Bool_t var ) {fSaveVzero=var;}
   void  ReplicatorSaveAODZDC(Bool_t var ) {fSaveAODZDC=var;}
+  void  ReplicatorFillColumns(Bool_t var ) {fFillColumns=var;}
 
   void SetInputArrayName(TString name) {fInputArrayName=name;}
   void SetOutputArrayName(TString name) {fOutputArrayName=name;}
@@ -74,6 +75,7 @@ private:
   Bool_t fSaveCutsFlag; // If true, the event and track cuts are saved to disk. Can only be set in the constructor.
   Bool_t fSaveAODZDC;  // if kTRUE AliAODZDC will be saved in AliAODEvent
   Bool_t fSaveVzero; // if kTRUE AliAODVZERO will be saved in AliAODEvent
+  Bool_t fFillColumns; // if kTRUE the tracks are also saved as AliNanoAODTrackColumns
 
   TString fInputArrayName; // name of TObjectArray of Tracks
   TString fOutputArrayName; // name of TObjectArray of AliNanoAODTracks
@@ -81,7 +83,7 @@ private:
   AliAnalysisTaskNanoAODFilter(const AliAnalysisTaskNanoAODFilter&); // not implemented
   AliAnalysisTaskNanoAODFilter& operator=(const AliAnalysisTaskNanoAODFilter&); // not implemented
 
-  ClassDef(AliAnalysisTaskNanoAODFilter, 4); // example of analysis
+  ClassDef(AliAnalysisTaskNanoAODFilter, 5); // example of analysis
 };
 
 #endif
@@ -53,6 +53,7 @@ class AliAODRecoDecay;
 #include "TObjArray.h"
 #include "AliAnalysisFilter.h"
 #include "AliNanoAODTrack.h"
+#include "AliNanoAODTrackColumns.h"
 
 #include <TFile.h>
 #include <TDatabasePDG.h>
@@ -103,6 +104,9 @@ AliAODBranchReplicator(),
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
+  fFillColumns(kFALSE),
+  fColumnsName("trackColumns"),
+  fColumns(0x0),
   fVarListHeader_fTC(""){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file
   }
@@ -134,6 +138,9 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
+  fFillColumns(kFALSE),
+  fColumnsName("trackColumns"),
+  fColumns(0x0),
   fVarListHeader_fTC("")
 {
   // default ctor
@@ -439,6 +446,11 @@ TList* AliNanoAODReplicator::GetList() const
       fTracks->SetName(fOutputArrayName.Data()); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
       fList->Add(fTracks);
 
+      if (fFillColumns) {
+        fColumns = new AliNanoAODTrackColumns(fColumnsName.Data(), fNTracksVariables);
+        fList->Add(fColumns);
+      }
+
       fHeader = new AliNanoAODHeader(fNumberOfHeaderParam, fNumberOfHeaderParamInt);
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
       fList->Add(fHeader);    
@@ -485,6 +497,7 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   
 
   fTracks->Clear("C");			
+  if (fColumns) fColumns->Clear();
   assert(fVertices!=0x0);
   fVertices->Clear("C");
   if (fMCMode > 0){
@@ -533,6 +546,9 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
 
     if(fCustomSetter) fCustomSetter->SetNanoAODTrack(aodtrack, special);
   }  
+
+  // Transpose once all custom variables are set
+  if (fColumns) fColumns->Fill(fTracks);
   //----------------------------------------------------------
   
   TIter nextV(source.GetVertices());
@@ -54,6 +54,7 @@ class AliAODHeader;
 class AliNanoAODHeader;
 class AliAnalysisTaskSE;
 class AliNanoAODTrack;
+class AliNanoAODTrackColumns;
 class AliAODTrack;
 class AliNanoAODCustomSetter;
 class AliAODZDC;
@@ -100,6 +101,11 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void SetNumberOfHaederParamInt(Int_t var){fNumberOfHeaderParamInt=var;}
   void SetInputArrayName(TString name) {fInputArrayName=name;}
   void SetOutputArrayName(TString name) {fOutputArrayName=name;}
+  // Also write the tracks in columnar form (one array per variable), see AliNanoAODTrackColumns.
+  // Off by default: the tracks keep all their variables, so the output grows by the size of the columns
+  void SetFillColumns(Bool_t b) {fFillColumns=b;}
+  Bool_t GetFillColumns() const {return fFillColumns;}
+  void SetColumnsName(TString name) {fColumnsName=name;}
 
   void SetVarListHeaderStringVariable(TString var) {fVarListHeader_fTC=var;}
     
@@ -146,13 +152,16 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   TString fInputArrayName; // name of array if tracks are stored in a TObjectArray
   TString fOutputArrayName; // name of the output array, where the NanoAODTracks are stored
+  Bool_t fFillColumns; // if kTRUE the tracks are also stored as AliNanoAODTrackColumns
+  TString fColumnsName; // name of the AliNanoAODTrackColumns object in the output
+  mutable AliNanoAODTrackColumns* fColumns; //! internal columnar copy of the tracks
  private:
 
 
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
 
-  ClassDef(AliNanoAODReplicator,4) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,5) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
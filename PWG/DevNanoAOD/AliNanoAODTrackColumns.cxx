@@ -0,0 +1,128 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Columnar representation of the NanoAOD tracks of one event
+//     See header for a description
+//-------------------------------------------------------------------------
+
+#include <TClonesArray.h>
+#include "AliLog.h"
+
+#include "AliNanoAODTrack.h"
+#include "AliNanoAODTrackMapping.h"
+#include "AliNanoAODTrackColumns.h"
+
+ClassImp(AliNanoAODTrackColumns)
+
+//______________________________________________________________________________
+AliNanoAODTrackColumns::AliNanoAODTrackColumns() :
+  TNamed(),
+  fNVars(0),
+  fNTracks(0),
+  fValues(),
+  fLabels(),
+  fCharges()
+{
+  // default constructor
+}
+
+//______________________________________________________________________________
+AliNanoAODTrackColumns::AliNanoAODTrackColumns(const char * name, Int_t nvars) :
+  TNamed(name, "NanoAOD track columns"),
+  fNVars(nvars),
+  fNTracks(0),
+  fValues(),
+  fLabels(),
+  fCharges()
+{
+  // constructor, nvars is the number of variables in the track mapping
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::Clear(Option_t * /*opt*/)
+{
+  // remove all tracks, keeping the allocated memory for the next event
+
+  fNTracks = 0;
+  fValues.clear();
+  fLabels.clear();
+  fCharges.clear();
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::Fill(const TClonesArray * tracks)
+{
+  // Transpose the NanoAOD tracks of the event into the columns.
+  // Must be called once the tracks are final (i.e. after the custom setter)
+
+  Clear();
+  if (!tracks) return;
+
+  fNTracks = tracks->GetEntriesFast();
+  fValues.resize(fNVars * fNTracks);
+  fLabels.resize(fNTracks);
+  fCharges.resize(fNTracks);
+
+  for (Int_t itrack = 0; itrack < fNTracks; itrack++) {
+    const AliNanoAODTrack * track = static_cast<const AliNanoAODTrack*>(tracks->UncheckedAt(itrack));
+    for (Int_t ivar = 0; ivar < fNVars; ivar++) {
+      fValues[ivar * fNTracks + itrack] = track->GetVar(ivar);
+    }
+    fLabels[itrack]  = track->GetLabel();
+    fCharges[itrack] = track->Charge();
+  }
+}
+
+//______________________________________________________________________________
+AliNanoAODColumn AliNanoAODTrackColumns::GetColumn(Int_t index) const
+{
+  // Column of the variable with the given index in the track mapping
+
+  if (index < 0 || index >= fNVars) {
+    AliError(Form("Variable index %d out of range [0,%d)", index, fNVars));
+    return AliNanoAODColumn();
+  }
+  if (fNTracks == 0) return AliNanoAODColumn();
+  return AliNanoAODColumn(&fValues[index * fNTracks], fNTracks);
+}
+
+//______________________________________________________________________________
+AliNanoAODColumn AliNanoAODTrackColumns::GetColumn(const char * varName) const
+{
+  // Column of the variable with the given name. Resolve the index once
+  // outside of the event loop if this is called for every event
+
+  return GetColumn(AliNanoAODTrackMapping::GetInstance()->GetVarIndex(varName));
+}
+
+//______________________________________________________________________________
+AliNanoAODColumn AliNanoAODTrackColumns::GetPt() const
+{
+  return GetColumn(AliNanoAODTrackMapping::GetInstance()->GetPt());
+}
+
+//______________________________________________________________________________
+AliNanoAODColumn AliNanoAODTrackColumns::GetPhi() const
+{
+  return GetColumn(AliNanoAODTrackMapping::GetInstance()->GetPhi());
+}
+
+//______________________________________________________________________________
+AliNanoAODColumn AliNanoAODTrackColumns::GetTheta() const
+{
+  return GetColumn(AliNanoAODTrackMapping::GetInstance()->GetTheta());
+}
@@ -0,0 +1,96 @@
+#ifndef AliNanoAODTrackColumns_H
+#define AliNanoAODTrackColumns_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Columnar representation of the NanoAOD tracks of one event
+//     All the tracks of the event are stored variable by variable:
+//     for each variable of the AliNanoAODTrackMapping there is one
+//     contiguous array running over the tracks, in the same order as
+//     the tracks in the AliNanoAODTrack array. Label and charge,
+//     which are not part of the mapping, have their own columns.
+//
+//     The columns are written by the AliNanoAODReplicator (see
+//     AliNanoAODReplicator::SetFillColumns) next to the track array.
+//     A task can loop over one variable for all tracks with
+//
+//       AliNanoAODTrackColumns * cols = (AliNanoAODTrackColumns*) aod->FindListObject("trackColumns");
+//       AliNanoAODColumn pt = cols->GetPt();
+//       for (Int_t itrack = 0; itrack < pt.GetSize(); itrack++) { if (pt[itrack] > 1) ... }
+//
+//     without going through one object per track. The AliNanoAODTrack
+//     objects (and their AliVTrack interface) are still filled as before,
+//     so readers which do not know about the columns are not affected.
+//     The columns are an optional extra output: they roughly double the
+//     size of the track branch and are only written when requested.
+//-------------------------------------------------------------------------
+
+#include <vector>
+#include <TNamed.h>
+
+class TClonesArray;
+class AliNanoAODTrack;
+
+// Read only view of one column: pointer to the first track and number of tracks
+class AliNanoAODColumn {
+
+public:
+
+  AliNanoAODColumn() : fData(0), fSize(0) {}
+  AliNanoAODColumn(const Double_t * data, Int_t size) : fData(data), fSize(size) {}
+
+  const Double_t * GetData()  const { return fData; }
+  Int_t            GetSize()  const { return fSize; }
+  Bool_t           IsEmpty()  const { return fSize == 0; }
+  const Double_t * begin()    const { return fData; }
+  const Double_t * end()      const { return fData + fSize; }
+  Double_t         operator[](Int_t itrack) const { return fData[itrack]; }
+
+private:
+
+  const Double_t * fData; // first element of the column
+  Int_t            fSize; // number of tracks
+};
+
+class AliNanoAODTrackColumns : public TNamed {
+
+public:
+
+  AliNanoAODTrackColumns();
+  AliNanoAODTrackColumns(const char * name, Int_t nvars);
+  virtual ~AliNanoAODTrackColumns() {}
+
+  virtual void Clear(Option_t * opt = "");
+
+  void Fill(const TClonesArray * tracks);
+
+  Int_t GetNTracks()    const { return fNTracks; }
+  Int_t GetNVariables() const { return fNVars; }
+
+  AliNanoAODColumn GetColumn(Int_t index) const;
+  AliNanoAODColumn GetColumn(const char * varName) const;
+  AliNanoAODColumn GetPt()    const;
+  AliNanoAODColumn GetPhi()   const;
+  AliNanoAODColumn GetTheta() const;
+
+  Double_t GetVar(Int_t index, Int_t itrack) const { return fValues[index * fNTracks + itrack]; }
+  Int_t    GetLabel(Int_t itrack)  const { return fLabels[itrack]; }
+  Short_t  GetCharge(Int_t itrack) const { return fCharges[itrack]; }
+
+  const std::vector<Int_t>   & GetLabels()  const { return fLabels; }
+  const std::vector<Short_t> & GetCharges() const { return fCharges; }
+
+private:
+
+  Int_t fNVars;                  // number of variables (size of the track mapping)
+  Int_t fNTracks;                // number of tracks in the event
+  std::vector<Double_t> fValues; // variable-major values, track itrack of variable ivar at ivar*fNTracks+itrack
+  std::vector<Int_t>    fLabels; // track labels
+  std::vector<Short_t>  fCharges;// track charges
+
+  ClassDef(AliNanoAODTrackColumns, 1); // Columnar NanoAOD tracks
+};
+
+#endif
@@ -35,6 +35,8 @@
 #include <TH1F.h>
 #include <TRandom3.h>
 #include <TList.h>
+#include <TROOT.h>
+#include <RVersion.h>
 
 #include <AliLog.h>
 #include <AliAnalysisManager.h>
@@ -49,6 +51,7 @@
 
 #include "AliYAMLConfiguration.h"
 #include "AliEmcalList.h"
+#include "AliEmcalEmbeddingEventQueue.h"
 
 #include "AliAnalysisTaskEmcalEmbeddingHelper.h"
 
@@ -78,6 +81,7 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fRandomEventNumberAccess(kFALSE),
   fRandomFileAccess(kTRUE),
   fCreateHisto(true),
+  fNPrefetchEvents(0),
   fUseInternalEventSelection(false),
   fUseManualInternalEventCuts(false),
   fInternalEventCuts(),
@@ -113,7 +117,10 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fPythiaTrialsFromFile(0),
   fPythiaCrossSection(0.),
   fPythiaCrossSectionFromFile(0.),
-  fPythiaPtHard(0.)
+  fPythiaPtHard(0.),
+  fReaderEvent(nullptr),
+  fEventQueue(nullptr),
+  fNewTrees()
 {
   if (fgInstance != nullptr) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -145,6 +152,7 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fRandomEventNumberAccess(kFALSE),
   fRandomFileAccess(kTRUE),
   fCreateHisto(true),
+  fNPrefetchEvents(0),
   fUseInternalEventSelection(false),
   fUseManualInternalEventCuts(false),
   fInternalEventCuts(),
@@ -180,7 +188,10 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fPythiaTrialsFromFile(0),
   fPythiaCrossSection(0.),
   fPythiaCrossSectionFromFile(0.),
-  fPythiaPtHard(0.)
+  fPythiaPtHard(0.),
+  fReaderEvent(nullptr),
+  fEventQueue(nullptr),
+  fNewTrees()
 {
   if (fgInstance != 0) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -202,6 +213,9 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
 AliAnalysisTaskEmcalEmbeddingHelper::~AliAnalysisTaskEmcalEmbeddingHelper()
 {
   if (fgInstance == this) fgInstance = nullptr;
+  // Stop the reader thread before anything that it uses is deleted
+  if (fEventQueue) delete fEventQueue;
+  if (fReaderEvent) delete fReaderEvent;
   if (fExternalEvent) delete fExternalEvent;
   if (fExternalFile) {
     fExternalFile->Close();
@@ -626,6 +640,11 @@ void AliAnalysisTaskEmcalEmbeddingHelper::DetermineFirstFileToEmbed()
  * next tree within the TChain. In the case of running of out files to embed, an error is thrown and embedding
  * begins again from the start of the file list.
  *
+ * If the external events are read ahead by the background thread (see SetNumberOfPrefetchedEvents()), the
+ * events are taken from the queue in the order in which they were read and copied into the external event,
+ * and the references between the objects of the event are set again on the copy. The bookkeeping of new
+ * trees and the event selection are done here in both cases, so the same events are selected.
+ *
  * @return kTRUE if successful
  */
 Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
@@ -633,57 +652,41 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
   Int_t attempts = -1;
 
   do {
-    // Reset to start of tree
-    if (fCurrentEntry == fUpperEntry) {
-      fCurrentEntry = fLowerEntry;
-      fWrappedAroundTree = true;
-    }
-
-    if ((fCurrentEntry < fLowerEntry + fOffset) || !fWrappedAroundTree) {
-      // Continue with GetEntry as normal
+    bool restarted = false;
+    if (fEventQueue) {
+      // Take the next event read by the background thread
+      AliEmcalEmbeddingEventQueue::Item * item = fEventQueue->Next();
+      if (!item) {
+        AliError("The external event reader has stopped. No more events are available to embed!");
+        return kFALSE;
+      }
+      restarted = item->fRestarted;
+      fNewTrees.assign(item->fNewTrees.begin(), item->fNewTrees.end());
+      CopyEvent(item->fEvent, fExternalEvent);
+      // The copied references still point to the object table of the file, which the reader keeps overwriting
+      item->fRefs.Restore(fExternalEvent);
+      fEventQueue->Release(item);
     }
     else {
-      // NOTE: On transition from one file to the next, this calls the next entry that would be expected.
-      //       However, if it is for the last file, it tries to GetEntry() of one entry past the end of the last file.
-      //       Normally, this would be a problem, however GetEntry() just doesn't fill the fields of an invalid index
-      //       instead of throwing an error. So "invalid values" are filled for a file that doesn't exist, but then 
-      //       they are immediately replaced by the lines below that reset the access values and re-init the tree.
-      //       The benefit of this approach is it simplies file counting (we don't need to carefully increment here
-      //       and in InitTree()) and preserves the desired behavior when we are not at the last file.
-      InitTree();
+      fNewTrees.clear();
+      ReadNextEntry(fNewTrees, restarted);
     }
 
-    // Load current event
-    // Can be a simple less than, because fFileNumber counts from 0.
-    if (fFileNumber < fMaxNumberOfFiles) {
-      fChain->GetEntry(fCurrentEntry);
-    }
-    else {
+    if (restarted) {
       AliError("====================================================================================================");
       AliError("== No more files available to embed from the TChain! Restarting from the beginning of the TChain! ==");
       AliError("== Be careful to check that this is the desired action!                                           ==");
       AliError("====================================================================================================");
+    }
 
-      // Reset the relevant access values
-      // fCurrentEntry and fLowerEntry are automatically reset in InitTree()
-      fFileNumber = 0;
-      fUpperEntry = 0;
-
-      // Re-init back to the start
-      InitTree();
-
-      // Access the relevant entry
-      // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
-      fChain->GetEntry(fCurrentEntry);
+    // Bookkeeping for the trees which were opened to read this entry
+    for (auto fileNumber : fNewTrees) {
+      RecordNewTree(fileNumber);
     }
-    AliDebug(4, TString::Format("Loading entry %i between %i-%i, starting with offset %i from the lower bound of %i", fCurrentEntry, fLowerEntry, fUpperEntry, fOffset, fLowerEntry));
 
     // Set relevant event properties
     SetEmbeddedEventProperties();
 
-    // Increment current entry
-    fCurrentEntry++;
-    
     // Provide a check for number of attempts
     attempts++;
     if (attempts == 1000)
@@ -706,6 +709,64 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
   return kTRUE;
 }
 
+/**
+ * Read the next entry of the TChain into the event connected to it, opening the next tree within the
+ * TChain via LoadNextTree() if needed. It only changes the entry access values and does not fill any
+ * histograms, so it can be called by the background reader thread.
+ *
+ * @param[out] newTrees File numbers of the trees which were loaded to read the entry are appended
+ * @param[out] restarted Set to true if there were no more files to embed and the TChain was restarted from the beginning
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::ReadNextEntry(std::vector<UInt_t> & newTrees, bool & restarted)
+{
+  // Reset to start of tree
+  if (fCurrentEntry == fUpperEntry) {
+    fCurrentEntry = fLowerEntry;
+    fWrappedAroundTree = true;
+  }
+
+  if ((fCurrentEntry < fLowerEntry + fOffset) || !fWrappedAroundTree) {
+    // Continue with GetEntry as normal
+  }
+  else {
+    // NOTE: On transition from one file to the next, this calls the next entry that would be expected.
+    //       However, if it is for the last file, it tries to GetEntry() of one entry past the end of the last file.
+    //       Normally, this would be a problem, however GetEntry() just doesn't fill the fields of an invalid index
+    //       instead of throwing an error. So "invalid values" are filled for a file that doesn't exist, but then 
+    //       they are immediately replaced by the lines below that reset the access values and re-init the tree.
+    //       The benefit of this approach is it simplies file counting (we don't need to carefully increment here
+    //       and in InitTree()) and preserves the desired behavior when we are not at the last file.
+    LoadNextTree();
+    newTrees.push_back(fFileNumber);
+  }
+
+  // Load current event
+  // Can be a simple less than, because fFileNumber counts from 0.
+  if (fFileNumber < fMaxNumberOfFiles) {
+    fChain->GetEntry(fCurrentEntry);
+  }
+  else {
+    restarted = true;
+
+    // Reset the relevant access values
+    // fCurrentEntry and fLowerEntry are automatically reset in LoadNextTree()
+    fFileNumber = 0;
+    fUpperEntry = 0;
+
+    // Re-init back to the start
+    LoadNextTree();
+    newTrees.push_back(fFileNumber);
+
+    // Access the relevant entry
+    // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
+    fChain->GetEntry(fCurrentEntry);
+  }
+  AliDebug(4, TString::Format("Loading entry %i between %i-%i, starting with offset %i from the lower bound of %i", fCurrentEntry, fLowerEntry, fUpperEntry, fOffset, fLowerEntry));
+
+  // Increment current entry
+  fCurrentEntry++;
+}
+
 /**
  * Set some properties of the event that are not immediately available from the external event to make them
  * available to user tasks.
@@ -898,23 +959,115 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::InitEvent()
   if (!fChain) return kFALSE;
 
   if (!fExternalEvent) {
-    if (fTreeName == "aodTree") {
-      fExternalEvent = new AliAODEvent();
-    }
-    else if (fTreeName == "esdTree") {
-      fExternalEvent = new AliESDEvent();
-    }
-    else {
-      AliError(Form("Tree name %s not recognized!", fTreeName.Data()));
-      return kFALSE;
-    }
+    fExternalEvent = CreateExternalEvent();
+    if (!fExternalEvent) return kFALSE;
   }
 
-  fExternalEvent->ReadFromTree(fChain, fTreeName);
+  if (fNPrefetchEvents > 0) {
+    // The TChain is read by the background thread into its own event, which is then copied
+    if (!fReaderEvent) {
+      fReaderEvent = CreateExternalEvent();
+      if (!fReaderEvent) return kFALSE;
+    }
+    fReaderEvent->ReadFromTree(fChain, fTreeName);
+  }
+  else {
+    fExternalEvent->ReadFromTree(fChain, fTreeName);
+  }
 
   return kTRUE;
 }
 
+/**
+ * Create an empty event of the type corresponding to the tree name.
+ *
+ * @return The new event, or nullptr if the tree name is not recognized
+ */
+AliVEvent * AliAnalysisTaskEmcalEmbeddingHelper::CreateExternalEvent() const
+{
+  if (fTreeName == "aodTree") {
+    return new AliAODEvent();
+  }
+  else if (fTreeName == "esdTree") {
+    return new AliESDEvent();
+  }
+  AliError(Form("Tree name %s not recognized!", fTreeName.Data()));
+  return nullptr;
+}
+
+/**
+ * Copy the content of an external event into another event of the same type. The objects of the target
+ * event are kept (they are overwritten in place), so pointers to them which are held by other tasks stay valid.
+ *
+ * @param[in] source Event to be copied
+ * @param[out] target Event into which the content is copied
+ *
+ * @return true if both events are of the same type and the event was copied
+ */
+bool AliAnalysisTaskEmcalEmbeddingHelper::CopyEvent(const AliVEvent * source, AliVEvent * target)
+{
+  const AliAODEvent * aodSource = dynamic_cast<const AliAODEvent *>(source);
+  AliAODEvent * aodTarget = dynamic_cast<AliAODEvent *>(target);
+  if (aodSource && aodTarget) {
+    *aodTarget = *aodSource;
+    return true;
+  }
+  const AliESDEvent * esdSource = dynamic_cast<const AliESDEvent *>(source);
+  AliESDEvent * esdTarget = dynamic_cast<AliESDEvent *>(target);
+  if (esdSource && esdTarget) {
+    *esdTarget = *esdSource;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Start the background thread which reads the external events ahead. The thread keeps up to
+ * fNPrefetchEvents fully read events in a queue and loads the next tree of the TChain (ie. opens
+ * the next file) as soon as it reaches the end of the current one, while the main event is analyzed.
+ * The order of the events and the entry access values are the same as when reading synchronously.
+ *
+ * @return true if the thread was started
+ */
+bool AliAnalysisTaskEmcalEmbeddingHelper::StartEventQueue()
+{
+  if (fEventQueue) return true;
+  if (!fReaderEvent) return false;
+
+  // All other ROOT I/O of the analysis happens concurrently with the reader thread
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+  ROOT::EnableThreadSafety();
+#endif
+
+  std::vector<AliVEvent *> slots;
+  for (Int_t i = 0; i < fNPrefetchEvents; i++) {
+    AliVEvent * event = CreateExternalEvent();
+    if (!event) break;
+    slots.push_back(event);
+  }
+  if (slots.empty()) return false;
+
+  // Only called from the reader thread. The entry access values and the TChain are not used by the main
+  // thread while the queue exists, the histograms are filled when the events are taken from the queue.
+  auto reader = [this] (AliEmcalEmbeddingEventQueue::Item & item) {
+    item.fNewTrees.clear();
+    if (!fInitializedNewFile) {
+      LoadNextTree();
+      item.fNewTrees.push_back(fFileNumber);
+    }
+    ReadNextEntry(item.fNewTrees, item.fRestarted);
+    // The references only resolve to the objects of the event until the next entry is read
+    item.fRefs.Record(fReaderEvent);
+    return CopyEvent(fReaderEvent, item.fEvent);
+  };
+
+  fEventQueue = new AliEmcalEmbeddingEventQueue(slots, reader);
+  fEventQueue->Start();
+  AliInfo(TString::Format("Reading up to %lu external events ahead in a background thread.", slots.size()));
+
+  return true;
+}
+
 /**
  * Performing run-independent initialization to setup embedding.
  *
@@ -1251,6 +1404,13 @@ void AliAnalysisTaskEmcalEmbeddingHelper::SetupEmbedding()
     AliFatal("The configuration is not initialized. Check that Initialize() was called!");
   }
 
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,6,0)
+  if (fNPrefetchEvents > 0) {
+    AliWarning("Reading external events in a background thread requires ROOT 6.06 or later. Reading them synchronously.");
+    fNPrefetchEvents = 0;
+  }
+#endif
+
   // Setup TChain
   Bool_t res = SetupInputFiles();
   if (!res) { return; }
@@ -1259,6 +1419,11 @@ void AliAnalysisTaskEmcalEmbeddingHelper::SetupEmbedding()
   if (fRandomEventNumberAccess) {
     AliInfo("Random event number access enabled!");
   }
+
+  // Start reading the external events ahead
+  if (fNPrefetchEvents > 0 && !StartEventQueue()) {
+    AliFatal("Could not start reading the external events in a background thread!");
+  }
   
   fInitializedEmbedding = kTRUE;
 }
@@ -1274,6 +1439,16 @@ void AliAnalysisTaskEmcalEmbeddingHelper::SetupEmbedding()
  * Sets fInitializedNewFile to kTRUE when the new entries in the tree have been initialized.
  */
 void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
+{
+  LoadNextTree();
+  RecordNewTree(fFileNumber);
+}
+
+/**
+ * Load the next TTree within the TChain and set the limits of its entries and the entry to start from.
+ * Only the entry access values are changed, see InitTree().
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::LoadNextTree()
 {
   // Load first entry of the (next) file so that we can query information about it
   // (it is unaccessible otherwise).
@@ -1306,38 +1481,47 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
     fFileNumber++;
   }
 
+  AliDebug(2, TString::Format("Will start embedding file %i beginning from entry %i (entry %i within the file). NOTE: This file number is not equal to the absolute file number in the file list!", fFileNumber, fCurrentEntry, fCurrentEntry - fLowerEntry));
+  // NOTE: Cannot use this print message, as it is possible that fMaxNumberOfFiles != fFilenames.size() because
+  //       invalid filenames may be included in the fFilenames count!
+  //AliDebug(2, TString::Format("Will start embedding file %i as the %ith file beginning from entry %i.", (fFilenameIndex + fFileNumber) % fMaxNumberOfFiles, fFileNumber, fCurrentEntry));
+
+  // (re)set whether we have wrapped the tree
+  fWrappedAroundTree = false;
+
+  // Note that the tree in the new file has been initialized
+  fInitializedNewFile = kTRUE;
+}
+
+/**
+ * Bookkeeping for a new tree within the TChain: count the embedded files and extract the pythia
+ * cross section of the file if possible.
+ *
+ * @param[in] fileNumber File number of the new tree (see fFileNumber)
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::RecordNewTree(UInt_t fileNumber)
+{
   // Add to the count the number of files which were embedded
   fHistManager.FillTH1("fHistNumberOfFilesEmbedded", 1);
-  fHistManager.FillTH1("fHistAbsoluteFileNumber", (fFileNumber + fFilenameIndex) % fMaxNumberOfFiles);
+  fHistManager.FillTH1("fHistAbsoluteFileNumber", (fileNumber + fFilenameIndex) % fMaxNumberOfFiles);
 
   // Check for pythia cross section and extract if possible
-  // fFileNumber corresponds to the next file
+  // fileNumber corresponds to the new file
   // If there are pythia filenames, the number of match the file number of the tree.
   // If we previously gave up on extracting then there should be no entires
   if (fPythiaCrossSectionFilenames.size() > 0) {
-    // Need to check that fFileNumber is smaller than the size of the vector because we don't check if
-    if (fFileNumber < fPythiaCrossSectionFilenames.size()) {
-      bool success = PythiaInfoFromCrossSectionFile(fPythiaCrossSectionFilenames.at(fFileNumber));
+    // Need to check that fileNumber is smaller than the size of the vector because we don't check if
+    if (fileNumber < fPythiaCrossSectionFilenames.size()) {
+      bool success = PythiaInfoFromCrossSectionFile(fPythiaCrossSectionFilenames.at(fileNumber));
 
       if (!success) {
         AliDebugStream(3) << "Failed to retrieve cross section from xsec file. Will still attempt to get the information from the header.\n";
       }
     }
     else {
-      AliErrorStream() << "Attempted to read past the end of the pythia cross section filenames vector. File number: " << fFileNumber << ", vector size: " << fPythiaCrossSectionFilenames.size() << ".\nThis should only occur if we have run out of files to embed!\n";
+      AliErrorStream() << "Attempted to read past the end of the pythia cross section filenames vector. File number: " << fileNumber << ", vector size: " << fPythiaCrossSectionFilenames.size() << ".\nThis should only occur if we have run out of files to embed!\n";
     }
   }
-
-  AliDebug(2, TString::Format("Will start embedding file %i beginning from entry %i (entry %i within the file). NOTE: This file number is not equal to the absolute file number in the file list!", fFileNumber, fCurrentEntry, fCurrentEntry - fLowerEntry));
-  // NOTE: Cannot use this print message, as it is possible that fMaxNumberOfFiles != fFilenames.size() because
-  //       invalid filenames may be included in the fFilenames count!
-  //AliDebug(2, TString::Format("Will start embedding file %i as the %ith file beginning from entry %i.", (fFilenameIndex + fFileNumber) % fMaxNumberOfFiles, fFileNumber, fCurrentEntry));
-
-  // (re)set whether we have wrapped the tree
-  fWrappedAroundTree = false;
-
-  // Note that the tree in the new file has been initialized
-  fInitializedNewFile = kTRUE;
 }
 
 /**
@@ -1460,7 +1644,8 @@ void AliAnalysisTaskEmcalEmbeddingHelper::UserExec(Option_t*)
     }
   }
 
-  if (!fInitializedNewFile) {
+  // With the background reader the first tree is loaded by the reader thread
+  if (!fEventQueue && !fInitializedNewFile) {
     InitTree();
   }
 
@@ -1476,6 +1661,18 @@ void AliAnalysisTaskEmcalEmbeddingHelper::UserExec(Option_t*)
   }
 }
 
+/**
+ * Stop the background reader thread (if any) at the end of the event loop, before the
+ * output is written and the process exits.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::FinishTaskOutput()
+{
+  if (fEventQueue) {
+    delete fEventQueue;
+    fEventQueue = nullptr;
+  }
+}
+
 /**
  * This function is called once at the end of the analysis.
  */
@@ -1628,6 +1825,7 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "Random event number access: " << fRandomEventNumberAccess << "\n";
   tempSS << "Random file access: " << fRandomFileAccess << "\n";
   tempSS << "Starting file index: " << fFilenameIndex << "\n";
+  tempSS << "Number of prefetched external events: " << fNPrefetchEvents << "\n";
   tempSS << "Number of files to embed: " << fFilenames.size() << "\n";
   tempSS << "YAML configuration path: \"" << fConfigurationPath << "\"\n";
   tempSS << "Enable internal event selection: " << fUseInternalEventSelection << "\n";
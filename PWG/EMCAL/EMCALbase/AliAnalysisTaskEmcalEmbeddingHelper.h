@@ -23,6 +23,7 @@ class AliVEvent;
 class AliVHeader;
 class AliGenPythiaEventHeader;
 class AliEmcalList;
+class AliEmcalEmbeddingEventQueue;
 
 #include <iosfwd>
 #include <vector>
@@ -80,6 +81,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void      UserExec(Option_t *option)                           ;
   void      UserCreateOutputObjects()                            ;
   void      Terminate(Option_t *option)                          ;
+  void      FinishTaskOutput()                                   ;
   /* @} */
 
   static const AliAnalysisTaskEmcalEmbeddingHelper* GetInstance() { return fgInstance       ; }
@@ -114,6 +116,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Int_t GetStartingFileIndex()                              const { return fFilenameIndex; }
   TString GetFileListFilename()                             const { return fFileListFilename; }
   bool GetCreateHistos()                                    const { return fCreateHisto; }
+  Int_t GetNumberOfPrefetchedEvents()                       const { return fNPrefetchEvents; }
 
   // Set
   /// Set the pt hard bin which will be added into the file pattern. Can also be omitted and set directly in the pattern.
@@ -146,6 +149,14 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetCreateHistos(bool b)                                    { fCreateHisto = b; }
   /// Set path to YAML configuration file
   void SetConfigurationPath(const char * path)                    { fConfigurationPath = path; }
+  /**
+   * Read up to n external events ahead in a background thread, which also opens the next file before it is needed.
+   * The events are selected in the same order and with the same bookkeeping as when reading them synchronously,
+   * but each event is copied once more. The references (TRef, TRefArray) of AOD events are set again on the copy;
+   * references to objects which are not in the event lists are lost, and the referenced objects get unique IDs which are reused from event to event.
+   * 0 (default) reads the external events synchronously in UserExec().
+   */
+  void SetNumberOfPrefetchedEvents(Int_t n)                       { fNPrefetchEvents = n; }
   /* @} */
 
   /**
@@ -286,12 +297,18 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t          SetupInputFiles()     ;
   std::string     DeterminePythiaXSecFilename(TString baseFileName, TString pythiaBaseFilename, bool testIfExists) const;
   Bool_t          GetNextEntry()        ;
+  void            ReadNextEntry(std::vector<UInt_t> & newTrees, bool & restarted);
   void            SetEmbeddedEventProperties();
   void            RecordEmbeddedEventProperties();
   Bool_t          IsEventSelected()     ;
   Bool_t          CheckIsEmbeddedEventSelected();
   Bool_t          InitEvent()           ;
+  AliVEvent      *CreateExternalEvent() const;
+  static bool     CopyEvent(const AliVEvent * source, AliVEvent * target);
+  bool            StartEventQueue()     ;
   void            InitTree()            ;
+  void            LoadNextTree()        ;
+  void            RecordNewTree(UInt_t fileNumber);
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
   // LEGO Train utility
   void            RemoveDummyTask() const;
@@ -313,6 +330,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t                                        fRandomEventNumberAccess; ///<  If true, it will start embedding from a random entry in the file rather than from the first
   Bool_t                                        fRandomFileAccess ; ///<  If true, it will start embedding from a random file in the input files list
   bool                                          fCreateHisto      ; ///<  If true, create QA histograms
+  Int_t                                         fNPrefetchEvents  ; ///<  Number of external events read ahead by a background thread (0: read synchronously)
   PWG::Tools::AliYAMLConfiguration              fYAMLConfig       ; ///<  Hanldes configuration from YAML
 
   bool                                  fUseInternalEventSelection; ///<  If true, apply internal event selection though AliEventCuts
@@ -355,6 +373,10 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   double                                        fPythiaCrossSectionFromFile; //!<! Average pythia cross section extracted from a xsec file.
   double                                        fPythiaPtHard     ; //!<! Pt hard of the current event (extracted from the pythia header).
 
+  AliVEvent                                    *fReaderEvent      ; //!<! Event connected to the TChain when the external events are read by the background thread
+  AliEmcalEmbeddingEventQueue                  *fEventQueue       ; //!<! Queue of external events filled by the background thread
+  std::vector<UInt_t>                           fNewTrees         ; //!<! File numbers of the trees loaded to read the current external event
+
   static AliAnalysisTaskEmcalEmbeddingHelper   *fgInstance        ; //!<! Global instance of this class
 
  private:
@@ -362,7 +384,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 9);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 10);
   /// \endcond
 };
 #endif
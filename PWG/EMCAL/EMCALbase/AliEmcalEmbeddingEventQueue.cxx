@@ -0,0 +1,152 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <AliVEvent.h>
+
+#include "AliEmcalEmbeddingEventQueue.h"
+
+/**
+ * Constructor. The queue takes ownership of the event slots.
+ *
+ * @param[in] slots Events which are filled by the reader. Their number limits how far the reader runs ahead.
+ * @param[in] reader Function which fills a slot with the next external event.
+ */
+AliEmcalEmbeddingEventQueue::AliEmcalEmbeddingEventQueue(const std::vector<AliVEvent *> & slots, Reader_t reader) :
+  fItems(),
+  fFree(),
+  fFilled(),
+  fReader(reader),
+  fThread(),
+  fMutex(),
+  fCondition(),
+  fStop(false),
+  fDone(false)
+{
+  fItems.reserve(slots.size());
+  for (auto event : slots) {
+    fItems.push_back(Item(event));
+  }
+  for (auto & item : fItems) {
+    fFree.push_back(&item);
+  }
+}
+
+/**
+ * Destructor. Stops the reader thread and deletes the events.
+ */
+AliEmcalEmbeddingEventQueue::~AliEmcalEmbeddingEventQueue()
+{
+  Stop();
+  for (auto & item : fItems) {
+    delete item.fEvent;
+  }
+}
+
+/**
+ * Start the reader thread.
+ */
+void AliEmcalEmbeddingEventQueue::Start()
+{
+  if (fThread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = false;
+    fDone = false;
+  }
+  fThread = std::thread(&AliEmcalEmbeddingEventQueue::Run, this);
+}
+
+/**
+ * Stop the reader thread and wait for it to finish. Events which were read but not yet
+ * taken with Next() stay in the queue.
+ */
+void AliEmcalEmbeddingEventQueue::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fCondition.notify_all();
+  if (fThread.joinable()) fThread.join();
+}
+
+/**
+ * Retrieve the next external event, waiting for the reader if needed. The slot must be given
+ * back with Release() before the next call.
+ *
+ * @return The next slot, or nullptr if the reader has stopped and the queue is empty.
+ */
+AliEmcalEmbeddingEventQueue::Item * AliEmcalEmbeddingEventQueue::Next()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  fCondition.wait(lock, [this] { return !fFilled.empty() || fDone; });
+  if (fFilled.empty()) return nullptr;
+  Item * item = fFilled.front();
+  fFilled.pop_front();
+  return item;
+}
+
+/**
+ * Give a slot back to the reader.
+ *
+ * @param[in] item Slot retrieved with Next()
+ */
+void AliEmcalEmbeddingEventQueue::Release(Item * item)
+{
+  if (!item) return;
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fFree.push_back(item);
+  }
+  fCondition.notify_all();
+}
+
+/**
+ * Loop of the reader thread: fill free slots until stopped or until the reader function fails.
+ */
+void AliEmcalEmbeddingEventQueue::Run()
+{
+  while (true) {
+    Item * item = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCondition.wait(lock, [this] { return !fFree.empty() || fStop; });
+      if (fStop) break;
+      item = fFree.front();
+      fFree.pop_front();
+    }
+
+    // Reading is done without holding the lock
+    item->fNewTrees.clear();
+    item->fRestarted = false;
+    bool success = fReader(*item);
+
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (!success) {
+        fFree.push_front(item);
+        break;
+      }
+      fFilled.push_back(item);
+    }
+    fCondition.notify_all();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fDone = true;
+  }
+  fCondition.notify_all();
+}
@@ -0,0 +1,82 @@
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+#ifndef ALIEMCALEMBEDDINGEVENTQUEUE_H
+#define ALIEMCALEMBEDDINGEVENTQUEUE_H
+
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Rtypes.h>
+
+#include "AliEmcalEmbeddingEventRefs.h"
+
+class AliVEvent;
+
+/**
+ * @class AliEmcalEmbeddingEventQueue
+ * @ingroup EMCALCOREFW
+ * @brief Bounded queue of external events filled by a background reader thread
+ *
+ * The queue owns a fixed number of event slots. A reader thread takes a free slot, fills it through
+ * the reader function (which reads the next entry of the external TChain, records its references and copies it into the slot)
+ * and appends it to the queue. The consumer takes the events in the order in which they were read with
+ * Next() and gives the slot back with Release() once it has copied the event. The reader therefore runs
+ * at most the number of slots ahead of the consumer, and file opening and basket reading of the external
+ * events overlap with the analysis of the internal event.
+ *
+ * The reader function is only called from the reader thread, so all objects that it touches (the TChain,
+ * the event connected to it) must not be used by the consumer while the queue is running. ROOT thread
+ * safety has to be enabled before Start() is called.
+ *
+ * This class is used by AliAnalysisTaskEmcalEmbeddingHelper and is not intended to be used elsewhere.
+ */
+class AliEmcalEmbeddingEventQueue {
+ public:
+  /**
+   * @struct Item
+   * @brief Slot of the queue: external event and the file bookkeeping of the entry it was read from
+   */
+  struct Item {
+    Item(AliVEvent * event = nullptr) : fEvent(event), fNewTrees(), fRestarted(false), fRefs() {}
+    AliVEvent * fEvent;               ///< External event owned by the queue
+    std::vector<UInt_t> fNewTrees;    ///< File numbers of the trees of the TChain which were loaded to read the event
+    bool fRestarted;                  ///< True if the reader ran out of files and restarted from the beginning of the TChain
+    AliEmcalEmbeddingEventRefs fRefs; ///< References between the objects of the event, recorded when it was read
+  };
+  /// Fills the item with the next external event. Returning false stops the reader.
+  typedef std::function<bool (Item &)> Reader_t;
+
+  AliEmcalEmbeddingEventQueue(const std::vector<AliVEvent *> & slots, Reader_t reader);
+  ~AliEmcalEmbeddingEventQueue();
+
+  void Start();
+  void Stop();
+
+  Item * Next();
+  void Release(Item * item);
+
+ private:
+  AliEmcalEmbeddingEventQueue(const AliEmcalEmbeddingEventQueue &);            // not implemented
+  AliEmcalEmbeddingEventQueue &operator=(const AliEmcalEmbeddingEventQueue &); // not implemented
+
+  void Run();
+
+  std::vector<Item> fItems;           ///< All slots
+  std::deque<Item *> fFree;           ///< Slots which can be filled by the reader
+  std::deque<Item *> fFilled;         ///< Slots which are filled, in reading order
+  Reader_t fReader;                   ///< Reads the next external event into a slot
+  std::thread fThread;                ///< Reader thread
+  std::mutex fMutex;                  ///< Protects the slot lists and the flags
+  std::condition_variable fCondition; ///< Signals changes of the slot lists and the flags
+  bool fStop;                         ///< Set by the consumer to stop the reader
+  bool fDone;                         ///< Set by the reader when it has stopped
+};
+
+#endif /* ALIEMCALEMBEDDINGEVENTQUEUE_H */
+#endif /* __CINT__ */
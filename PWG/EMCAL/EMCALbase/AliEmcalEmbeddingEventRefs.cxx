@@ -0,0 +1,339 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <TClass.h>
+#include <TClonesArray.h>
+#include <TObjArray.h>
+#include <TDataMember.h>
+#include <TList.h>
+#include <TProcessID.h>
+#include <TRealData.h>
+#include <TRef.h>
+#include <TRefArray.h>
+
+#include <AliAODEvent.h>
+#include <AliVEvent.h>
+
+#include "AliEmcalEmbeddingEventRefs.h"
+
+std::map<TClass *, std::vector<AliEmcalEmbeddingEventRefs::Member> > AliEmcalEmbeddingEventRefs::fgMembers;
+std::mutex AliEmcalEmbeddingEventRefs::fgMembersMutex;
+
+/**
+ * Record the references between the objects of the event. Has to be called while the event is the
+ * one connected to the tree, so that the references resolve to its objects.
+ *
+ * @param[in] event Event which was just read
+ */
+void AliEmcalEmbeddingEventRefs::Record(const AliVEvent * event)
+{
+  Clear();
+  const AliAODEvent * aodEvent = dynamic_cast<const AliAODEvent *>(event);
+  if (!aodEvent || !aodEvent->GetList()) return;
+
+  // Position of every object of the event
+  std::vector<TObject *> containers;
+  std::unordered_map<const TObject *, std::pair<Int_t, Int_t> > positions;
+  TIter next(aodEvent->GetList());
+  while (TObject * container = next()) {
+    Int_t icontainer = containers.size();
+    containers.push_back(container);
+    fContainers.push_back(container->GetName());
+    for (Int_t i = 0; i < GetEntries(container); i++) {
+      TObject * obj = GetEntry(container, i);
+      if (obj) positions[obj] = std::make_pair(icontainer, i);
+    }
+  }
+
+  // Store the position of the object behind every reference
+  auto addLink = [&] (Int_t icontainer, Int_t index, Int_t imember, Int_t element, const TObject * target) {
+    if (!target) return;
+    auto position = positions.find(target);
+    if (position == positions.end()) return;
+    fLinks.push_back(Link{icontainer, index, imember, element, position->second.first, position->second.second});
+  };
+
+  for (UInt_t icontainer = 0; icontainer < containers.size(); icontainer++) {
+    for (Int_t i = 0; i < GetEntries(containers[icontainer]); i++) {
+      TObject * obj = GetEntry(containers[icontainer], i);
+      if (!obj) continue;
+      const std::vector<Member> & members = GetMembers(obj->IsA());
+      char * address = reinterpret_cast<char *>(obj);
+      for (UInt_t imember = 0; imember < members.size(); imember++) {
+        const Member & member = members[imember];
+        if (member.fType == kRef || member.fType == kRefPointer) {
+          TRef * refs = reinterpret_cast<TRef *>(address + member.fOffset);
+          Int_t n = member.fLength;
+          if (member.fType == kRefPointer) {
+            refs = *reinterpret_cast<TRef **>(address + member.fOffset);
+            n = refs ? *reinterpret_cast<Int_t *>(address + member.fCountOffset) : 0;
+          }
+          for (Int_t element = 0; element < n; element++) {
+            addLink(icontainer, i, imember, element, refs[element].GetObject());
+          }
+        }
+        else {
+          TRefArray * array = reinterpret_cast<TRefArray *>(address + member.fOffset);
+          if (member.fType == kRefArrayPointer) array = *reinterpret_cast<TRefArray **>(address + member.fOffset);
+          if (!array) continue;
+          for (Int_t element = 0; element < array->GetEntriesFast(); element++) {
+            addLink(icontainer, i, imember, element, array->At(element));
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Set the recorded references on a copy of the recorded event. All references which were copied from
+ * the recorded event are cleared first, so that none of them is resolved through the object table of
+ * the file. The referenced objects of the copy get unique IDs of the session process ID from the range
+ * reserved by ReserveIDs().
+ *
+ * @param[in,out] event Copy of the recorded event
+ */
+void AliEmcalEmbeddingEventRefs::Restore(AliVEvent * event)
+{
+  AliAODEvent * aodEvent = dynamic_cast<AliAODEvent *>(event);
+  if (!aodEvent) return;
+
+  std::vector<TObject *> containers(fContainers.size(), nullptr);
+  for (UInt_t icontainer = 0; icontainer < fContainers.size(); icontainer++) {
+    containers[icontainer] = aodEvent->FindListObject(fContainers[icontainer]);
+    if (!containers[icontainer]) continue;
+    for (Int_t i = 0; i < GetEntries(containers[icontainer]); i++) {
+      TObject * obj = GetEntry(containers[icontainer], i);
+      if (!obj) continue;
+      for (const auto & member : GetMembers(obj->IsA())) {
+        ResetMember(obj, member);
+      }
+      // Objects referenced in a previous event keep their ID of the range, which is given to another object now
+      if (obj->TestBit(kIsReferenced) && obj->GetUniqueID() >= fFirstID && obj->GetUniqueID() < fFirstID + fNIDs) {
+        obj->ResetBit(kIsReferenced);
+        obj->SetUniqueID(0);
+      }
+    }
+  }
+
+  // The referenced objects still have the unique IDs of the file: register them with the IDs of the range
+  std::vector<TObject *> targets;
+  std::unordered_set<TObject *> seen;
+  for (const auto & link : fLinks) {
+    TObject * target = GetEntry(containers[link.fTargetContainer], link.fTargetIndex);
+    if (!target || !seen.insert(target).second) continue;
+    target->ResetBit(kIsReferenced);
+    target->SetUniqueID(0);
+    targets.push_back(target);
+  }
+  if (ReserveIDs(targets.size())) {
+    TProcessID * pid = TProcessID::GetSessionProcessID();
+    for (UInt_t i = 0; i < targets.size(); i++) {
+      targets[i]->SetUniqueID(fFirstID + i);
+      targets[i]->SetBit(kIsReferenced);
+      pid->PutObjectWithID(targets[i], fFirstID + i);
+    }
+    // IDs of the range which are not used by this event
+    for (UInt_t i = targets.size(); i < fNIDs; i++) {
+      if (pid->GetObjects()) pid->GetObjects()->RemoveAt(fFirstID + i);
+    }
+  }
+  // otherwise new IDs are assigned by TProcessID::AssignID() when the objects are referenced
+
+  for (const auto & link : fLinks) {
+    TObject * obj = GetEntry(containers[link.fContainer], link.fIndex);
+    TObject * target = GetEntry(containers[link.fTargetContainer], link.fTargetIndex);
+    if (!obj || !target) continue;
+    const std::vector<Member> & members = GetMembers(obj->IsA());
+    if (link.fMember >= static_cast<Int_t>(members.size())) continue;
+    const Member & member = members[link.fMember];
+    char * address = reinterpret_cast<char *>(obj);
+    if (member.fType == kRef || member.fType == kRefPointer) {
+      TRef * refs = reinterpret_cast<TRef *>(address + member.fOffset);
+      Int_t n = member.fLength;
+      if (member.fType == kRefPointer) {
+        refs = *reinterpret_cast<TRef **>(address + member.fOffset);
+        n = refs ? *reinterpret_cast<Int_t *>(address + member.fCountOffset) : 0;
+      }
+      if (link.fElement < n) refs[link.fElement] = target;
+    }
+    else {
+      TRefArray * array = reinterpret_cast<TRefArray *>(address + member.fOffset);
+      if (member.fType == kRefArrayPointer) array = *reinterpret_cast<TRefArray **>(address + member.fOffset);
+      if (array) array->AddAtAndExpand(target, link.fElement);
+    }
+  }
+}
+
+/**
+ * Make sure that the range of unique IDs holds at least n IDs. The range is extended in place if no
+ * other ID was assigned after it, and otherwise a new range is taken at the end of the object table of
+ * the session process ID. IDs are assigned by TProcessID::AssignID() as long as the session process ID
+ * is not the current one (more than 16M IDs assigned in the session), in which case false is returned.
+ *
+ * @param[in] n Number of IDs needed
+ *
+ * @return True if the range can be used
+ */
+Bool_t AliEmcalEmbeddingEventRefs::ReserveIDs(UInt_t n)
+{
+  if (n == 0) return kTRUE;
+  if (TProcessID::GetPID() != TProcessID::GetSessionProcessID()) return kFALSE;
+
+  // TProcessID::AssignID() gives the object count + 1 to the next object
+  UInt_t count = TProcessID::GetObjectCount();
+  if (n <= fNIDs) {
+    // The object count was set back by someone else: keep it from handing out the IDs of the range
+    if (count < fFirstID + fNIDs - 1) TProcessID::SetObjectCount(fFirstID + fNIDs - 1);
+    return kTRUE;
+  }
+  if (fNIDs == 0 || fFirstID + fNIDs - 1 != count) {
+    // The old range is left empty, its objects are referenced with IDs of the new one
+    TObjArray * objects = TProcessID::GetSessionProcessID()->GetObjects();
+    for (UInt_t i = 0; objects && i < fNIDs; i++) objects->RemoveAt(fFirstID + i);
+    fFirstID = count + 1;
+  }
+  if (fFirstID + n - 1 > 0xffffff) {
+    fNIDs = 0;
+    return kFALSE;
+  }
+  fNIDs = n;
+  TProcessID::SetObjectCount(fFirstID + fNIDs - 1);
+  return kTRUE;
+}
+
+/**
+ * Find the persistent reference data members of a class (including the ones of its base classes
+ * and of embedded objects) from the dictionary. The result is cached.
+ *
+ * @param[in] cl Class of the object
+ *
+ * @return Reference data members of the class
+ */
+const std::vector<AliEmcalEmbeddingEventRefs::Member> & AliEmcalEmbeddingEventRefs::GetMembers(TClass * cl)
+{
+  std::lock_guard<std::mutex> lock(fgMembersMutex);
+  auto cached = fgMembers.find(cl);
+  if (cached != fgMembers.end()) return cached->second;
+
+  std::vector<Member> & members = fgMembers[cl];
+  if (!cl) return members;
+  if (!cl->GetListOfRealData()) cl->BuildRealData();
+  if (!cl->GetListOfRealData()) return members;
+
+  TIter next(cl->GetListOfRealData());
+  while (TRealData * realData = static_cast<TRealData *>(next())) {
+    TDataMember * dataMember = realData->GetDataMember();
+    if (!dataMember || !dataMember->IsPersistent()) continue;
+    TString typeName = dataMember->GetTypeName();
+
+    Member member;
+    member.fOffset = realData->GetThisOffset();
+    member.fLength = 1;
+    member.fCountOffset = -1;
+    for (Int_t dim = 0; dim < dataMember->GetArrayDim(); dim++) {
+      member.fLength *= dataMember->GetMaxIndex(dim);
+    }
+
+    if (typeName == "TRef") {
+      member.fType = kRef;
+      if (dataMember->IsaPointer()) {
+        // Variable size array, the counter is given in the comment of the data member
+        const char * count = dataMember->GetArrayIndex();
+        TRealData * countData = (count && count[0]) ? cl->GetRealData(count) : nullptr;
+        if (!countData || !countData->GetDataMember() || member.fLength != 1) continue;
+        if (TString(countData->GetDataMember()->GetTypeName()) != "Int_t") continue;
+        member.fType = kRefPointer;
+        member.fCountOffset = countData->GetThisOffset();
+      }
+    }
+    else if (typeName == "TRefArray") {
+      if (member.fLength != 1) continue;
+      member.fType = dataMember->IsaPointer() ? kRefArrayPointer : kRefArray;
+    }
+    else {
+      continue;
+    }
+    members.push_back(member);
+  }
+
+  return members;
+}
+
+/**
+ * @param[in] container Object of the event list
+ *
+ * @return Number of entries of a TClonesArray, 1 for other objects
+ */
+Int_t AliEmcalEmbeddingEventRefs::GetEntries(TObject * container)
+{
+  if (!container) return 0;
+  TClonesArray * array = dynamic_cast<TClonesArray *>(container);
+  if (array) return array->GetEntriesFast();
+  return 1;
+}
+
+/**
+ * @param[in] container Object of the event list
+ * @param[in] index Index of the entry
+ *
+ * @return Element of a TClonesArray or the object itself for other objects
+ */
+TObject * AliEmcalEmbeddingEventRefs::GetEntry(TObject * container, Int_t index)
+{
+  if (!container || index < 0 || index >= GetEntries(container)) return nullptr;
+  TClonesArray * array = dynamic_cast<TClonesArray *>(container);
+  if (array) return array->UncheckedAt(index);
+  return container;
+}
+
+/**
+ * Clear a reference data member of an object. TRefArrays are set to the session process ID, which
+ * is the one of the objects referenced by Restore().
+ *
+ * @param[in,out] obj Object holding the data member
+ * @param[in] member Reference data member
+ */
+void AliEmcalEmbeddingEventRefs::ResetMember(TObject * obj, const Member & member)
+{
+  char * address = reinterpret_cast<char *>(obj) + member.fOffset;
+  TRef * refs = nullptr;
+  Int_t n = 0;
+  TRefArray * array = nullptr;
+  switch (member.fType) {
+    case kRef:
+      refs = reinterpret_cast<TRef *>(address);
+      n = member.fLength;
+      break;
+    case kRefPointer:
+      refs = *reinterpret_cast<TRef **>(address);
+      n = refs ? *reinterpret_cast<Int_t *>(reinterpret_cast<char *>(obj) + member.fCountOffset) : 0;
+      break;
+    case kRefArray:
+      array = reinterpret_cast<TRefArray *>(address);
+      break;
+    case kRefArrayPointer:
+      array = *reinterpret_cast<TRefArray **>(address);
+      break;
+  }
+  for (Int_t element = 0; element < n; element++) {
+    refs[element] = static_cast<TObject *>(nullptr);
+  }
+  if (array) *array = TRefArray(TProcessID::GetSessionProcessID());
+}
@@ -0,0 +1,103 @@
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+#ifndef ALIEMCALEMBEDDINGEVENTREFS_H
+#define ALIEMCALEMBEDDINGEVENTREFS_H
+
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <Rtypes.h>
+#include <TString.h>
+
+class TClass;
+class TObject;
+class AliVEvent;
+
+/**
+ * @class AliEmcalEmbeddingEventRefs
+ * @ingroup EMCALCOREFW
+ * @brief References (TRef, TRefArray) between the objects of an AOD event, stored by position
+ *
+ * The references of an AOD event are resolved through the object table of the process ID of the file
+ * which the event was read from. A copy of the event keeps the unique IDs of the references, so they
+ * would resolve to the objects which were read last from the file and not to the objects of the copy.
+ *
+ * Record() stores every reference between the objects of the event lists (the elements of the
+ * TClonesArrays and the other objects of the list) as positions, while the objects of the event are
+ * still registered. Restore() clears all references of a copy of the event and sets the recorded ones
+ * again to the objects of the copy, which get new unique IDs in the session process ID. References to
+ * objects which are not in the event lists are lost. ESD events do not contain references and are left
+ * untouched.
+ *
+ * The unique IDs given to the referenced objects by Restore() are taken from a range of the session
+ * process ID which is kept by the object and reused for every event restored from it, so the object
+ * table of the session process ID does not grow with the number of events. The range is only extended
+ * (or moved to the end of the table, if other IDs were assigned in between) when an event has more
+ * referenced objects than any event restored before.
+ *
+ * The reference data members (TRef, arrays of TRef, TRefArray) of each class are found from the
+ * dictionary once and cached.
+ *
+ * This class is used by AliAnalysisTaskEmcalEmbeddingHelper and is not intended to be used elsewhere.
+ */
+class AliEmcalEmbeddingEventRefs {
+ public:
+  AliEmcalEmbeddingEventRefs() : fContainers(), fLinks(), fFirstID(0), fNIDs(0) {}
+
+  void Record(const AliVEvent * event);
+  void Restore(AliVEvent * event);
+  void Clear() { fContainers.clear(); fLinks.clear(); }
+
+ private:
+  /// Kind of reference data member
+  enum EMemberType_t {
+    kRef = 0,          ///< TRef or fixed size array of TRef
+    kRefPointer,       ///< Variable size array of TRef, size given by a counter of the class
+    kRefArray,         ///< TRefArray
+    kRefArrayPointer   ///< Pointer to TRefArray
+  };
+
+  /**
+   * @struct Member
+   * @brief Reference data member of a class
+   */
+  struct Member {
+    EMemberType_t fType;        ///< Kind of reference
+    Long_t        fOffset;      ///< Offset of the data member in the object
+    Int_t         fLength;      ///< Number of references of a fixed size array
+    Long_t        fCountOffset; ///< Offset of the counter of a variable size array
+  };
+
+  /**
+   * @struct Link
+   * @brief Reference from one object of the event to another, given by positions in the event list
+   */
+  struct Link {
+    Int_t fContainer;           ///< Index of the list object (in fContainers) holding the referencing object
+    Int_t fIndex;               ///< Index of the referencing object in its list object
+    Int_t fMember;              ///< Index of the reference data member in the cached members of the class
+    Int_t fElement;             ///< Index of the reference in the data member
+    Int_t fTargetContainer;     ///< Index of the list object holding the referenced object
+    Int_t fTargetIndex;         ///< Index of the referenced object in its list object
+  };
+
+  static const std::vector<Member> & GetMembers(TClass * cl);
+  static Int_t GetEntries(TObject * container);
+  static TObject * GetEntry(TObject * container, Int_t index);
+  static void ResetMember(TObject * obj, const Member & member);
+  Bool_t ReserveIDs(UInt_t n);
+
+  std::vector<TString> fContainers;   ///< Names of the objects of the event list
+  std::vector<Link> fLinks;           ///< Recorded references
+  UInt_t fFirstID;                    ///< First unique ID of the range of the session process ID used by Restore()
+  UInt_t fNIDs;                       ///< Number of unique IDs in the range
+
+  static std::map<TClass *, std::vector<Member> > fgMembers; ///< Reference data members per class
+  static std::mutex fgMembersMutex;                          ///< Protects fgMembers
+};
+
+#endif /* ALIEMCALEMBEDDINGEVENTREFS_H */
+#endif /* __CINT__ */
@@ -5,6 +5,8 @@
 
 #include "AliEmcalClusTrackMatcherTask.h"
 
+#include <algorithm>
+
 #include <TClonesArray.h>
 #include <TClass.h>
 
@@ -32,10 +34,13 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask() :
   fAttachEmcalParticles(kFALSE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseGridMatching(kTRUE),
+  fCrossCheckGridMatching(kFALSE),
   fEmcalTracks(0),
   fEmcalClusters(0),
   fNEmcalTracks(0),
   fNEmcalClusters(0),
+  fClusterGrid(),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0)
 {
@@ -62,10 +67,13 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask(const char *name, Boo
   fAttachEmcalParticles(kFALSE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseGridMatching(kTRUE),
+  fCrossCheckGridMatching(kFALSE),
   fEmcalTracks(0),
   fEmcalClusters(0),
   fNEmcalTracks(0),
   fNEmcalClusters(0),
+  fClusterGrid(),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0)
 {
@@ -281,13 +289,30 @@ void AliEmcalClusTrackMatcherTask::DoMatching()
 {
   // Set the links between tracks and clusters.
 
+  // Clusters are visited in ascending order for each track, also when preselected
+  // by the eta-phi grid, so that the matching result is independent of the mode.
+
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  if (fUseGridMatching) {
+    std::vector<Double_t> clusEta(fNEmcalClusters), clusPhi(fNEmcalClusters);
+    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+      AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+      AliEmcalClusterEtaPhiGrid::GetClusterEtaPhi(emcalCluster->GetCluster(), clusEta[icluster], clusPhi[icluster]);
+    }
+    fClusterGrid.Build(clusEta, clusPhi, fMaxDistance);
+  }
+
+  std::vector<Int_t> candidates;
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    FindCandidateClusters(track, candidates);
+    if (fUseGridMatching && fCrossCheckGridMatching) CrossCheckCandidates(itrack, track, candidates);
+
+    for (std::vector<Int_t>::const_iterator icand = candidates.begin(); icand != candidates.end(); ++icand) {
+      const Int_t icluster = *icand;
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
 
@@ -323,6 +348,44 @@ void AliEmcalClusTrackMatcherTask::DoMatching()
   }
 }
 
+//________________________________________________________________________
+void AliEmcalClusTrackMatcherTask::FindCandidateClusters(AliVTrack *track, std::vector<Int_t> &candidates) const
+{
+  // Get the clusters to be tested against the track, in ascending order.
+  // Without the grid all clusters are candidates.
+
+  if (fUseGridMatching) {
+    fClusterGrid.FindCandidates(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), candidates);
+    return;
+  }
+
+  candidates.resize(fNEmcalClusters);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) candidates[icluster] = icluster;
+}
+
+//________________________________________________________________________
+void AliEmcalClusTrackMatcherTask::CrossCheckCandidates(Int_t itrack, AliVTrack *track, const std::vector<Int_t> &candidates)
+{
+  // Test all clusters which were not preselected by the grid.
+  // Any of them passing the distance cut is a match lost by the grid.
+
+  const Double_t maxd2 = fMaxDistance*fMaxDistance;
+
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    if (std::binary_search(candidates.begin(), candidates.end(), icluster)) continue;
+
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    Double_t deta = 999;
+    Double_t dphi = 999;
+    GetEtaPhiDiff(track, emcalCluster->GetCluster(), dphi, deta);
+    Double_t d2 = deta * deta + dphi * dphi;
+    if (d2 > maxd2) continue;
+
+    AliError(Form("Grid matching lost match of track %d (eta = %.4f, phi = %.4f on EMCal) with cluster %d (eta = %.4f, phi = %.4f), d = %.4f",
+        itrack, track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), icluster, emcalCluster->Eta(), emcalCluster->Phi(), TMath::Sqrt(d2)));
+  }
+}
+
 //________________________________________________________________________
 void AliEmcalClusTrackMatcherTask::UpdateClusters() 
 {
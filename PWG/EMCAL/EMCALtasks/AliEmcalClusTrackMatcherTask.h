@@ -1,7 +1,10 @@
 #ifndef ALIEMCALCLUSTRACKMATCHERTASK_H
 #define ALIEMCALCLUSTRACKMATCHERTASK_H
 
+#include <vector>
+
 #include "AliAnalysisTaskEmcal.h"
+#include "AliEmcalClusterEtaPhiGrid.h"
 
 class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
  public:
@@ -17,6 +20,8 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   void          SetAttachEmcalParticles(Bool_t b) { fAttachEmcalParticles  = b; }
   void          SetUpdateTracks(Bool_t b)         { fUpdateTracks          = b; }
   void          SetUpdateClusters(Bool_t b)       { fUpdateClusters        = b; }
+  void          SetUseGridMatching(Bool_t b)      { fUseGridMatching       = b; }
+  void          SetCrossCheckGridMatching(Bool_t b) { fCrossCheckGridMatching = b; }
 
  protected:
   void          ExecOnce();
@@ -26,6 +31,8 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
 
   void          GenerateEmcalParticles();
   void          DoMatching();
+  void          FindCandidateClusters(AliVTrack *track, std::vector<Int_t> &candidates) const;
+  void          CrossCheckCandidates(Int_t itrack, AliVTrack *track, const std::vector<Int_t> &candidates);
   void          UpdateTracks();
   void          UpdateClusters();
   
@@ -37,11 +44,14 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   Bool_t        fAttachEmcalParticles;  // attach emcal particles to the event, so that other tasks can use them
   Bool_t        fUpdateTracks;          // update tracks with matching info
   Bool_t        fUpdateClusters;        // update clusters with matching info
+  Bool_t        fUseGridMatching;       // preselect clusters using an eta-phi grid instead of testing all clusters
+  Bool_t        fCrossCheckGridMatching;// check that the grid preselection does not lose matches found by testing all clusters
 
   TClonesArray *fEmcalTracks;           //!emcal tracks
   TClonesArray *fEmcalClusters;         //!emcal clusters
   Int_t         fNEmcalTracks;          //!number of emcal tracks
   Int_t         fNEmcalClusters;        //!number of emcal clusters
+  AliEmcalClusterEtaPhiGrid fClusterGrid; //!eta-phi grid of emcal clusters
   TH1          *fHistMatchEtaAll;       //!deta distribution
   TH1          *fHistMatchPhiAll;       //!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!deta distribution
@@ -51,6 +61,6 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   AliEmcalClusTrackMatcherTask(const AliEmcalClusTrackMatcherTask&);            // not implemented
   AliEmcalClusTrackMatcherTask &operator=(const AliEmcalClusTrackMatcherTask&); // not implemented
 
-  ClassDef(AliEmcalClusTrackMatcherTask, 8) // Cluster-Track matching task
+  ClassDef(AliEmcalClusTrackMatcherTask, 9) // Cluster-Track matching task
 };
 #endif
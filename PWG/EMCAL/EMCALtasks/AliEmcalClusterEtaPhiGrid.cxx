@@ -0,0 +1,190 @@
+// AliEmcalClusterEtaPhiGrid
+//
+
+#include "AliEmcalClusterEtaPhiGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <TMath.h>
+#include <TVector3.h>
+
+#include "AliVCluster.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalClusterEtaPhiGrid);
+/// \endcond
+
+const Int_t AliEmcalClusterEtaPhiGrid::kMaxCells = 1000;
+
+/**
+ * Default constructor
+ */
+AliEmcalClusterEtaPhiGrid::AliEmcalClusterEtaPhiGrid() :
+  fNClusters(0),
+  fMaxDistance(0),
+  fEtaMin(0),
+  fEtaCellSize(0),
+  fPhiCellSize(0),
+  fTolerance(0),
+  fNEta(0),
+  fNPhi(0),
+  fCellStart(),
+  fCellClusters(),
+  fAlwaysMatch()
+{
+}
+
+/**
+ * Cluster position in eta and phi, calculated in the same way as in
+ * AliAnalysisTaskEmcal::GetEtaPhiDiff, so that the grid sees the same
+ * values as the distance calculation.
+ * @param[in] cluster Cluster
+ * @param[out] eta Pseudorapidity of the cluster position
+ * @param[out] phi Azimuth of the cluster position
+ */
+void AliEmcalClusterEtaPhiGrid::GetClusterEtaPhi(const AliVCluster *cluster, Double_t &eta, Double_t &phi)
+{
+  Float_t pos[3] = {0};
+  cluster->GetPosition(pos);
+  TVector3 cpos(pos);
+  eta = cpos.Eta();
+  phi = cpos.Phi();
+}
+
+/**
+ * Sort the clusters of the event into the grid.
+ * @param[in] eta Cluster pseudorapidities, indexed by cluster id
+ * @param[in] phi Cluster azimuths, indexed by cluster id
+ * @param[in] maxDistance Maximum matching distance. For non-positive values no grid is built
+ * and all clusters are returned as candidates.
+ */
+void AliEmcalClusterEtaPhiGrid::Build(const std::vector<Double_t> &eta, const std::vector<Double_t> &phi, Double_t maxDistance)
+{
+  fNClusters = eta.size();
+  fMaxDistance = maxDistance;
+  fNEta = 0;
+  fNPhi = 0;
+  fCellStart.clear();
+  fCellClusters.clear();
+  fAlwaysMatch.clear();
+
+  if (!(maxDistance > 0) || !TMath::Finite(maxDistance)) return;
+
+  Double_t etaMin = 0, etaMax = 0;
+  Bool_t first = kTRUE;
+  for (Int_t icluster = 0; icluster < fNClusters; icluster++) {
+    if (!TMath::Finite(eta[icluster]) || !TMath::Finite(phi[icluster])) {
+      fAlwaysMatch.push_back(icluster);
+      continue;
+    }
+    if (first || eta[icluster] < etaMin) etaMin = eta[icluster];
+    if (first || eta[icluster] > etaMax) etaMax = eta[icluster];
+    first = kFALSE;
+  }
+
+  // Cell sizes are at least the maximum distance, so a track window spans
+  // at most three cells per dimension
+  const Double_t etaSpan = etaMax - etaMin;
+  fNEta = TMath::Max(1, static_cast<Int_t>(TMath::Min(etaSpan / maxDistance, Double_t(kMaxCells))));
+  fEtaCellSize = etaSpan > 0 ? etaSpan / fNEta : maxDistance;
+  fNPhi = TMath::Max(1, static_cast<Int_t>(TMath::Min(TMath::TwoPi() / maxDistance, Double_t(kMaxCells))));
+  fPhiCellSize = TMath::TwoPi() / fNPhi;
+  fEtaMin = etaMin;
+  fTolerance = 1e-6 * maxDistance + 1e-9 * (1. + TMath::Max(TMath::Abs(etaMin), TMath::Abs(etaMax)));
+
+  // Counting sort of the clusters into the cells, keeping the cluster order within each cell
+  const Int_t ncells = fNEta * fNPhi;
+  std::vector<Int_t> cellOfCluster(fNClusters, -1);
+  fCellStart.assign(ncells + 1, 0);
+  for (Int_t icluster = 0; icluster < fNClusters; icluster++) {
+    if (!TMath::Finite(eta[icluster]) || !TMath::Finite(phi[icluster])) continue;
+    cellOfCluster[icluster] = GetEtaCell(eta[icluster]) * fNPhi + GetPhiCell(NormalisePhi(phi[icluster]));
+    fCellStart[cellOfCluster[icluster] + 1]++;
+  }
+  for (Int_t icell = 0; icell < ncells; icell++) fCellStart[icell + 1] += fCellStart[icell];
+
+  fCellClusters.resize(fCellStart[ncells]);
+  std::vector<Int_t> fillPos(fCellStart.begin(), fCellStart.end() - 1);
+  for (Int_t icluster = 0; icluster < fNClusters; icluster++) {
+    if (cellOfCluster[icluster] < 0) continue;
+    fCellClusters[fillPos[cellOfCluster[icluster]]++] = icluster;
+  }
+}
+
+/**
+ * Find the clusters which may be within the maximum distance of a track.
+ * @param[in] eta Pseudorapidity of the track on the EMCal surface
+ * @param[in] phi Azimuth of the track on the EMCal surface
+ * @param[out] candidates Candidate cluster indices, in ascending order
+ */
+void AliEmcalClusterEtaPhiGrid::FindCandidates(Double_t eta, Double_t phi, std::vector<Int_t> &candidates) const
+{
+  candidates.clear();
+
+  if (fNEta <= 0 || !TMath::Finite(eta) || !TMath::Finite(phi)) {
+    for (Int_t icluster = 0; icluster < fNClusters; icluster++) candidates.push_back(icluster);
+    return;
+  }
+
+  candidates.insert(candidates.end(), fAlwaysMatch.begin(), fAlwaysMatch.end());
+
+  const Double_t window = fMaxDistance + fTolerance + 1e-9 * TMath::Abs(eta);
+
+  const Double_t etaLo = (eta - window - fEtaMin) / fEtaCellSize;
+  const Double_t etaHi = (eta + window - fEtaMin) / fEtaCellSize;
+  if (etaHi >= 0 && etaLo < fNEta + 1) {
+    const Int_t ietaLo = etaLo < 0 ? 0 : TMath::Min(fNEta - 1, static_cast<Int_t>(TMath::Floor(etaLo)));
+    const Int_t ietaHi = etaHi >= fNEta ? fNEta - 1 : static_cast<Int_t>(TMath::Floor(etaHi));
+
+    const Double_t phiNorm = NormalisePhi(phi);
+    const Double_t phiLo = TMath::Floor((phiNorm - window) / fPhiCellSize);
+    const Double_t phiHi = TMath::Floor((phiNorm + window) / fPhiCellSize);
+    Int_t iphiLo = 0, iphiHi = fNPhi - 1;
+    if (phiHi - phiLo + 1 < fNPhi) {
+      iphiLo = static_cast<Int_t>(phiLo);
+      iphiHi = static_cast<Int_t>(phiHi);
+    }
+
+    for (Int_t ieta = ietaLo; ieta <= ietaHi; ieta++) {
+      for (Int_t iphi = iphiLo; iphi <= iphiHi; iphi++) {
+        const Int_t icell = ieta * fNPhi + (iphi % fNPhi + fNPhi) % fNPhi;
+        candidates.insert(candidates.end(), fCellClusters.begin() + fCellStart[icell], fCellClusters.begin() + fCellStart[icell + 1]);
+      }
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+}
+
+/**
+ * Map the azimuth into [0, 2pi].
+ */
+Double_t AliEmcalClusterEtaPhiGrid::NormalisePhi(Double_t phi) const
+{
+  Double_t result = std::fmod(phi, TMath::TwoPi());
+  if (result < 0) result += TMath::TwoPi();
+  return result;
+}
+
+/**
+ * Eta cell of a cluster, clamped to the grid.
+ */
+Int_t AliEmcalClusterEtaPhiGrid::GetEtaCell(Double_t eta) const
+{
+  const Double_t cell = TMath::Floor((eta - fEtaMin) / fEtaCellSize);
+  if (cell < 0) return 0;
+  if (cell >= fNEta) return fNEta - 1;
+  return static_cast<Int_t>(cell);
+}
+
+/**
+ * Phi cell of a cluster (phi already normalised), clamped to the grid.
+ */
+Int_t AliEmcalClusterEtaPhiGrid::GetPhiCell(Double_t phi) const
+{
+  const Double_t cell = TMath::Floor(phi / fPhiCellSize);
+  if (cell < 0) return 0;
+  if (cell >= fNPhi) return fNPhi - 1;
+  return static_cast<Int_t>(cell);
+}
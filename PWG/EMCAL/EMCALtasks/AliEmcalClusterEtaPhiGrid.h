@@ -0,0 +1,65 @@
+#ifndef ALIEMCALCLUSTERETAPHIGRID_H
+#define ALIEMCALCLUSTERETAPHIGRID_H
+
+#include <vector>
+
+#include <Rtypes.h>
+
+class AliVCluster;
+
+/**
+ * @class AliEmcalClusterEtaPhiGrid
+ * @ingroup EMCALCOREFW
+ * @brief Eta-phi cell grid used to preselect clusters in the cluster-track matching
+ *
+ * Clusters are sorted once per event into cells in eta and phi with a cell size
+ * of about the maximum matching distance. For a given track only clusters in the
+ * cells overlapping the window of +- maximum distance around the track position
+ * on the EMCal surface are returned as candidates. The window is slightly enlarged
+ * to be safe against rounding, so the candidates always contain all clusters
+ * within the maximum distance; the actual distance cut is left to the caller.
+ *
+ * Candidates are returned in ascending cluster index, so that looping over them
+ * visits the clusters in the same order as a loop over all clusters. Clusters or
+ * tracks with non-finite positions fall back to the full cluster list.
+ *
+ * Used by AliEmcalClusTrackMatcherTask and AliEmcalCorrectionClusterTrackMatcher.
+ */
+class AliEmcalClusterEtaPhiGrid {
+ public:
+  AliEmcalClusterEtaPhiGrid();
+  virtual ~AliEmcalClusterEtaPhiGrid() {}
+
+  void          Build(const std::vector<Double_t> &eta, const std::vector<Double_t> &phi, Double_t maxDistance);
+  void          FindCandidates(Double_t eta, Double_t phi, std::vector<Int_t> &candidates) const;
+  Int_t         GetNClusters() const      { return fNClusters; }
+  Int_t         GetNEtaCells() const      { return fNEta; }
+  Int_t         GetNPhiCells() const      { return fNPhi; }
+
+  static void   GetClusterEtaPhi(const AliVCluster *cluster, Double_t &eta, Double_t &phi);
+
+ protected:
+  Double_t      NormalisePhi(Double_t phi) const;
+  Int_t         GetEtaCell(Double_t eta) const;
+  Int_t         GetPhiCell(Double_t phi) const;
+
+  static const Int_t kMaxCells;          ///< maximum number of cells per dimension
+
+  Int_t                 fNClusters;      ///< number of clusters in the grid
+  Double_t              fMaxDistance;    ///< maximum matching distance the grid was built for
+  Double_t              fEtaMin;         ///< lower edge of the eta range
+  Double_t              fEtaCellSize;    ///< cell size in eta
+  Double_t              fPhiCellSize;    ///< cell size in phi
+  Double_t              fTolerance;      ///< window enlargement protecting against rounding
+  Int_t                 fNEta;           ///< number of cells in eta
+  Int_t                 fNPhi;           ///< number of cells in phi
+  std::vector<Int_t>    fCellStart;      ///< offset of each cell in fCellClusters (size fNEta*fNPhi+1)
+  std::vector<Int_t>    fCellClusters;   ///< cluster indices sorted by cell, ascending within a cell
+  std::vector<Int_t>    fAlwaysMatch;    ///< clusters with non-finite position, candidates for every track
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalClusterEtaPhiGrid, 1); // Eta-phi cell grid of clusters for track matching
+  /// \endcond
+};
+
+#endif /* ALIEMCALCLUSTERETAPHIGRID_H */
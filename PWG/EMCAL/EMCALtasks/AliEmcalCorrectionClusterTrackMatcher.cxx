@@ -3,6 +3,8 @@
 
 #include "AliEmcalCorrectionClusterTrackMatcher.h"
 
+#include <algorithm>
+
 #include <TH1.h>
 #include <TList.h>
 
@@ -37,12 +39,15 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fUseDCA(kTRUE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseGridMatching(kTRUE),
+  fCrossCheckGridMatching(kFALSE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
   fEmcalTracks(0),
   fEmcalClusters(0),
   fNEmcalTracks(0),
   fNEmcalClusters(0),
+  fClusterGrid(),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0),
   fNMCGenerToAccept(0),
@@ -80,6 +85,8 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::Initialize()
   GetProperty("maxDist", fMaxDistance);
   GetProperty("updateClusters", fUpdateClusters);
   GetProperty("updateTracks", fUpdateTracks);
+  GetProperty("useGridMatching", fUseGridMatching);
+  GetProperty("crossCheckGridMatching", fCrossCheckGridMatching);
   fDoPropagation = fEsdMode;
   
   Bool_t enableFracEMCRecalc = kFALSE;
@@ -368,11 +375,26 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  // Clusters are visited in ascending order for each track, also when preselected
+  // by the eta-phi grid, so that the matching result is independent of the mode.
+  if (fUseGridMatching) {
+    std::vector<Double_t> clusEta(fNEmcalClusters), clusPhi(fNEmcalClusters);
+    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+      AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+      AliEmcalClusterEtaPhiGrid::GetClusterEtaPhi(emcalCluster->GetCluster(), clusEta[icluster], clusPhi[icluster]);
+    }
+    fClusterGrid.Build(clusEta, clusPhi, fMaxDistance);
+  }
+
+  std::vector<Int_t> candidates;
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    FindCandidateClusters(track, candidates);
+    if (fUseGridMatching && fCrossCheckGridMatching) CrossCheckCandidates(itrack, track, candidates);
+
+    for (auto icluster : candidates) {
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
       
@@ -409,6 +431,44 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
   }
 }
 
+/**
+ * Get the clusters to be tested against the track, in ascending order.
+ * Without the grid all clusters are candidates.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::FindCandidateClusters(AliVTrack *track, std::vector<Int_t> &candidates) const
+{
+  if (fUseGridMatching) {
+    fClusterGrid.FindCandidates(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), candidates);
+    return;
+  }
+
+  candidates.resize(fNEmcalClusters);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) candidates[icluster] = icluster;
+}
+
+/**
+ * Test all clusters which were not preselected by the grid.
+ * Any of them passing the distance cut is a match lost by the grid.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::CrossCheckCandidates(Int_t itrack, AliVTrack *track, const std::vector<Int_t> &candidates)
+{
+  const Double_t maxd2 = fMaxDistance*fMaxDistance;
+
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    if (std::binary_search(candidates.begin(), candidates.end(), icluster)) continue;
+
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    Double_t deta = 999;
+    Double_t dphi = 999;
+    GetEtaPhiDiff(track, emcalCluster->GetCluster(), dphi, deta);
+    Double_t d2 = deta * deta + dphi * dphi;
+    if (d2 > maxd2) continue;
+
+    AliError(Form("Grid matching lost match of track %d (eta = %.4f, phi = %.4f on EMCal) with cluster %d (eta = %.4f, phi = %.4f), d = %.4f",
+                  itrack, track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), icluster, emcalCluster->Eta(), emcalCluster->Phi(), TMath::Sqrt(d2)));
+  }
+}
+
 /**
  * Update clusters with matching info.
  */
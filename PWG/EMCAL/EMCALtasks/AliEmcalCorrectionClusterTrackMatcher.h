@@ -1,7 +1,10 @@
 #ifndef ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
+#include "AliEmcalClusterEtaPhiGrid.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 #include "AliEmcalContainerIndexMap.h"
@@ -44,6 +47,8 @@ class AliVParticle;
  AliVCluster *cluster = GetClusterContainer(0)->GetCluster(iCluster);
  ~~~
  (again assuming that the task is derived from AliAnalysisTaskEmcal or AliAnalysisTaskEmcalJet).
+
+ By default (`useGridMatching: true`) clusters are sorted once per event into an eta-phi grid (AliEmcalClusterEtaPhiGrid) and each track is only compared to the clusters in the neighbouring cells, instead of to all clusters. The matches are identical to the ones obtained testing all clusters. Setting `crossCheckGridMatching: true` tests in addition all other clusters and reports any match lost by the grid.
  *
  * Based on code in AliEmcalClusTrackMatcherTask. 
  *
@@ -69,6 +74,8 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Int_t         GetMomBin(Double_t p) const;
   void          GenerateEmcalParticles();
   void          DoMatching();
+  void          FindCandidateClusters(AliVTrack *track, std::vector<Int_t> &candidates) const;
+  void          CrossCheckCandidates(Int_t itrack, AliVTrack *track, const std::vector<Int_t> &candidates);
   void          UpdateTracks();
   void          UpdateClusters();
   Bool_t        IsTrackInEmcalAcceptance(AliVParticle* part, Double_t edges=0.9) const;
@@ -87,6 +94,8 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Bool_t        fUseDCA;                ///< Use DCA as starting point for track propagation, rather than primary vertex
   Bool_t        fUpdateTracks;          ///< update tracks with matching info
   Bool_t        fUpdateClusters;        ///< update clusters with matching info
+  Bool_t        fUseGridMatching;       ///< preselect clusters using an eta-phi grid instead of testing all clusters
+  Bool_t        fCrossCheckGridMatching;///< check that the grid preselection does not lose matches found by testing all clusters
   
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   // Handle mapping between index and containers
@@ -98,6 +107,7 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TClonesArray *fEmcalClusters;         //!<!emcal clusters
   Int_t         fNEmcalTracks;          //!<!number of emcal tracks
   Int_t         fNEmcalClusters;        //!<!number of emcal clusters
+  AliEmcalClusterEtaPhiGrid fClusterGrid; //!<!eta-phi grid of emcal clusters
   TH1          *fHistMatchEtaAll;       //!<!deta distribution
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!<!deta distribution
@@ -115,7 +125,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 4); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
@@ -11,6 +11,7 @@
 #pragma link C++ class  AliEMCALClusterParams+;
 #pragma link C++ class  AliEmcalAodTrackFilterTask+;
 #pragma link C++ class  AliEmcalClusTrackMatcherTask+;
+#pragma link C++ class  AliEmcalClusterEtaPhiGrid+;
 #pragma link C++ class  AliEmcalClusterMaker+;
 #pragma link C++ class  AliEmcalCompatTask+;
 #pragma link C++ class  AliEmcalDebugTask+;
@@ -43,6 +43,7 @@
 
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowQvectors.h"
 #include "AliFlowAnalysisWithMixedHarmonics.h"
 
 class TH1;
@@ -231,6 +232,12 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
 
  Int_t nRefMult = anEvent->GetReferenceMultiplicity();
 
+ // Q_{m*n,k} and S_{p,k}: without particle weights they are taken from the RP Q-vectors cached in the event 
+ // (shared with the other flow methods running on the same event), otherwise they are accumulated below
+ // in harmonics of n*phi:
+ Bool_t bUseEventQvectors = !(fUsePhiWeights||fUsePtWeights||fUseEtaWeights) && fHarmonic > 0;
+ AliFlowQvectors weightedQvectors(6,3); // Q_{m*n,k} for m = 0,1,...,6 and k = 0,1,2,3
+
  // Start loop over data:
  for(Int_t i=0;i<nPrim;i++) 
  { 
@@ -256,23 +263,9 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
     {
      wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
     } 
-    // Calculate Re[Q_{m,k}] and Im[Q_{m,k}], (m = 1,2,3,4,5,6 and k = 0,1,2,3) for this event:
-    for(Int_t m=0;m<6;m++) 
-    {
-     for(Int_t k=0;k<4;k++) // to be improved (what is the maximum k that I need?)
-     {
-      (*fReQnk)(m,k)+=pow(wPhi*wPt*wEta,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQnk)(m,k)+=pow(wPhi*wPt*wEta,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
-    }
-    // Calculate partially S_{p,k} for this event (final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<4;p++) // to be improved (what is maximum p that I need?)
-    {
-     for(Int_t k=0;k<4;k++) // to be improved (what is maximum k that I need?)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta,k);
-     }
-    }    
+    // Accumulate Re[Q_{m,k}], Im[Q_{m,k}] and sum_i w_i^k (m = 1,2,3,4,5,6 and k = 0,1,2,3) for this event,
+    // stored in fReQnk, fImQnk and fSpk after the loop over data:
+    if(!bUseEventQvectors){weightedQvectors.Fill(n*dPhi,wPhi*wPt*wEta);}
    } // end of if(aftsTrack->InRPSelection())
    // POIs:
    if(fEvaluateDifferential3pCorrelator)
@@ -400,6 +393,25 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
     }
  } // end of for(Int_t i=0;i<nPrim;i++) 
 
+ // Store Re[Q_{m,k}], Im[Q_{m,k}] and partially S_{p,k} for this event (harmonics of the cached Q-vectors are in units of phi):
+ const AliFlowQvectors *qvectors = bUseEventQvectors ? anEvent->GetRPQvectors(6*fHarmonic,3) : &weightedQvectors;
+ Int_t hStep = bUseEventQvectors ? fHarmonic : 1;
+ for(Int_t m=0;m<6;m++) 
+ {
+  for(Int_t k=0;k<4;k++) // to be improved (what is the maximum k that I need?)
+  {
+   (*fReQnk)(m,k)+=qvectors->Re((m+1)*hStep,k); 
+   (*fImQnk)(m,k)+=qvectors->Im((m+1)*hStep,k); 
+  } 
+ }
+ for(Int_t p=0;p<4;p++) // to be improved (what is maximum p that I need?)
+ {
+  for(Int_t k=0;k<4;k++) // to be improved (what is maximum k that I need?)
+  {     
+   (*fSpk)(p,k)+=qvectors->Re(0,k);
+  }
+ }    
+
  // Calculate the final expressions for S_{p,k}:
  for(Int_t p=0;p<4;p++) // to be improved (what is maximum p that I need?)
  {
@@ -42,6 +42,7 @@
 #include "TCanvas.h"
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowQvectors.h"
 #include "AliFlowAnalysisWithQCumulants.h"
 #include "TArrayD.h"
 #include "TRandom.h"
@@ -379,6 +380,11 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
  AliFlowTrackSimple *aftsTrack = NULL;
  Int_t n = fHarmonic; // shortcut for the harmonic 
+ // Q_{m*n,k} and S_{p,k}: without phi, pt and eta weights they are taken from the RP Q-vectors cached 
+ // in the event (shared with the other flow methods running on the same event), otherwise they are
+ // accumulated below in harmonics of n*phi:
+ Bool_t bUseEventQvectors = !(fUsePhiWeights||fUsePtWeights||fUseEtaWeights) && fExactNoRPs <= 0 && n > 0;
+ AliFlowQvectors weightedQvectors(12,8); // Q_{m*n,k} for m = 0,1,...,12 and k = 0,1,...,8
  for(Int_t i=0;i<nPrim;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
@@ -409,23 +415,9 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     {
      wTrack = aftsTrack->Weight(); 
     }
-    // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
-    {
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
-    }
-    // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
-    {
-     for(Int_t k=0;k<9;k++)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
-     }
-    } 
+    // Accumulate Re[Q_{m*n,k}], Im[Q_{m*n,k}] and sum_i w_i^k for this event (m = 1,2,...,12, k = 0,1,...,8), 
+    // stored in fReQ, fImQ and fSpk after the loop over data:
+    if(!bUseEventQvectors){weightedQvectors.Fill(n*dPhi,wPhi*wPt*wEta*wTrack);}
     // Differential flow:
     if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
@@ -548,6 +540,25 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     }
  } // end of for(Int_t i=0;i<nPrim;i++) 
 
+ // Store Re[Q_{m*n,k}], Im[Q_{m*n,k}] and sum_i w_i^k for this event (harmonics of the cached Q-vectors are in units of phi):
+ const AliFlowQvectors *qvectors = bUseEventQvectors ? anEvent->GetRPQvectors(12*n,8,fUseTrackWeights) : &weightedQvectors;
+ Int_t hStep = bUseEventQvectors ? n : 1;
+ for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
+ {
+  for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+  {
+   (*fReQ)(m,k)+=qvectors->Re((m+1)*hStep,k); 
+   (*fImQ)(m,k)+=qvectors->Im((m+1)*hStep,k); 
+  } 
+ }
+ for(Int_t p=0;p<8;p++)
+ {
+  for(Int_t k=0;k<9;k++)
+  {     
+   (*fSpk)(p,k)+=qvectors->Re(0,k);
+  }
+ } 
+
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
  for(Int_t p=0;p<8;p++)
  {
@@ -0,0 +1,233 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowCorrelator.h"
+#include "AliFlowQvectors.h"
+#include "TMath.h"
+
+//********************************************************************
+// AliFlowCorrelator:                                                *
+// Generic multi-particle correlators from Q-vector components.      *
+// See header for details.                                           *
+//********************************************************************
+
+//________________________________________________________________________
+
+AliFlowCorrelator::AliFlowCorrelator():
+  fMaxHarmonic(0),
+  fMaxPower(0),
+  fQ(1,Complex(0.,0.)),
+  fCache(),
+  fKey()
+{
+  // default constructor
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelator::AliFlowCorrelator(Int_t maxHarmonic, Int_t maxPower):
+  fMaxHarmonic(0),
+  fMaxPower(0),
+  fQ(),
+  fCache(),
+  fKey()
+{
+  // constructor: harmonics 0,...,maxHarmonic and weight powers 0,...,maxPower
+  SetRanges(maxHarmonic,maxPower);
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelator::~AliFlowCorrelator()
+{
+  // destructor
+}
+
+//________________________________________________________________________
+
+void AliFlowCorrelator::SetRanges(Int_t maxHarmonic, Int_t maxPower)
+{
+  // set the highest harmonic and weight power, all components are reset
+  fMaxHarmonic = TMath::Max(maxHarmonic,0);
+  fMaxPower = TMath::Max(maxPower,0);
+  fQ.assign((fMaxHarmonic+1)*(fMaxPower+1),Complex(0.,0.));
+  ClearCache();
+}
+
+//________________________________________________________________________
+
+void AliFlowCorrelator::Reset()
+{
+  // set all components to zero, keeping the ranges
+  fQ.assign(fQ.size(),Complex(0.,0.));
+  ClearCache();
+}
+
+//________________________________________________________________________
+
+void AliFlowCorrelator::SetQ(Int_t h, Int_t p, Double_t re, Double_t im)
+{
+  // set Q_{h,p}, components outside of the table are ignored
+  if(h<0 || h>fMaxHarmonic || p<0 || p>fMaxPower) return;
+  fQ[h*(fMaxPower+1)+p] = Complex(re,im);
+  ClearCache();
+}
+
+//________________________________________________________________________
+
+void AliFlowCorrelator::SetQvectors(const AliFlowQvectors& qvectors)
+{
+  // Copy Q_{h,p} from qvectors. Components not covered by qvectors are set to zero.
+  const Int_t maxHarmonic = TMath::Min(fMaxHarmonic,qvectors.GetMaxHarmonic());
+  const Int_t maxPower = TMath::Min(fMaxPower,qvectors.GetMaxPower());
+  fQ.assign(fQ.size(),Complex(0.,0.));
+  for(Int_t h=0;h<=maxHarmonic;h++)
+  {
+   for(Int_t p=0;p<=maxPower;p++)
+   {
+    fQ[h*(fMaxPower+1)+p] = Complex(qvectors.Re(h,p),qvectors.Im(h,p));
+   }
+  }
+  ClearCache();
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelator::Complex AliFlowCorrelator::Correlator(Int_t n, const Int_t* h)
+{
+  // Generic n-particle correlator <exp[i(h[0]*phi1+...+h[n-1]*phin)]>. The result is
+  // kept until the Q-vector table changes, repeated requests are a map lookup.
+
+  if(n<1 || !h) return Complex(0.,0.);
+
+  fKey.assign(h,h+n);
+  std::map<std::vector<Int_t>,Complex>::const_iterator it = fCache.find(fKey);
+  if(it != fCache.end()) return it->second;
+
+  Complex c(0.,0.);
+  switch(n)
+  {
+   case 1: c = Compute<1>(h); break;
+   case 2: c = Compute<2>(h); break;
+   case 3: c = Compute<3>(h); break;
+   case 4: c = Compute<4>(h); break;
+   case 5: c = Compute<5>(h); break;
+   case 6: c = Compute<6>(h); break;
+   case 7: c = Compute<7>(h); break;
+   case 8: c = Compute<8>(h); break;
+   default:
+   {
+    std::vector<Int_t> harmonics(h,h+n);
+    c = Recursion(n,&harmonics[0]);
+   }
+  }
+  fCache.insert(std::make_pair(fKey,c));
+  return c;
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelator::Complex AliFlowCorrelator::Two(Int_t n1, Int_t n2)
+{
+  const Int_t h[2] = {n1,n2};
+  return Correlator(2,h);
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelator::Complex AliFlowCorrelator::Three(Int_t n1, Int_t n2, Int_t n3)
+{
+  const Int_t h[3] = {n1,n2,n3};
+  return Correlator(3,h);
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelator::Complex AliFlowCorrelator::Four(Int_t n1, Int_t n2, Int_t n3, Int_t n4)
+{
+  const Int_t h[4] = {n1,n2,n3,n4};
+  return Correlator(4,h);
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelator::Complex AliFlowCorrelator::Five(Int_t n1, Int_t n2, Int_t n3, Int_t n4, Int_t n5)
+{
+  const Int_t h[5] = {n1,n2,n3,n4,n5};
+  return Correlator(5,h);
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelator::Complex AliFlowCorrelator::Six(Int_t n1, Int_t n2, Int_t n3, Int_t n4, Int_t n5, Int_t n6)
+{
+  const Int_t h[6] = {n1,n2,n3,n4,n5,n6};
+  return Correlator(6,h);
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelator::Complex AliFlowCorrelator::Seven(Int_t n1, Int_t n2, Int_t n3, Int_t n4, Int_t n5, Int_t n6, Int_t n7)
+{
+  const Int_t h[7] = {n1,n2,n3,n4,n5,n6,n7};
+  return Correlator(7,h);
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelator::Complex AliFlowCorrelator::Eight(Int_t n1, Int_t n2, Int_t n3, Int_t n4, Int_t n5, Int_t n6, Int_t n7, Int_t n8)
+{
+  const Int_t h[8] = {n1,n2,n3,n4,n5,n6,n7,n8};
+  return Correlator(8,h);
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelator::Complex AliFlowCorrelator::Recursion(Int_t n, Int_t* h, Int_t mult, Int_t skip) const
+{
+  // Calculate multi-particle correlators by using recursion (an improved faster version) originally developed by
+  // Kristjan Gulbrandsen (gulbrand@nbi.dk). The harmonics are permuted while recursing and restored on return.
+
+  const Int_t nm1 = n-1;
+  Complex c(Q(h[nm1],mult));
+  if(nm1 == 0) return c;
+  c *= Recursion(nm1,h);
+  if(nm1 == skip) return c;
+
+  const Int_t multp1 = mult+1;
+  const Int_t nm2 = n-2;
+  Int_t counter1 = 0;
+  Int_t hhold = h[counter1];
+  h[counter1] = h[nm2];
+  h[nm2] = hhold + h[nm1];
+  Complex c2(Recursion(nm1,h,multp1,nm2));
+  Int_t counter2 = n-3;
+  while(counter2 >= skip)
+  {
+   h[nm2] = h[counter1];
+   h[counter1] = hhold;
+   ++counter1;
+   hhold = h[counter1];
+   h[counter1] = h[nm2];
+   h[nm2] = hhold + h[nm1];
+   c2 += Recursion(nm1,h,multp1,counter2);
+   --counter2;
+  }
+  h[nm2] = h[counter1];
+  h[counter1] = hhold;
+
+  if(mult == 1) return c-c2;
+  return c-Double_t(mult)*c2;
+}
@@ -0,0 +1,167 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWCORRELATOR_H
+#define ALIFLOWCORRELATOR_H
+
+#include <complex>
+#include <map>
+#include <vector>
+#include "Rtypes.h"
+
+//********************************************************************
+// AliFlowCorrelator:                                                *
+// Generic multi-particle correlators                                *
+// <exp[i(n1*phi1+...+nk*phik)]> (numerators, i.e. sums over all     *
+// distinct k-tuples) from a table of Q-vector components            *
+// Q_{h,p} = sum_i w_i^p exp(i*h*phi_i), evaluated with the          *
+// recursion of Kristjan Gulbrandsen (gulbrand@nbi.dk).              *
+// Arithmetic is done with std::complex<double>. The recursion is    *
+// unrolled at compile time for up to 8 particles, with closed       *
+// forms for 2 and 4 particles; longer correlators fall back to the  *
+// run-time recursion. Results of Correlator() are memoized until    *
+// the Q-vector table changes, so that e.g. the event weights        *
+// <exp[i(0*phi1+...+0*phik)]> are evaluated only once per event.    *
+//                                                                   *
+// Usage:                                                            *
+//   AliFlowCorrelator corr(6*8,8);                                  *
+//   corr.SetQvectors(*event->GetRPQvectors(6*8,8));                 *
+//   Int_t h[4] = {2,2,-2,-2};                                       *
+//   AliFlowCorrelator::Complex four = corr.Correlator(4,h);         *
+//********************************************************************
+
+class AliFlowQvectors;
+
+class AliFlowCorrelator {
+ public:
+  typedef std::complex<Double_t> Complex;
+
+  AliFlowCorrelator();
+  AliFlowCorrelator(Int_t maxHarmonic, Int_t maxPower);
+  virtual ~AliFlowCorrelator();
+
+  void SetRanges(Int_t maxHarmonic, Int_t maxPower);              // set the ranges and reset
+  void Reset();                                                   // set all Q_{h,p} to zero
+  void SetQ(Int_t h, Int_t p, Double_t re, Double_t im);          // set Q_{h,p}, 0 <= h <= maxHarmonic
+  void SetQvectors(const AliFlowQvectors& qvectors);              // copy the overlapping range of qvectors
+
+  Int_t GetMaxHarmonic() const {return fMaxHarmonic;}
+  Int_t GetMaxPower() const {return fMaxPower;}
+
+  // Q_{h,p}, using Q_{-h,p} = Q_{h,p}^*, zero outside of the table
+  Complex Q(Int_t h, Int_t p) const
+  {
+   const Int_t absh = h<0 ? -h : h;
+   if(absh>fMaxHarmonic || p<0 || p>fMaxPower) return Complex(0.,0.);
+   const Complex &q = fQ[absh*(fMaxPower+1)+p];
+   return h<0 ? std::conj(q) : q;
+  }
+
+  // n-particle correlator for harmonics h[0],...,h[n-1], memoized
+  Complex Correlator(Int_t n, const Int_t* h);
+  Complex Two(Int_t n1, Int_t n2);
+  Complex Three(Int_t n1, Int_t n2, Int_t n3);
+  Complex Four(Int_t n1, Int_t n2, Int_t n3, Int_t n4);
+  Complex Five(Int_t n1, Int_t n2, Int_t n3, Int_t n4, Int_t n5);
+  Complex Six(Int_t n1, Int_t n2, Int_t n3, Int_t n4, Int_t n5, Int_t n6);
+  Complex Seven(Int_t n1, Int_t n2, Int_t n3, Int_t n4, Int_t n5, Int_t n6, Int_t n7);
+  Complex Eight(Int_t n1, Int_t n2, Int_t n3, Int_t n4, Int_t n5, Int_t n6, Int_t n7, Int_t n8);
+
+  // N-particle correlator with N fixed at compile time, not memoized
+  template<Int_t N> Complex Compute(const Int_t* h) const;
+
+  // Recursion for any n, mult and skip (see Gulbrandsen), harmonics are restored on return
+  Complex Recursion(Int_t n, Int_t* h, Int_t mult=1, Int_t skip=0) const;
+
+ private:
+  template<Int_t N> Complex Rec(Int_t* h, Int_t mult, Int_t skip) const;
+  void ClearCache() {if(!fCache.empty()) fCache.clear();}
+
+  Int_t fMaxHarmonic;                 // highest harmonic in the table
+  Int_t fMaxPower;                    // highest weight power in the table
+  std::vector<Complex> fQ;            // Q_{h,p} at h*(fMaxPower+1)+p
+  std::map<std::vector<Int_t>,Complex> fCache; // correlators evaluated for the current table, keyed by harmonics
+  std::vector<Int_t> fKey;            // lookup key, reused to avoid allocations
+};
+
+//________________________________________________________________________
+
+template<> inline AliFlowCorrelator::Complex AliFlowCorrelator::Rec<1>(Int_t* h, Int_t mult, Int_t /*skip*/) const
+{
+  return Q(h[0],mult);
+}
+
+//________________________________________________________________________
+
+template<Int_t N> inline AliFlowCorrelator::Complex AliFlowCorrelator::Rec(Int_t* h, Int_t mult, Int_t skip) const
+{
+  // Gulbrandsen's recursion with the number of particles as template parameter,
+  // identical to Recursion() but without run-time checks on n
+  const Int_t nm1 = N-1;
+  Complex c(Q(h[nm1],mult));
+  c *= Rec<N-1>(h,1,0);
+  if(nm1 == skip) return c;
+
+  const Int_t multp1 = mult+1;
+  const Int_t nm2 = N-2;
+  Int_t counter1 = 0;
+  Int_t hhold = h[counter1];
+  h[counter1] = h[nm2];
+  h[nm2] = hhold + h[nm1];
+  Complex c2(Rec<N-1>(h,multp1,nm2));
+  Int_t counter2 = N-3;
+  while(counter2 >= skip)
+  {
+   h[nm2] = h[counter1];
+   h[counter1] = hhold;
+   ++counter1;
+   hhold = h[counter1];
+   h[counter1] = h[nm2];
+   h[nm2] = hhold + h[nm1];
+   c2 += Rec<N-1>(h,multp1,counter2);
+   --counter2;
+  }
+  h[nm2] = h[counter1];
+  h[counter1] = hhold;
+
+  if(mult == 1) return c-c2;
+  return c-Double_t(mult)*c2;
+}
+
+//________________________________________________________________________
+
+template<Int_t N> inline AliFlowCorrelator::Complex AliFlowCorrelator::Compute(const Int_t* h) const
+{
+  Int_t harmonics[N];
+  for(Int_t i=0;i<N;i++){harmonics[i] = h[i];}
+  return Rec<N>(harmonics,1,0);
+}
+
+//________________________________________________________________________
+
+template<> inline AliFlowCorrelator::Complex AliFlowCorrelator::Compute<1>(const Int_t* h) const
+{
+  return Q(h[0],1);
+}
+
+//________________________________________________________________________
+
+template<> inline AliFlowCorrelator::Complex AliFlowCorrelator::Compute<2>(const Int_t* h) const
+{
+  return Q(h[0],1)*Q(h[1],1)-Q(h[0]+h[1],2);
+}
+
+//________________________________________________________________________
+
+template<> inline AliFlowCorrelator::Complex AliFlowCorrelator::Compute<4>(const Int_t* h) const
+{
+  const Int_t n1 = h[0], n2 = h[1], n3 = h[2], n4 = h[3];
+  return Q(n1,1)*Q(n2,1)*Q(n3,1)*Q(n4,1)-Q(n1+n2,2)*Q(n3,1)*Q(n4,1)-Q(n2,1)*Q(n1+n3,2)*Q(n4,1)
+       - Q(n1,1)*Q(n2+n3,2)*Q(n4,1)+2.*Q(n1+n2+n3,3)*Q(n4,1)-Q(n2,1)*Q(n3,1)*Q(n1+n4,2)
+       + Q(n2+n3,2)*Q(n1+n4,2)-Q(n1,1)*Q(n3,1)*Q(n2+n4,2)+Q(n1+n3,2)*Q(n2+n4,2)
+       + 2.*Q(n3,1)*Q(n1+n2+n4,3)-Q(n1,1)*Q(n2,1)*Q(n3+n4,2)+Q(n1+n2,2)*Q(n3+n4,2)
+       + 2.*Q(n2,1)*Q(n1+n3+n4,3)+2.*Q(n1,1)*Q(n2+n3+n4,3)-6.*Q(n1+n2+n3+n4,4);
+}
+
+#endif
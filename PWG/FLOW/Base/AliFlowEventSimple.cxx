@@ -39,6 +39,7 @@
 #include "TParameter.h"
 #include "TBrowser.h"
 #include "AliFlowVector.h"
+#include "AliFlowQvectors.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowTrackSimpleCuts.h"
 #include "AliFlowEventSimple.h"
@@ -75,6 +76,9 @@ AliFlowEventSimple::AliFlowEventSimple():
   fShuffledIndexes(NULL),
   fShuffleTracks(kFALSE),
   fMothersCollection(NULL),
+  fRPQvectors(NULL),
+  fRPQvectorsValid(kFALSE),
+  fRPQvectorsTrackWeights(kFALSE),
   fCentrality(-1.),
   fCentralityCL1(-1.),
   fNITSCL1(-1.),
@@ -134,6 +138,9 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fShuffledIndexes(NULL),
   fShuffleTracks(kFALSE),
   fMothersCollection(new TObjArray()),
+  fRPQvectors(NULL),
+  fRPQvectorsValid(kFALSE),
+  fRPQvectorsTrackWeights(kFALSE),
   fCentrality(-1.),
   fCentralityCL1(-1.),
   fNITSCL1(-1.),
@@ -195,6 +202,9 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fShuffledIndexes(NULL),
   fShuffleTracks(anEvent.fShuffleTracks),
   fMothersCollection(new TObjArray()),
+  fRPQvectors(NULL),
+  fRPQvectorsValid(kFALSE),
+  fRPQvectorsTrackWeights(kFALSE),
   fCentrality(anEvent.fCentrality),
   fCentralityCL1(anEvent.fCentralityCL1),
   fNITSCL1(anEvent.fNITSCL1),
@@ -241,6 +251,7 @@ void AliFlowEventSimple::SetNumberOfPOIs( Int_t numberOfPOIs, Int_t poiType)
   }
 
   fNumberOfPOIs[poiType] = numberOfPOIs;
+  fRPQvectorsValid = kFALSE;
 }
 
 //-----------------------------------------------------------------------
@@ -249,6 +260,7 @@ void AliFlowEventSimple::IncrementNumberOfPOIs(Int_t poiType)
 
   if (poiType>=fNumberOfPOItypes) SetNumberOfPOIs(0,poiType);
   fNumberOfPOIs[poiType]++;
+  fRPQvectorsValid = kFALSE;
 }
 
 //-----------------------------------------------------------------------
@@ -306,6 +318,7 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
     fV0A[i] = anEvent.fV0A[i];
   }
   delete [] fShuffledIndexes;
+  fRPQvectorsValid = kFALSE;
   return *this;
 }
 
@@ -321,6 +334,7 @@ AliFlowEventSimple::~AliFlowEventSimple()
   delete fMCReactionPlaneAngleWrap;
   delete fShuffledIndexes;
   delete fMothersCollection;
+  delete fRPQvectors;
   delete [] fNumberOfPOIs;
 }
 
@@ -467,6 +481,7 @@ void AliFlowEventSimple::TrackAdded()
 {
   //book keeping after a new track has been added
   fNumberOfTracks++;
+  fRPQvectorsValid = kFALSE;
   if (fShuffledIndexes)
   {
     delete [] fShuffledIndexes;
@@ -485,6 +500,28 @@ AliFlowTrackSimple* AliFlowEventSimple::MakeNewTrack()
    return t;
 }
 
+//-----------------------------------------------------------------------
+const AliFlowQvectors* AliFlowEventSimple::GetRPQvectors( Int_t maxHarmonic,
+                                                          Int_t maxPower,
+                                                          Bool_t useTrackWeights )
+{
+  //Q-vector components Q_{h,p} of the RPs for h=0..maxHarmonic and p=0..maxPower,
+  //with unit weights or with the track weights.
+  //The result is cached until the tracks or their tags change, such that all flow
+  //methods running on this event share it; the cache keeps the largest ranges requested
+  //so far. If the tracks are modified directly, call InvalidateQvectors().
+  if (!fRPQvectors) fRPQvectors = new AliFlowQvectors(maxHarmonic,maxPower);
+  if (fRPQvectorsValid && fRPQvectorsTrackWeights==useTrackWeights &&
+      fRPQvectors->Covers(maxHarmonic,maxPower)) return fRPQvectors;
+
+  fRPQvectors->SetRanges(TMath::Max(maxHarmonic,fRPQvectors->GetMaxHarmonic()),
+                         TMath::Max(maxPower,fRPQvectors->GetMaxPower()));
+  fRPQvectors->FillRPs(this,useTrackWeights);
+  fRPQvectorsTrackWeights = useTrackWeights;
+  fRPQvectorsValid = kTRUE;
+  return fRPQvectors;
+}
+
 //-----------------------------------------------------------------------
 AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
                                         TList *weightsList,
@@ -881,6 +918,9 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fShuffledIndexes(NULL),
   fShuffleTracks(kFALSE),
   fMothersCollection(new TObjArray()),
+  fRPQvectors(NULL),
+  fRPQvectorsValid(kFALSE),
+  fRPQvectorsTrackWeights(kFALSE),
   fCentrality(-1.),
   fCentralityCL1(-1.),
   fNITSCL1(-1.),
@@ -1173,6 +1213,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
     }
     track->SetForRPSelection(pass);
   }
+  fRPQvectorsValid = kFALSE;
 }
 
 //_____________________________________________________________________________
@@ -1195,6 +1236,7 @@ void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiTy
     }
     track->Tag(poiType,pass);
   }
+  fRPQvectorsValid = kFALSE;
 }
 
 //_____________________________________________________________________________
@@ -1227,6 +1269,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
       track->ResetPOItype();
     }
   }
+  fRPQvectorsValid = kFALSE;
 }
 
 //_____________________________________________________________________________
@@ -1244,6 +1287,7 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
   fTrackCollection->Compress(); //clean up empty slots
   fNumberOfTracks-=ncleaned; //update number of tracks
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  fRPQvectorsValid = kFALSE;
   return ncleaned;
 }
 
@@ -1283,4 +1327,5 @@ void AliFlowEventSimple::ClearFast()
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  fRPQvectorsValid = kFALSE;
 }
@@ -25,6 +25,7 @@ class TF1;
 class TF2;
 class AliFlowTrackSimple;
 class AliFlowTrackSimpleCuts;
+class AliFlowQvectors;
 
 class AliFlowEventSimple: public TObject {
 
@@ -82,7 +83,7 @@ class AliFlowEventSimple: public TObject {
   Bool_t   IsSetMCReactionPlaneAngle() const        { return fMCReactionPlaneAngleIsSet; }
   void     SetAfterBurnerPrecision(Double_t p)      { fAfterBurnerPrecision=p; }
   Double_t GetAfterBurnerPrecision() const          { return fAfterBurnerPrecision; }
-  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; }
+  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; fRPQvectorsValid=kFALSE; }
   Bool_t   IsUserModified() const                   { return fUserModified; }
   void     SetShuffleTracks(Bool_t b)               {fShuffleTracks=b;}
   void     ShuffleTracks();
@@ -117,6 +118,9 @@ class AliFlowEventSimple: public TObject {
   void TrackAdded();
   AliFlowTrackSimple* MakeNewTrack();
 
+  const AliFlowQvectors* GetRPQvectors(Int_t maxHarmonic, Int_t maxPower, Bool_t useTrackWeights=kFALSE);
+  void InvalidateQvectors() { fRPQvectorsValid = kFALSE; }
+
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void GetZDC2Qsub(AliFlowVector* Qarray);
@@ -186,6 +190,9 @@ class AliFlowEventSimple: public TObject {
   Int_t*                  fShuffledIndexes;           //! placeholder for randomized indexes
   Bool_t                  fShuffleTracks;             // do we shuffle tracks on get?
   TObjArray*              fMothersCollection;         //!cache the particles with daughters
+  AliFlowQvectors*        fRPQvectors;                //! cache of the RP Q-vectors, see GetRPQvectors()
+  Bool_t                  fRPQvectorsValid;           //! is the cache up to date with the tracks?
+  Bool_t                  fRPQvectorsTrackWeights;    //! are the cached Q-vectors filled with the track weights?
   Double_t                fCentrality;                // centrality
   Double_t                fCentralityCL1;             // centrality (CL1)
   Double_t                fNITSCL1;                   // number of clusters in ITS layer 1
@@ -209,7 +216,7 @@ class AliFlowEventSimple: public TObject {
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
   Int_t*                  fNumberOfPOIs;          //[fNumberOfPOItypes] number of tracks that have passed the POI selection
 
-  ClassDef(AliFlowEventSimple,7)
+  ClassDef(AliFlowEventSimple,8)
 };
 
 #endif
@@ -0,0 +1,146 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowQvectors.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowTrackSimple.h"
+#include "TMath.h"
+
+//********************************************************************
+// AliFlowQvectors:                                                  *
+// Q-vector components Q_{h,p} for all harmonics and weight powers,  *
+// filled with trigonometric recurrences. See header for details.    *
+//********************************************************************
+
+ClassImp(AliFlowQvectors)
+
+//________________________________________________________________________
+
+AliFlowQvectors::AliFlowQvectors():
+  TObject(),
+  fMaxHarmonic(0),
+  fMaxPower(0),
+  fNumberOfParticles(0),
+  fRe(1,0.),
+  fIm(1,0.),
+  fWeightPowers(1,1.)
+{
+  // default constructor
+}
+
+//________________________________________________________________________
+
+AliFlowQvectors::AliFlowQvectors(Int_t maxHarmonic, Int_t maxPower):
+  TObject(),
+  fMaxHarmonic(0),
+  fMaxPower(0),
+  fNumberOfParticles(0),
+  fRe(),
+  fIm(),
+  fWeightPowers()
+{
+  // constructor: harmonics 0,...,maxHarmonic and weight powers 0,...,maxPower
+  SetRanges(maxHarmonic,maxPower);
+}
+
+//________________________________________________________________________
+
+AliFlowQvectors::~AliFlowQvectors()
+{
+  // destructor
+}
+
+//________________________________________________________________________
+
+void AliFlowQvectors::SetRanges(Int_t maxHarmonic, Int_t maxPower)
+{
+  // set the highest harmonic and weight power, all components are reset
+  fMaxHarmonic = TMath::Max(maxHarmonic,0);
+  fMaxPower = TMath::Max(maxPower,0);
+  fRe.assign((fMaxHarmonic+1)*(fMaxPower+1),0.);
+  fIm.assign((fMaxHarmonic+1)*(fMaxPower+1),0.);
+  fWeightPowers.assign(fMaxPower+1,1.);
+  fNumberOfParticles = 0;
+}
+
+//________________________________________________________________________
+
+void AliFlowQvectors::Reset()
+{
+  // reset all components, keeping the ranges
+  fRe.assign(fRe.size(),0.);
+  fIm.assign(fIm.size(),0.);
+  fNumberOfParticles = 0;
+}
+
+//________________________________________________________________________
+
+void AliFlowQvectors::Fill(Double_t phi, Double_t weight)
+{
+  // Add a particle with azimuthal angle phi and weight w to all Q_{h,p}.
+  // exp(i*h*phi) is obtained from exp(i*(h-1)*phi) by one complex multiplication
+  // with exp(i*phi), and w^p from w^(p-1), instead of calling cos, sin and pow
+  // for every harmonic and power.
+
+  const Int_t nPowers = fMaxPower+1;
+  fWeightPowers[0] = 1.;
+  for(Int_t p=1;p<nPowers;p++){fWeightPowers[p] = fWeightPowers[p-1]*weight;}
+
+  const Double_t cos1 = TMath::Cos(phi);
+  const Double_t sin1 = TMath::Sin(phi);
+  Double_t cosh = 1.; // cos(h*phi)
+  Double_t sinh = 0.; // sin(h*phi)
+  Double_t *re = &fRe[0];
+  Double_t *im = &fIm[0];
+  const Double_t *wp = &fWeightPowers[0];
+  for(Int_t h=0;h<=fMaxHarmonic;h++)
+  {
+   for(Int_t p=0;p<nPowers;p++)
+   {
+    re[p] += wp[p]*cosh;
+    im[p] += wp[p]*sinh;
+   }
+   re += nPowers;
+   im += nPowers;
+   const Double_t cosNext = cosh*cos1 - sinh*sin1;
+   sinh = sinh*cos1 + cosh*sin1;
+   cosh = cosNext;
+  }
+  fNumberOfParticles++;
+}
+
+//________________________________________________________________________
+
+void AliFlowQvectors::FillRPs(AliFlowEventSimple* anEvent, Bool_t useTrackWeights)
+{
+  // Add all reference particles of the event, with weight 1 or with the track weights
+  if(!anEvent) return;
+  const Int_t nTracks = anEvent->NumberOfTracks();
+  for(Int_t i=0;i<nTracks;i++)
+  {
+   AliFlowTrackSimple *track = anEvent->GetTrack(i);
+   if(!track || !track->InRPSelection()) continue;
+   Fill(track->Phi(),useTrackWeights ? track->Weight() : 1.);
+  }
+}
+
+//________________________________________________________________________
+
+TComplex AliFlowQvectors::Q(Int_t h, Int_t p) const
+{
+  // Q_{h,p}, using Q_{-h,p} = Q_{h,p}^* for negative harmonics
+  if(h>=0) return TComplex(Re(h,p),Im(h,p));
+  return TComplex(Re(-h,p),-Im(-h,p));
+}
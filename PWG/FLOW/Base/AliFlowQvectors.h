@@ -0,0 +1,59 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWQVECTORS_H
+#define ALIFLOWQVECTORS_H
+
+#include <vector>
+#include "TObject.h"
+#include "TComplex.h"
+
+//********************************************************************
+// AliFlowQvectors:                                                  *
+// Q-vector components Q_{h,p} = sum_i w_i^p exp(i*h*phi_i) for all *
+// harmonics h = 0,...,maxHarmonic and weight powers                 *
+// p = 0,...,maxPower of a set of particles.                         *
+// For each particle cos and sin are evaluated once, the higher      *
+// harmonics follow from complex multiplication and the weight       *
+// powers from repeated multiplication.                              *
+// The Q-vectors of the RPs of an event are cached by the event,     *
+// see AliFlowEventSimple::GetRPQvectors(), so that several flow     *
+// methods running on the same event share the per-track cost.       *
+//********************************************************************
+
+class AliFlowEventSimple;
+
+class AliFlowQvectors: public TObject {
+ public:
+  AliFlowQvectors();
+  AliFlowQvectors(Int_t maxHarmonic, Int_t maxPower);
+  virtual ~AliFlowQvectors();
+
+  void SetRanges(Int_t maxHarmonic, Int_t maxPower);              // set the ranges and reset
+  void Reset();                                                   // reset all components to zero
+  void Clear(Option_t* option="") {Reset(); TObject::Clear(option);}
+  void Fill(Double_t phi, Double_t weight=1.);                    // add one particle
+  void FillRPs(AliFlowEventSimple* anEvent, Bool_t useTrackWeights=kFALSE); // add the RPs of the event
+
+  Int_t GetMaxHarmonic() const {return fMaxHarmonic;}
+  Int_t GetMaxPower() const {return fMaxPower;}
+  Bool_t Covers(Int_t maxHarmonic, Int_t maxPower) const {return maxHarmonic<=fMaxHarmonic && maxPower<=fMaxPower;}
+  Int_t GetNumberOfParticles() const {return fNumberOfParticles;}
+
+  Double_t Re(Int_t h, Int_t p) const {return fRe[h*(fMaxPower+1)+p];}  // Re[Q_{h,p}], 0 <= h <= maxHarmonic
+  Double_t Im(Int_t h, Int_t p) const {return fIm[h*(fMaxPower+1)+p];}  // Im[Q_{h,p}], 0 <= h <= maxHarmonic
+  TComplex Q(Int_t h, Int_t p) const;                                    // Q_{h,p}, Q_{-h,p} = Q_{h,p}^*
+
+ private:
+  Int_t fMaxHarmonic;                 // highest harmonic
+  Int_t fMaxPower;                    // highest power of the particle weights
+  Int_t fNumberOfParticles;           // number of particles added
+  std::vector<Double_t> fRe;          // Re[Q_{h,p}] at h*(fMaxPower+1)+p
+  std::vector<Double_t> fIm;          // Im[Q_{h,p}] at h*(fMaxPower+1)+p
+  std::vector<Double_t> fWeightPowers; //! w^p of the particle being added
+
+  ClassDef(AliFlowQvectors, 1)
+};
+
+#endif
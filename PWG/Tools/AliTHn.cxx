@@ -53,7 +53,13 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fAxisMin(0),
+  fAxisMax(0),
+  fAxisEdges(0),
+  fNShadows(0),
+  fShadowValues(0),
+  fShadowSumw2(0)
 {
   // Constructor
 }
@@ -69,7 +75,13 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fAxisMin(0),
+  fAxisMax(0),
+  fAxisEdges(0),
+  fNShadows(0),
+  fShadowValues(0),
+  fShadowSumw2(0)
 {
   // Constructor
 
@@ -106,7 +118,13 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fAxisMin(0),
+  fAxisMax(0),
+  fAxisEdges(0),
+  fNShadows(0),
+  fShadowValues(0),
+  fShadowSumw2(0)
 {
   //
   // AliTHnT copy constructor
@@ -135,6 +153,11 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   delete[] fNbinsCache;
   delete[] fLastVars;
   delete[] fLastBins;
+  delete[] fAxisMin;
+  delete[] fAxisMax;
+  delete[] fAxisEdges;
+  
+  DeleteShadows();
 }
 
 template <class TemplateArray, typename TemplateType>
@@ -243,6 +266,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     return 1;
   
   AliCFContainer::Merge(list);
+  
+  ReduceShadows();
 
   TIterator* iter = list->MakeIterator();
   TObject* obj;
@@ -253,6 +278,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     AliTHnT* entry = dynamic_cast<AliTHnT*> (obj);
     if (entry == 0) 
       continue;
+    
+    entry->ReduceShadows();
 
     for (Int_t i=0; i<fNSteps; i++)
     {
@@ -261,8 +288,7 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 	if (!fValues[i])
 	  fValues[i] = new TemplateArray(fNBins);
       
-	for (Long64_t l = 0; l<fNBins; l++)
-	  fValues[i]->GetArray()[l] += entry->fValues[i]->GetArray()[l];
+	AliTHnStorage::AddArray(fValues[i], entry->fValues[i], fNBins);
       }
 
       if (entry->fSumw2[i])
@@ -270,8 +296,7 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 	if (!fSumw2[i])
 	  fSumw2[i] = new TemplateArray(fNBins);
       
-	for (Long64_t l = 0; l<fNBins; l++)
-	  fSumw2[i]->GetArray()[l] += entry->fSumw2[i]->GetArray()[l];
+	AliTHnStorage::AddArray(fSumw2[i], entry->fSumw2[i], fNBins);
       }
     }
     
@@ -288,25 +313,7 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 
   // fill axis cache
   if (!axisCache)
-  {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
-    
-    fLastVars = new Double_t[fNVars];
-    fLastBins = new Int_t[fNVars];
-    
-    // initial values to prevent checking for 0 below
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      fLastBins[i] = axisCache[i]->FindBin(var[i]);
-      fLastVars[i] = var[i];
-    }
-  }
+    InitAxisCache();
   
   // calculate global bin index
   Long64_t bin = 0;
@@ -350,9 +357,9 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
     }
   }
 
-  fValues[istep]->GetArray()[bin] += weight;
+  AliTHnStorage::Add(fValues[istep], bin, weight);
   if (fSumw2[istep])
-    fSumw2[istep]->GetArray()[bin] += weight * weight;
+    AliTHnStorage::Add(fSumw2[istep], bin, weight * weight);
   
 //   Printf("%f", fValues[istep][bin]);
   
@@ -360,6 +367,242 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::InitAxisCache()
+{
+  // fills the axis cache used by Fill and FillN
+  
+  delete[] axisCache;
+  delete[] fNbinsCache;
+  delete[] fLastVars;
+  delete[] fLastBins;
+  delete[] fAxisMin;
+  delete[] fAxisMax;
+  delete[] fAxisEdges;
+  
+  axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  fLastVars = new Double_t[fNVars];
+  fLastBins = new Int_t[fNVars];
+  fAxisMin = new Double_t[fNVars];
+  fAxisMax = new Double_t[fNVars];
+  fAxisEdges = new const Double_t*[fNVars];
+  
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
+    fAxisMin[i] = axisCache[i]->GetXmin();
+    fAxisMax[i] = axisCache[i]->GetXmax();
+    fAxisEdges[i] = (axisCache[i]->GetXbins()->GetSize() > 0) ? axisCache[i]->GetXbins()->GetArray() : 0;
+    
+    // initial values to prevent checking for 0 in Fill
+    fLastVars[i] = fAxisMin[i];
+    fLastBins[i] = axisCache[i]->FindBin(fLastVars[i]);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+Int_t AliTHnT<TemplateArray, TemplateType>::FindAxisBin(Int_t axis, Double_t x) const
+{
+  // same result as TAxis::FindBin (for non-extendable axes) without the virtual call
+  
+  if (x < fAxisMin[axis])
+    return 0;
+  if (!(x < fAxisMax[axis]))
+    return fNbinsCache[axis] + 1;
+  
+  const Double_t* edges = fAxisEdges[axis];
+  if (!edges)
+    return 1 + Int_t(fNbinsCache[axis] * (x - fAxisMin[axis]) / (fAxisMax[axis] - fAxisMin[axis]));
+  
+  // binary search for the last edge <= x (as TMath::BinarySearch)
+  Int_t low = 0;
+  Int_t high = fNbinsCache[axis];
+  while (high - low > 1)
+  {
+    Int_t middle = (low + high) / 2;
+    if (x < edges[middle])
+      high = middle;
+    else
+      low = middle;
+  }
+  return 1 + low;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillN(Int_t n, const Double_t *vars, Int_t istep, const Double_t *weights, Int_t shadow)
+{
+  // fills n entries. vars[i*fNVars + j] is the value of variable j for entry i, weights[i] its weight (1 if weights is 0)
+  // if shadow >= 0 the entries are filled in the per-thread containers of thread <shadow> (see CreateShadows)
+  //
+  // the global bin indices are calculated for a block of entries first (axis by axis), and then the block is added
+  // to the containers in the order of the entries, therefore the result is identical to n calls to Fill
+  
+  if (shadow >= fNShadows)
+  {
+    AliFatal(Form("Shadow %d requested but only %d were created", shadow, fNShadows));
+    return;
+  }
+  
+  if (!fAxisMin)
+    InitAxisCache();
+  
+  const Int_t kBlockSize = 256;
+  Long64_t bins[kBlockSize];
+  
+  for (Int_t offset=0; offset<n; offset+=kBlockSize)
+  {
+    const Int_t blockSize = TMath::Min(kBlockSize, n - offset);
+    const Double_t* blockVars = vars + (Long64_t) offset * fNVars;
+    
+    for (Int_t i=0; i<blockSize; i++)
+      bins[i] = 0;
+    
+    for (Int_t j=0; j<fNVars; j++)
+    {
+      const Int_t nBins = fNbinsCache[j];
+      for (Int_t i=0; i<blockSize; i++)
+      {
+        Int_t tmpBin = FindAxisBin(j, blockVars[i * fNVars + j]);
+        
+        // under/overflow not supported: flag entry with a negative index
+        if (bins[i] < 0 || tmpBin < 1 || tmpBin > nBins)
+          bins[i] = -1;
+        else
+          bins[i] = bins[i] * nBins + tmpBin - 1;
+      }
+    }
+    
+    const Double_t* blockWeights = (weights) ? weights + offset : 0;
+    
+    if (shadow < 0)
+      AddToStep(fValues[istep], fSumw2[istep], istep, blockSize, bins, blockWeights, kTRUE);
+    else
+      AddToStep(fShadowValues[shadow * fNSteps + istep], fShadowSumw2[shadow * fNSteps + istep], istep, blockSize, bins, blockWeights, kFALSE);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::AddToStep(TemplateArray*& values, TemplateArray*& sumw2, Int_t istep, Int_t n, const Long64_t* bins, const Double_t* weights, Bool_t verbose)
+{
+  // adds n entries with global bin indices <bins> (negative: skip) to the containers <values> and <sumw2>
+  // the containers are created following the same logic as in Fill
+  // verbose is off when called from a worker thread (AliLog is not thread safe)
+  
+  Bool_t anyEntry = kFALSE;
+  Bool_t anyWeight = kFALSE;
+  for (Int_t i=0; i<n; i++)
+  {
+    if (bins[i] < 0)
+      continue;
+    anyEntry = kTRUE;
+    if (weights && weights[i] != 1)
+      anyWeight = kTRUE;
+  }
+  
+  if (!anyEntry)
+    return;
+  
+  if (!values)
+  {
+    values = new TemplateArray(fNBins);
+    if (verbose)
+      AliInfo(Form("Created values container for step %d", istep));
+  }
+
+  // initialize with already filled entries (which have been filled with weight == 1), in this case fSumw2 := fValues
+  if (anyWeight && !sumw2)
+  {
+    sumw2 = new TemplateArray(*values);
+    if (verbose)
+      AliInfo(Form("Created sumw2 container for step %d", istep));
+  }
+  
+  for (Int_t i=0; i<n; i++)
+  {
+    if (bins[i] < 0)
+      continue;
+    
+    Double_t weight = (weights) ? weights[i] : 1;
+    AliTHnStorage::Add(values, bins[i], weight);
+    if (sumw2)
+      AliTHnStorage::Add(sumw2, bins[i], weight * weight);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::CreateShadows(Int_t nShadows)
+{
+  // creates <nShadows> per-thread shadow containers. Thread i can then call FillN(..., i) concurrently to the other threads.
+  // The shadows are added to the main containers by ReduceShadows() (called by Merge and FillContainer) after all threads are finished
+  
+  ReduceShadows();
+  DeleteShadows();
+  
+  // the axis cache is shared by all threads and therefore has to exist before filling starts
+  if (!fAxisMin)
+    InitAxisCache();
+  
+  fNShadows = nShadows;
+  fShadowValues = new TemplateArray*[fNShadows * fNSteps];
+  fShadowSumw2 = new TemplateArray*[fNShadows * fNSteps];
+  memset(fShadowValues, 0, fNShadows * fNSteps * sizeof(TemplateArray*));
+  memset(fShadowSumw2, 0, fNShadows * fNSteps * sizeof(TemplateArray*));
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::ReduceShadows()
+{
+  // adds the content of the per-thread shadow containers to the main containers and resets the shadows
+  
+  for (Int_t shadow=0; shadow<fNShadows; shadow++)
+  {
+    for (Int_t i=0; i<fNSteps; i++)
+    {
+      TemplateArray*& shadowValues = fShadowValues[shadow * fNSteps + i];
+      TemplateArray*& shadowSumw2 = fShadowSumw2[shadow * fNSteps + i];
+      
+      if (!shadowValues)
+        continue;
+      
+      if (!fValues[i])
+        fValues[i] = new TemplateArray(fNBins);
+      
+      // sumw2 is needed if either side has it. The side without sumw2 has been filled with weight 1 only and its sumw2 is equal to its values
+      if (shadowSumw2 && !fSumw2[i])
+        fSumw2[i] = new TemplateArray(*fValues[i]);
+      
+      AliTHnStorage::AddArray(fValues[i], shadowValues, fNBins);
+      if (fSumw2[i])
+        AliTHnStorage::AddArray(fSumw2[i], (shadowSumw2) ? shadowSumw2 : shadowValues, fNBins);
+      
+      delete shadowValues;
+      shadowValues = 0;
+      delete shadowSumw2;
+      shadowSumw2 = 0;
+    }
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::DeleteShadows()
+{
+  // deletes the per-thread shadow containers (without adding them to the main containers)
+  
+  for (Int_t i=0; i<fNShadows * fNSteps; i++)
+  {
+    delete fShadowValues[i];
+    delete fShadowSumw2[i];
+  }
+  
+  delete[] fShadowValues;
+  delete[] fShadowSumw2;
+  fShadowValues = 0;
+  fShadowSumw2 = 0;
+  fNShadows = 0;
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
@@ -382,61 +625,50 @@ void AliTHnT<TemplateArray, TemplateType>::FillContainer(AliCFContainer* cont)
 {
   // fills the information stored in the buffer in this class into the container <cont>
   
+  ReduceShadows();
+  
   for (Int_t i=0; i<fNSteps; i++)
   {
     if (!fValues[i])
       continue;
       
-    TemplateType* source = fValues[i]->GetArray();
+    const TemplateArray* source = fValues[i];
     // if fSumw2 is not stored, the sqrt of the number of bin entries in source is filled below; otherwise we use fSumw2
-    TemplateType* sourceSumw2 = source;
+    const TemplateArray* sourceSumw2 = source;
     if (fSumw2[i])
-      sourceSumw2 = fSumw2[i]->GetArray();
+      sourceSumw2 = fSumw2[i];
     
     THnSparse* target = cont->GetGrid(i)->GetGrid();
     
     Int_t* binIdx = new Int_t[fNVars];
     Int_t* nBins  = new Int_t[fNVars];
     for (Int_t j=0; j<fNVars; j++)
-    {
-      binIdx[j] = 1;
       nBins[j] = target->GetAxis(j)->GetNbins();
-    }
     
     Long64_t count = 0;
     
-    while (1)
+    // loop over the global bins (the last axis runs fastest), empty parts of a paged storage are skipped
+    for (Long64_t globalBin = AliTHnStorage::NextBin(source, 0); globalBin < fNBins; globalBin = AliTHnStorage::NextBin(source, globalBin + 1))
     {
-//       for (Int_t j=0; j<fNVars; j++)
-// 	printf("%d ", binIdx[j]);
-      
-      Long64_t globalBin = GetGlobalBinIndex(binIdx);
-//       Printf(" --> %lld", globalBin);
+      Double_t content = AliTHnStorage::Get(source, globalBin);
+      if (content == 0)
+        continue;
       
-      if (source[globalBin] != 0)
+      // TAxis bin indices from the global bin index
+      Long64_t remainder = globalBin;
+      for (Int_t j=fNVars-1; j>=0; j--)
       {
-	target->SetBinContent(binIdx, source[globalBin]);
-	target->SetBinError(binIdx, TMath::Sqrt(sourceSumw2[globalBin]));
-	
-	count++;
+        binIdx[j] = remainder % nBins[j] + 1;
+        remainder /= nBins[j];
       }
       
-      binIdx[fNVars-1]++;
-      
-      for (Int_t j=fNVars-1; j>0; j--)
-      {
-	if (binIdx[j] > nBins[j])
-	{
-	  binIdx[j] = 1;
-	  binIdx[j-1]++;
-	}
-      }
+      target->SetBinContent(binIdx, content);
+      target->SetBinError(binIdx, TMath::Sqrt(AliTHnStorage::Get(sourceSumw2, globalBin)));
       
-      if (binIdx[0] > nBins[0])
-	break;
+      count++;
     }
     
-    AliInfo(Form("Step %d: copied %lld entries out of %lld bins", i, count, GetGlobalBinIndex(binIdx)));
+    AliInfo(Form("Step %d: copied %lld entries out of %lld bins", i, count, fNBins));
 
     delete[] binIdx;
     delete[] nBins;
@@ -464,10 +696,8 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
     if (!fValues[i])
       continue;
       
-    TemplateType* source = fValues[i]->GetArray();
-    TemplateType* sourceSumw2 = 0;
-    if (fSumw2[i])
-      sourceSumw2 = fSumw2[i]->GetArray();
+    TemplateArray* source = fValues[i];
+    TemplateArray* sourceSumw2 = fSumw2[i];
     
     THnSparse* target = GetGrid(i)->GetGrid();
     
@@ -490,21 +720,21 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
       {
 	binIdx[axis] = j;
 	Long64_t globalBin = GetGlobalBinIndex(binIdx);
-	sumValues += source[globalBin];
-	source[globalBin] = 0;
+	sumValues += AliTHnStorage::Get(source, globalBin);
+	AliTHnStorage::Set(source, globalBin, 0);
 
 	if (sourceSumw2)
 	{
-	  sumSumw2 += sourceSumw2[globalBin];
-	  sourceSumw2[globalBin] = 0;
+	  sumSumw2 += AliTHnStorage::Get(sourceSumw2, globalBin);
+	  AliTHnStorage::Set(sourceSumw2, globalBin, 0);
 	}
       }
       binIdx[axis] = 1;
 	
       Long64_t globalBin = GetGlobalBinIndex(binIdx);
-      source[globalBin] = sumValues;
+      AliTHnStorage::Set(source, globalBin, sumValues);
       if (sourceSumw2)
-	sourceSumw2[globalBin] = sumSumw2;
+	AliTHnStorage::Set(sourceSumw2, globalBin, sumSumw2);
 
       count++;
 
@@ -533,3 +763,5 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
 
 template class AliTHnT<TArrayF, Float_t>;
 template class AliTHnT<TArrayD, Double_t>;
+template class AliTHnT<AliTHnPagedArrayF, Float_t>;
+template class AliTHnT<AliTHnPagedArrayD, Double_t>;
@@ -9,16 +9,41 @@
 // Use AliTHn instead of AliCFContainer and your memory consumption will be drastically reduced
 // As AliTHn derives from AliCFContainer, you can just replace your current AliCFContainer object by AliTHn
 // Once you have the merged output, call FillParent() and you can use AliCFContainer as usual
+// AliTHnPaged (AliTHnPagedD) only allocates the parts of the bin range which are filled (see AliTHnPagedArray)
 
 #include "TObject.h"
 #include "TString.h"
 #include "AliCFContainer.h"
+#include "TArrayF.h"
+#include "TArrayD.h"
+#include "AliTHnPagedArray.h"
 
-class TArray;
-class TArrayF;
-class TArrayD;
 class TCollection;
 
+// storage access used by AliTHnT, specialized for the dense (TArrayF, TArrayD) and the paged (AliTHnPagedArray) storage
+namespace AliTHnStorage
+{
+  template <class TemplateArray> inline Double_t Get(const TemplateArray* array, Long64_t bin) { return array->GetArray()[bin]; }
+  template <class TemplateArray> inline void Set(TemplateArray* array, Long64_t bin, Double_t value) { array->GetArray()[bin] = value; }
+  template <class TemplateArray> inline void Add(TemplateArray* array, Long64_t bin, Double_t weight) { array->GetArray()[bin] += weight; }
+  template <class TemplateArray> inline void AddArray(TemplateArray* target, const TemplateArray* source, Long64_t n) { for (Long64_t l = 0; l<n; l++) target->GetArray()[l] += source->GetArray()[l]; }
+  template <class TemplateArray> inline Long64_t NextBin(const TemplateArray*, Long64_t bin) { return bin; }
+  
+  template <typename TemplateType> inline Double_t Get(const AliTHnPagedArray<TemplateType>* array, Long64_t bin) { return array->Get(bin); }
+  template <typename TemplateType> inline void Set(AliTHnPagedArray<TemplateType>* array, Long64_t bin, Double_t value) { array->Set(bin, value); }
+  template <typename TemplateType> inline void Add(AliTHnPagedArray<TemplateType>* array, Long64_t bin, Double_t weight) { array->Add(bin, weight); }
+  template <typename TemplateType> inline void AddArray(AliTHnPagedArray<TemplateType>* target, const AliTHnPagedArray<TemplateType>* source, Long64_t) { target->Add(*source); }
+  template <typename TemplateType> inline Long64_t NextBin(const AliTHnPagedArray<TemplateType>* array, Long64_t bin) { return array->NextFilledPage(bin); }
+}
+
+// FillN() fills a block of n points at once (vars[i*nVars + j] is variable j of point i). The bin indices of the
+// whole block are computed first and then added to the storage in the order of the points, so the result is
+// identical to n calls of Fill().
+//
+// Several threads can fill the same object concurrently by calling CreateShadows(nThreads) beforehand and passing
+// the thread index as <shadow> to FillN(). Each thread then fills its own containers without locking. They are
+// added to the main containers by ReduceShadows(), which is called by Merge() and FillParent().
+
 class AliTHnBase : public AliCFContainer
 {
 public:
@@ -26,6 +51,7 @@ public:
   AliTHnBase(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn) : AliCFContainer(name, title, nSelStep, nVarIn, nBinIn) { }
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual void FillN(Int_t n, const Double_t *vars, Int_t istep, const Double_t *weights=0, Int_t shadow=-1) = 0;
   virtual void FillParent() = 0;
   virtual void FillContainer(AliCFContainer* cont) = 0;
 
@@ -48,6 +74,7 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void FillN(Int_t n, const Double_t *vars, Int_t istep, const Double_t *weights=0, Int_t shadow=-1);
   virtual void FillParent();
   virtual void FillContainer(AliCFContainer* cont);
   
@@ -57,6 +84,10 @@ class AliTHnT : public AliTHnBase
   virtual void DeleteContainers();
   virtual void ReduceAxis();
   
+  void CreateShadows(Int_t nShadows);
+  void ReduceShadows();
+  Int_t GetNShadows() const { return fNShadows; }
+  
   AliTHnT(const AliTHnT &c);
   AliTHnT& operator=(const AliTHnT& corr);
   virtual void Copy(TObject& c) const;
@@ -65,6 +96,10 @@ class AliTHnT : public AliTHnBase
   
 protected:
   void Init();
+  void InitAxisCache();
+  Int_t FindAxisBin(Int_t axis, Double_t x) const;
+  void AddToStep(TemplateArray*& values, TemplateArray*& sumw2, Int_t istep, Int_t n, const Long64_t* bins, const Double_t* weights, Bool_t verbose);
+  void DeleteShadows();
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
   
   Long64_t fNBins;   // number of total bins
@@ -77,11 +112,20 @@ protected:
   Int_t* fNbinsCache; //! cache Nbins per axis
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
+  Double_t* fAxisMin; //! cache lower edge per axis (for FillN)
+  Double_t* fAxisMax; //! cache upper edge per axis (for FillN)
+  const Double_t** fAxisEdges; //! cache bin edges per axis, 0 for equidistant binning (for FillN)
+  
+  Int_t fNShadows; //! number of per-thread shadow containers
+  TemplateArray** fShadowValues; //! [fNShadows*fNSteps] per-thread data containers, added to fValues by ReduceShadows()
+  TemplateArray** fShadowSumw2;  //! [fNShadows*fNSteps] per-thread data containers, added to fSumw2 by ReduceShadows()
   
   ClassDef(AliTHnT, 5) // THn like container
 };
 
 typedef AliTHnT<TArrayF, Float_t> AliTHn;
 typedef AliTHnT<TArrayD, Double_t> AliTHnD;
+typedef AliTHnT<AliTHnPagedArrayF, Float_t> AliTHnPaged;
+typedef AliTHnT<AliTHnPagedArrayD, Double_t> AliTHnPagedD;
 
 #endif
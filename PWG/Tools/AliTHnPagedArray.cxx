@@ -0,0 +1,330 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// paged storage for AliTHnT
+//
+// The bin range is split into pages of 4 KB. A page is only allocated when one of its bins is filled. Allocated
+// pages are stored contiguously in fData, fPageIds holds their page numbers. Only the allocated pages are written
+// to file. The page table (page number -> position in fData) is transient. It is built by the constructors, by Set()
+// and Reset(), and by the streamer after reading, so that the const accessors (Get, NextFilledPage) do not modify the
+// object and can be called from several threads.
+//
+// GetArray() returns a dense (read-only) copy of the content for code which needs the full array. The copy is created
+// on first use and is therefore not thread-safe.
+
+#include "AliTHnPagedArray.h"
+#include "AliLog.h"
+#include "TBuffer.h"
+#include "TMath.h"
+
+templateClassImp(AliTHnPagedArray)
+
+template <typename TemplateType>
+AliTHnPagedArray<TemplateType>::AliTHnPagedArray() :
+  TArray(),
+  fNUsedPages(0),
+  fPageIds(0),
+  fNData(0),
+  fData(0),
+  fNPages(0),
+  fPageTable(0),
+  fCapacity(0),
+  fDense(0)
+{
+  // Constructor
+  
+  BuildPageTable();
+}
+
+template <typename TemplateType>
+AliTHnPagedArray<TemplateType>::AliTHnPagedArray(Int_t n) :
+  TArray(n),
+  fNUsedPages(0),
+  fPageIds(0),
+  fNData(0),
+  fData(0),
+  fNPages(0),
+  fPageTable(0),
+  fCapacity(0),
+  fDense(0)
+{
+  // Constructor
+  
+  BuildPageTable();
+}
+
+template <typename TemplateType>
+AliTHnPagedArray<TemplateType>::AliTHnPagedArray(const AliTHnPagedArray &c) :
+  TArray(c),
+  fNUsedPages(0),
+  fPageIds(0),
+  fNData(0),
+  fData(0),
+  fNPages(0),
+  fPageTable(0),
+  fCapacity(0),
+  fDense(0)
+{
+  // copy constructor
+  
+  *this = c;
+}
+
+template <typename TemplateType>
+AliTHnPagedArray<TemplateType>& AliTHnPagedArray<TemplateType>::operator=(const AliTHnPagedArray &c)
+{
+  // assignment operator
+  
+  if (this == &c)
+    return *this;
+  
+  Reset();
+  fN = c.fN;
+  
+  fNUsedPages = c.fNUsedPages;
+  fNData = c.fNData;
+  fCapacity = c.fNUsedPages;
+  if (fNUsedPages > 0)
+  {
+    fPageIds = new Int_t[fNUsedPages];
+    memcpy(fPageIds, c.fPageIds, fNUsedPages * sizeof(Int_t));
+    fData = new TemplateType[fNData];
+    memcpy(fData, c.fData, fNData * sizeof(TemplateType));
+  }
+  BuildPageTable();
+  
+  return *this;
+}
+
+template <typename TemplateType>
+AliTHnPagedArray<TemplateType>::~AliTHnPagedArray()
+{
+  // Destructor
+  
+  delete[] fPageIds;
+  delete[] fData;
+  delete[] fPageTable;
+  delete[] fDense;
+}
+
+template <typename TemplateType>
+void AliTHnPagedArray<TemplateType>::Reset()
+{
+  // deletes all pages
+  
+  delete[] fPageIds;
+  delete[] fData;
+  delete[] fDense;
+  
+  fPageIds = 0;
+  fData = 0;
+  fDense = 0;
+  fNUsedPages = 0;
+  fNData = 0;
+  fCapacity = 0;
+  
+  BuildPageTable();
+}
+
+template <typename TemplateType>
+void AliTHnPagedArray<TemplateType>::Set(Int_t n)
+{
+  // sets the number of bins, the content is reset
+  
+  fN = n;
+  Reset();
+}
+
+template <typename TemplateType>
+void AliTHnPagedArray<TemplateType>::BuildPageTable()
+{
+  // builds the transient page table from fPageIds
+  
+  const Int_t pageSize = GetPageSize();
+  
+  delete[] fPageTable;
+  fNPages = (fN + pageSize - 1) / pageSize;
+  fPageTable = new Int_t[fNPages];
+  for (Int_t i=0; i<fNPages; i++)
+    fPageTable[i] = -1;
+  for (Int_t i=0; i<fNUsedPages; i++)
+    fPageTable[fPageIds[i]] = i;
+  
+  if (fCapacity < fNUsedPages)
+    fCapacity = fNUsedPages;
+}
+
+template <typename TemplateType>
+Int_t AliTHnPagedArray<TemplateType>::AllocatePage(Int_t page)
+{
+  // allocates a new (empty) page for page number <page> and returns its position in fData
+  
+  const Int_t pageSize = GetPageSize();
+  
+  if (fNUsedPages == fCapacity)
+  {
+    // grow by a factor 2 to keep the number of reallocations small
+    Int_t newCapacity = (fCapacity > 0) ? 2 * fCapacity : 16;
+    if (newCapacity > fNPages)
+      newCapacity = fNPages;
+    
+    Int_t* newPageIds = new Int_t[newCapacity];
+    TemplateType* newData = new TemplateType[(Long64_t) newCapacity * pageSize];
+    if (fNUsedPages > 0)
+    {
+      memcpy(newPageIds, fPageIds, fNUsedPages * sizeof(Int_t));
+      memcpy(newData, fData, (Long64_t) fNUsedPages * pageSize * sizeof(TemplateType));
+    }
+    delete[] fPageIds;
+    delete[] fData;
+    fPageIds = newPageIds;
+    fData = newData;
+    fCapacity = newCapacity;
+  }
+  
+  Int_t slot = fNUsedPages++;
+  fNData = fNUsedPages * pageSize;
+  fPageIds[slot] = page;
+  fPageTable[page] = slot;
+  memset(fData + (Long64_t) slot * pageSize, 0, pageSize * sizeof(TemplateType));
+  
+  // the dense copy is outdated now
+  delete[] fDense;
+  fDense = 0;
+  
+  return slot;
+}
+
+template <typename TemplateType>
+TemplateType AliTHnPagedArray<TemplateType>::Get(Long64_t bin) const
+{
+  // returns the content of <bin> (0 if the page is not allocated)
+  
+  const Int_t pageSize = GetPageSize();
+  Int_t slot = fPageTable[bin / pageSize];
+  if (slot < 0)
+    return 0;
+  
+  return fData[(Long64_t) slot * pageSize + bin % pageSize];
+}
+
+template <typename TemplateType>
+void AliTHnPagedArray<TemplateType>::Set(Long64_t bin, Double_t value)
+{
+  // sets the content of <bin>, does not allocate a page to store 0
+  
+  const Int_t pageSize = GetPageSize();
+  Int_t page = bin / pageSize;
+  Int_t slot = fPageTable[page];
+  if (slot < 0)
+  {
+    if (value == 0)
+      return;
+    slot = AllocatePage(page);
+  }
+  
+  fData[(Long64_t) slot * pageSize + bin % pageSize] = value;
+  
+  delete[] fDense;
+  fDense = 0;
+}
+
+template <typename TemplateType>
+void AliTHnPagedArray<TemplateType>::Add(const AliTHnPagedArray& source)
+{
+  // adds the content of <source> page by page (only pages allocated in <source> are touched)
+  
+  if (source.fN != fN)
+  {
+    AliFatal(Form("Inconsistent number of bins: %d vs %d", source.fN, fN));
+    return;
+  }
+  
+  const Int_t pageSize = GetPageSize();
+  for (Int_t i=0; i<source.fNUsedPages; i++)
+  {
+    Int_t page = source.fPageIds[i];
+    Int_t slot = fPageTable[page];
+    if (slot < 0)
+      slot = AllocatePage(page);
+    
+    TemplateType* target = fData + (Long64_t) slot * pageSize;
+    const TemplateType* from = source.fData + (Long64_t) i * pageSize;
+    for (Int_t j=0; j<pageSize; j++)
+      target[j] += from[j];
+  }
+  
+  delete[] fDense;
+  fDense = 0;
+}
+
+template <typename TemplateType>
+Long64_t AliTHnPagedArray<TemplateType>::NextFilledPage(Long64_t bin) const
+{
+  // returns <bin> if its page is allocated, otherwise the first bin of the next allocated page (fN if there is none)
+  // allows loops over all bins to skip empty pages
+  
+  const Int_t pageSize = GetPageSize();
+  for (Int_t page = bin / pageSize; page < fNPages; page++)
+  {
+    if (fPageTable[page] >= 0)
+      return (page == bin / pageSize) ? bin : (Long64_t) page * pageSize;
+  }
+  
+  return fN;
+}
+
+template <typename TemplateType>
+const TemplateType* AliTHnPagedArray<TemplateType>::GetArray() const
+{
+  // returns a dense copy of the content (densification on demand)
+  // the copy is owned by this object and invalidated by any modification
+  
+  if (!fDense)
+  {
+    const Int_t pageSize = GetPageSize();
+    fDense = new TemplateType[fN];
+    memset(fDense, 0, fN * sizeof(TemplateType));
+    for (Int_t i=0; i<fNUsedPages; i++)
+    {
+      Long64_t first = (Long64_t) fPageIds[i] * pageSize;
+      Long64_t n = TMath::Min((Long64_t) pageSize, fN - first);
+      memcpy(fDense + first, fData + (Long64_t) i * pageSize, n * sizeof(TemplateType));
+    }
+  }
+  
+  return fDense;
+}
+
+template <typename TemplateType>
+void AliTHnPagedArray<TemplateType>::Streamer(TBuffer &R__b)
+{
+  // streams the allocated pages and builds the page table after reading
+  
+  if (R__b.IsReading())
+  {
+    R__b.ReadClassBuffer(AliTHnPagedArray::Class(), this);
+    delete[] fDense;
+    fDense = 0;
+    // fData holds exactly the pages which were read
+    fCapacity = fNUsedPages;
+    BuildPageTable();
+  }
+  else
+    R__b.WriteClassBuffer(AliTHnPagedArray::Class(), this);
+}
+
+template class AliTHnPagedArray<Float_t>;
+template class AliTHnPagedArray<Double_t>;
@@ -0,0 +1,82 @@
+#ifndef AliTHnPagedArray_H
+#define AliTHnPagedArray_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+// paged storage for AliTHnT: only pages (4 KB) which contain filled bins are allocated and written to file
+//
+// Use AliTHnPaged instead of AliTHn when most of the bins stay empty (e.g. many axes in pp or mixed-event steps)
+
+#include "TArray.h"
+
+template <typename TemplateType>
+class AliTHnPagedArray : public TArray
+{
+ public:
+  AliTHnPagedArray();
+  AliTHnPagedArray(Int_t n);
+  AliTHnPagedArray(const AliTHnPagedArray &c);
+  AliTHnPagedArray& operator=(const AliTHnPagedArray &c);
+  virtual ~AliTHnPagedArray();
+  
+  // TArray interface
+  virtual Double_t GetAt(Int_t i) const { return Get(i); }
+  virtual void SetAt(Double_t v, Int_t i) { Set(i, v); }
+  virtual void Set(Int_t n);
+  
+  TemplateType Get(Long64_t bin) const;
+  void Set(Long64_t bin, Double_t value);
+  inline void Add(Long64_t bin, Double_t weight);
+  void Add(const AliTHnPagedArray& source);
+  void Reset();
+  
+  Long64_t NextFilledPage(Long64_t bin) const;
+  const TemplateType* GetArray() const;
+  
+  Int_t GetNAllocatedPages() const { return fNUsedPages; }
+  static Int_t GetPageSize() { return fgkPageBytes / sizeof(TemplateType); }
+  
+ protected:
+  void BuildPageTable();
+  Int_t AllocatePage(Int_t page);
+  
+  static const Int_t fgkPageBytes = 4096; // size of one page in bytes
+  
+  Int_t fNUsedPages;         // number of allocated pages
+  Int_t* fPageIds;           //[fNUsedPages] page number of each allocated page
+  Int_t fNData;              // number of stored values (fNUsedPages * page size)
+  TemplateType* fData;       //[fNData] content of the allocated pages
+  
+  Int_t fNPages;                //! total number of pages
+  Int_t* fPageTable;            //! page number -> index in fPageIds (-1 if not allocated), always built (also after reading)
+  Int_t fCapacity;              //! number of pages which fit into fData
+  mutable TemplateType* fDense; //! dense copy returned by GetArray()
+  
+  ClassDef(AliTHnPagedArray, 1) // paged storage for AliTHnT
+};
+
+template <typename TemplateType>
+void AliTHnPagedArray<TemplateType>::Add(Long64_t bin, Double_t weight)
+{
+  // adds <weight> to <bin>, allocates the page if needed
+  
+  const Int_t pageSize = GetPageSize();
+  Int_t page = bin / pageSize;
+  Int_t slot = fPageTable[page];
+  if (slot < 0)
+    slot = AllocatePage(page);
+  
+  fData[(Long64_t) slot * pageSize + bin % pageSize] += weight;
+  
+  if (fDense)
+  {
+    delete[] fDense;
+    fDense = 0;
+  }
+}
+
+typedef AliTHnPagedArray<Float_t> AliTHnPagedArrayF;
+typedef AliTHnPagedArray<Double_t> AliTHnPagedArrayD;
+
+#endif
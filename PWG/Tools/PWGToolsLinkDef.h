@@ -19,6 +19,12 @@
 #pragma link C++ class AliTHnBase+;
 #pragma link C++ class AliTHnT<TArrayF, Float_t>+;
 #pragma link C++ class AliTHnT<TArrayD, Double_t>+;
+#pragma link C++ typedef AliTHnPaged;
+#pragma link C++ typedef AliTHnPagedD;
+#pragma link C++ class AliTHnPagedArray<Float_t>-;
+#pragma link C++ class AliTHnPagedArray<Double_t>-;
+#pragma link C++ class AliTHnT<AliTHnPagedArrayF, Float_t>+;
+#pragma link C++ class AliTHnT<AliTHnPagedArrayD, Double_t>+;
 #pragma link C++ class THistManager+;
 #pragma link C++ class AliJSONReader+;
 #pragma link C++ class AliJSONData+;
@@ -46,4 +52,6 @@
 #pragma link C++ function TestTHistManager::TestRunBuildGrouped();
 #pragma link C++ function TestTHistManager::TestRunFillSimple();
 #pragma link C++ function TestTHistManager::TestRunFillGrouped();
+#pragma link C++ function TestTHistManager::TestRunFillHandles();
+#pragma link C++ function TestTHistManager::BenchmarkFillHandles(int);
 #endif
@@ -30,6 +30,7 @@
 #include <TObjArray.h>
 #include <TObjString.h>
 #include <TProfile.h>
+#include <TStopwatch.h>
 #include <TString.h>
 
 #include "TBinning.h"
@@ -625,6 +626,38 @@ void THistManager::FillProfile(const char* name, double x, double y, double weig
   hist->Fill(x, y, weight);
 }
 
+void THistManager::FillNImpl(TH1 *hist, int n, const double * const *coords, const double *weights){
+  hist->FillN(n, coords[0], weights);
+}
+
+void THistManager::FillNImpl(TH2 *hist, int n, const double * const *coords, const double *weights){
+  if(weights) {
+    hist->FillN(n, coords[0], coords[1], weights);
+  } else {
+    for(int i = 0; i < n; i++) hist->Fill(coords[0][i], coords[1][i]);
+  }
+}
+
+void THistManager::FillNImpl(TH3 *hist, int n, const double * const *coords, const double *weights){
+  for(int i = 0; i < n; i++) hist->Fill(coords[0][i], coords[1][i], coords[2][i], weights ? weights[i] : 1.);
+}
+
+void THistManager::FillNImpl(TProfile *hist, int n, const double * const *coords, const double *weights){
+  if(weights) {
+    hist->FillN(n, coords[0], coords[1], weights);
+  } else {
+    for(int i = 0; i < n; i++) hist->Fill(coords[0][i], coords[1][i]);
+  }
+}
+
+void THistManager::FillNImpl(THnSparse *hist, int n, const double * const *coords, const double *weights){
+  std::vector<double> point(hist->GetNdimensions());
+  for(int i = 0; i < n; i++){
+    for(int idim = 0; idim < hist->GetNdimensions(); idim++) point[idim] = coords[idim][i];
+    hist->Fill(point.data(), weights ? weights[i] : 1.);
+  }
+}
+
 TObject *THistManager::FindObject(const char *name) const {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
@@ -1030,6 +1063,72 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandles(){
+    THistManager testmgr("testmgr");
+
+    testmgr.CreateTH1("Group1/Test1", "Test handle 1D", 1, 0., 1.);
+    testmgr.CreateTH2("Group1/Test2", "Test handle 2D", 1, 0., 1., 1, 0., 1.);
+    testmgr.CreateTH3("Group2/Test3", "Test handle 3D", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    testmgr.CreateTHnSparse("Group2/TestN", "Test handle THnSparse", 4, nbins, min, max);
+    testmgr.CreateTProfile("Group3/Subgroup1/TestProfile", "Test handle Profile", 1, 0., 1.);
+
+    THistManager::THistHandle<TH1> h1 = testmgr.GetHandle<TH1>("Group1/Test1");
+    THistManager::THistHandle<TH2> h2 = testmgr.GetHandle<TH2>("Group1/Test2");
+    THistManager::THistHandle<TH3> h3 = testmgr.GetHandle<TH3>("Group2/Test3");
+    THistManager::THistHandle<THnSparse> hN = testmgr.GetHandle<THnSparse>("Group2/TestN");
+    THistManager::THistHandle<TProfile> hProfile = testmgr.GetHandle<TProfile>("Group3/Subgroup1/TestProfile");
+
+    bool success(true);
+    if(!(h1.IsValid() && h2.IsValid() && h3.IsValid() && hN.IsValid() && hProfile.IsValid())){
+      std::cout << "Not all handles are valid" << std::endl;
+      return 1;
+    }
+
+    // single fills via the handle
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 100; i++){
+      h1->Fill(0.5);
+      h2->Fill(0.5, 0.5);
+      h3->Fill(0.5, 0.5, 0.5);
+      hN->Fill(point);
+      hProfile->Fill(0.5, 1.);
+    }
+
+    // batched fills via the handle
+    std::vector<double> values(100, 0.5), ones(100, 1.);
+    const double *coords[4] = {values.data(), values.data(), values.data(), values.data()};
+    const double *profilecoords[2] = {values.data(), ones.data()};
+    h1.FillN(100, coords);
+    h2.FillN(100, coords);
+    h3.FillN(100, coords, ones.data());
+    hN.FillN(100, coords);
+    hProfile.FillN(100, profilecoords);
+
+    if(TMath::Abs(h1->GetBinContent(1) - 200) > DBL_EPSILON){
+      std::cout << "Group1/Test1: Value mismatch: expected 200, found " << h1->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h2->GetBinContent(1, 1) - 200) > DBL_EPSILON){
+      std::cout << "Group1/Test2: Value mismatch: expected 200, found " << h2->GetBinContent(1, 1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h3->GetBinContent(1, 1, 1) - 200) > DBL_EPSILON){
+      std::cout << "Group2/Test3: Value mismatch: expected 200, found " << h3->GetBinContent(1, 1, 1) << std::endl;
+      success = false;
+    }
+    int index[4] = {1,1,1,1};
+    if(TMath::Abs(hN->GetBinContent(index) - 200) > DBL_EPSILON){
+      std::cout << "Group2/TestN: Value mismatch: expected 200, found " << hN->GetBinContent(index) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(hProfile->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "Group3/Subgroup1/TestProfile: Value mismatch: expected 1, found " << hProfile->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1149,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handles" << std::endl;
+    testresult += testsuite.TestFillHandles();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1175,60 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandles(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandles();
+  }
+
+  int BenchmarkFillHandles(int nfill){
+    THistManager benchmgr("benchmgr");
+    benchmgr.CreateTH2("Tracks/Charged/hByName", "Fill by name", 100, 0., 1., 100, 0., 1.);
+    benchmgr.CreateTH2("Tracks/Charged/hByHandle", "Fill by handle", 100, 0., 1., 100, 0., 1.);
+    benchmgr.CreateTH2("Tracks/Charged/hBatched", "Batched fill by handle", 100, 0., 1., 100, 0., 1.);
+
+    std::vector<double> xvals(nfill), yvals(nfill), weights(nfill);
+    for(int i = 0; i < nfill; i++){
+      xvals[i] = (i % 1000) / 1000.;
+      yvals[i] = (i % 997) / 997.;
+      weights[i] = 1. + (i % 3);
+    }
+
+    TStopwatch timer;
+    timer.Start();
+    for(int i = 0; i < nfill; i++) benchmgr.FillTH2("Tracks/Charged/hByName", xvals[i], yvals[i], weights[i]);
+    timer.Stop();
+    double tname = timer.RealTime();
+
+    timer.Start();
+    THistManager::THistHandle<TH2> handle = benchmgr.GetHandle<TH2>("Tracks/Charged/hByHandle");
+    for(int i = 0; i < nfill; i++) handle->Fill(xvals[i], yvals[i], weights[i]);
+    timer.Stop();
+    double thandle = timer.RealTime();
+
+    timer.Start();
+    THistManager::THistHandle<TH2> batched = benchmgr.GetHandle<TH2>("Tracks/Charged/hBatched");
+    const double *coords[2] = {xvals.data(), yvals.data()};
+    batched.FillN(nfill, coords, weights.data());
+    timer.Stop();
+    double tbatched = timer.RealTime();
+
+    std::cout << "Fill by name:          " << tname / nfill * 1e9 << " ns per fill" << std::endl;
+    std::cout << "Fill by handle:        " << thandle / nfill * 1e9 << " ns per fill" << std::endl;
+    std::cout << "Batched fill (handle): " << tbatched / nfill * 1e9 << " ns per fill" << std::endl;
+
+    // all methods must lead to the same content
+    TH2 *hname = static_cast<TH2 *>(benchmgr.FindObject("Tracks/Charged/hByName")),
+        *hhandle = handle.Get(),
+        *hbatched = batched.Get();
+    for(int ix = 1; ix <= hname->GetXaxis()->GetNbins(); ix++){
+      for(int iy = 1; iy <= hname->GetYaxis()->GetNbins(); iy++){
+        if(hname->GetBinContent(ix, iy) != hhandle->GetBinContent(ix, iy) || hname->GetBinContent(ix, iy) != hbatched->GetBinContent(ix, iy)){
+          std::cout << "Content mismatch in bin (" << ix << ", " << iy << ")" << std::endl;
+          return 1;
+        }
+      }
+    }
+    return 0;
+  }
 }
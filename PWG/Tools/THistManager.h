@@ -95,6 +95,25 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ *
+ * # Filling via histogram handles
+ *
+ * The Fill methods above resolve the histogram from its name in every call. For
+ * histograms filled several times per event the lookup can be done once, e.g. in
+ * UserCreateOutputObjects, by requesting a typed handle. Filling via the handle
+ * then only dereferences a pointer. Handles also provide a batched fill for
+ * a set of points stored as one array per dimension.
+ *
+ * ~~~{.cxx}
+ * THistManager::THistHandle<TH2> hEtaPhi = mgr.GetHandle<TH2>("tracks/hEtaPhi");
+ * ...
+ * hEtaPhi->Fill(eta, phi);
+ * const double *coords[2] = {etas, phis};
+ * hEtaPhi.FillN(ntracks, coords);
+ * ~~~
+ *
+ * The handle stays valid as long as the histogram is owned by the histogram manager.
+ * The bin width correction (option *w*) is only available in the name-based Fill methods.
  */
 class THistManager : public TNamed {
 public:
@@ -229,6 +248,61 @@ public:
     iterator();
   };
 
+  /**
+   * @class THistHandle
+   * @brief Pre-resolved typed access to a histogram in the histogram manager
+   * @ingroup Histmanager
+   *
+   * Created via THistManager::GetHandle. Holds a pointer to the histogram, so
+   * filling does not need to look up the histogram by name.
+   */
+  template<class HistType>
+  class THistHandle {
+  public:
+    /**
+     * @brief Dummy constructor, creating an invalid handle
+     */
+    THistHandle(): fHist(nullptr) { }
+
+    /**
+     * @brief Constructor
+     * @param[in] hist Histogram the handle points to
+     */
+    explicit THistHandle(HistType *hist): fHist(hist) { }
+
+    /**
+     * @brief Access to the underlying histogram
+     * @return Histogram the handle points to
+     */
+    HistType *Get() const { return fHist; }
+
+    /**
+     * @brief Access to the members of the underlying histogram (i.e. handle->Fill(x))
+     * @return Histogram the handle points to
+     */
+    HistType *operator->() const { return fHist; }
+
+    /**
+     * @brief Check whether the handle points to a histogram
+     * @return True if the handle is valid
+     */
+    bool IsValid() const { return fHist != nullptr; }
+
+    /**
+     * @brief Fill n points at once
+     *
+     * Points are stored as one array per dimension (coords[idim][ipoint]).
+     * For TProfile the second dimension contains the y values.
+     * @param[in] n Number of points
+     * @param[in] coords Array of ndim pointers to the coordinates of the points
+     * @param[in] weights Weights of the points (weight 1 for all points if nullptr)
+     */
+    void FillN(int n, const double * const *coords, const double *weights = nullptr) { THistManager::FillNImpl(fHist, n, coords, weights); }
+
+  private:
+    HistType *fHist;                    ///< Underlying histogram (not owned)
+  };
+
   /**
    * @brief Default constructor.
    *
@@ -691,6 +765,19 @@ public:
 	 */
 	virtual TObject *FindObject(const TObject *obj) const;
 
+	/**
+	 * @brief Get a typed handle to a histogram.
+	 *
+	 * The histogram is looked up once (the name follows the common notation
+	 * including parent groups). Filling via the handle avoids the name lookup
+	 * of the Fill methods. Fatal if the histogram does not exist or is not of
+	 * the requested type.
+	 * @param[in] name Name of the histogram (including the path of parent groups)
+	 * @return Handle to the histogram
+	 */
+	template<class HistType>
+	THistHandle<HistType> GetHandle(const char *name) const;
+
 private:
 	THistManager(const THistManager &);
 	THistManager &operator=(const THistManager &);
@@ -719,6 +806,21 @@ private:
 	 */
 	TString histname(const TString &path) const;
 
+	/**
+	 * @brief Batched fill implementations used by THistHandle::FillN.
+	 *
+	 * Overloaded for the supported histogram types.
+	 * @param[in] hist Histogram to fill
+	 * @param[in] n Number of points
+	 * @param[in] coords One array of coordinates per dimension
+	 * @param[in] weights Weights of the points (nullptr: weight 1)
+	 */
+	static void FillNImpl(TH1 *hist, int n, const double * const *coords, const double *weights);
+	static void FillNImpl(TH2 *hist, int n, const double * const *coords, const double *weights);
+	static void FillNImpl(TH3 *hist, int n, const double * const *coords, const double *weights);
+	static void FillNImpl(TProfile *hist, int n, const double * const *coords, const double *weights);
+	static void FillNImpl(THnSparse *hist, int n, const double * const *coords, const double *weights);
+
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
 
@@ -743,6 +845,15 @@ THistManager::iterator THistManager::rend() const {
   return iterator(this, -1, iterator::kTHMIbackward);
 }
 
+template<class HistType>
+THistManager::THistHandle<HistType> THistManager::GetHandle(const char *name) const {
+  HistType *hist = dynamic_cast<HistType *>(FindObject(name));
+  if(!hist){
+    Fatal("THistManager::GetHandle", "Histogram %s not found or not of the requested type", name);
+  }
+  return THistHandle<HistType>(hist);
+}
+
 /**
  * @namespace TestTHistManager
  * @brief Collection of simple test for the THistManager
@@ -762,6 +873,7 @@ namespace TestTHistManager {
  * - Build histrogram in groups
  * - Simple fill
  * - Fill histograms in groups
+ * - Fill histograms via handles
  */
 class THistManagerTestSuite {
 public:
@@ -845,6 +957,20 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether filling via handles gives the same result as filling via names
+   * Relies on: TestBuildGroupedHistograms, TestFillGroupedHistograms
+   *
+   * Request handles for a TH1, TH2, TH3, THnSparse and TProfile in groups, fill each 100 times
+   * via the handle and 100 times via the batched fill of the handle
+   *
+   * Test passed:
+   * - All handles are valid
+   * - All Histograms have the expected value (200 for histograms, 1 for profile)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandles();
 };
 
 /**
@@ -882,5 +1008,21 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run test fill via handles
+ * @return 0 if test is passed, 1 if it failed
+ */
+int TestRunFillHandles();
+
+/**
+ * @brief Benchmark name-based fill against handle-based fill
+ *
+ * Fills a TH2 in a histogram group nfill times via FillTH2, via a handle
+ * and via the batched fill of the handle, and prints the time per fill.
+ * @param[in] nfill Number of fills per method
+ * @return 0 if all methods lead to the same histogram content, 1 otherwise
+ */
+int BenchmarkFillHandles(int nfill = 1000000);
+
 }
 #endif
@@ -26,6 +26,7 @@
 
 #include "AliCFContainer.h"
 #include "AliBasicParticle.h"
+#include "AliCFParticle.h"
 #include "AliVParticle.h"
 #include "AliAODTrack.h"
 
@@ -37,8 +38,67 @@
 #include "TMath.h"
 #include "TLorentzVector.h"
 
+#include <vector>
+
 ClassImp(AliUEHistograms)
 
+namespace {
+  // contiguous copy of the particle properties used in the pair loop of AliUEHistograms::FillCorrelations
+  struct AliUEPackedParticles
+  {
+    AliUEPackedParticles() : fN(0) {}
+    
+    void Pack(TObjArray* list, Bool_t needEventIndex, UInt_t resonanceDaughterFlag)
+    {
+      fN = list->GetEntriesFast();
+      fPt.resize(fN);
+      fEta.resize(fN);
+      fPhi.resize(fN);
+      fCharge.resize(fN);
+      fEventIndex.resize(needEventIndex ? fN : 0);
+      fUniqueID.resize(fN);
+      fObject.resize(fN);
+      fCompareUniqueID.resize(fN);
+      fResonanceDaughter.resize(fN);
+      
+      for (Int_t i=0; i<fN; i++)
+      {
+        AliVParticle* particle = (AliVParticle*) list->UncheckedAt(i);
+        AliBasicParticle* basic = dynamic_cast<AliBasicParticle*>(particle);
+        
+        fPt[i] = particle->Pt();
+        fEta[i] = particle->Eta();
+        fPhi[i] = particle->Phi();
+        fCharge[i] = particle->Charge();
+        fUniqueID[i] = particle->GetUniqueID();
+        fObject[i] = particle;
+        // classes known to implement IsEqual as a comparison of the unique ID, all others call IsEqual per pair
+        fCompareUniqueID[i] = (basic != 0 || dynamic_cast<AliCFParticle*>(particle) != 0);
+        fResonanceDaughter[i] = particle->TestBit(resonanceDaughterFlag);
+        
+        if (needEventIndex)
+        {
+          if (!basic)
+            AliFatalGeneral("AliUEHistograms", "If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
+          else
+            fEventIndex[i] = basic->GetEventIndex();
+        }
+      }
+    }
+    
+    Int_t fN;                              // number of particles
+    std::vector<Double_t> fPt;             // pT
+    std::vector<Float_t> fEta;             // eta (float, as cached in the default path)
+    std::vector<Double_t> fPhi;            // phi
+    std::vector<Short_t> fCharge;          // charge
+    std::vector<Long64_t> fEventIndex;     // event index (only filled if needed)
+    std::vector<UInt_t> fUniqueID;         // unique ID (used by AliBasicParticle::IsEqual)
+    std::vector<const TObject*> fObject;   // original object (for IsEqual of other classes)
+    std::vector<UChar_t> fCompareUniqueID; // IsEqual of the particle compares the unique ID
+    std::vector<UChar_t> fResonanceDaughter; // flagged as resonance daughter
+  };
+}
+
 const Int_t AliUEHistograms::fgkUEHists = 3;
 
 AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const char* binning) : 
@@ -76,6 +136,7 @@ AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const
   fPtOrder(kTRUE),
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
+  fUsePackedPairKernel(kFALSE),
   fRunNumber(0),
   fMergeCount(1)
 {
@@ -86,6 +147,7 @@ AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const
   //    2 = SumpT
   //    3 = NumberDensityPhi
   //    4 = NumberDensityPhiCentrality (other multiplicity for Pb)
+  // for 4, 5, 6 the storage can be chosen with S (THnSparse), D (AliTHn with double) and P (paged AliTHn, only filled parts are allocated)
   
   AliLog::SetClassDebugLevel("AliCFContainer", -1);
   AliLog::SetClassDebugLevel("AliCFGridSparse", -3);
@@ -153,6 +215,9 @@ AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const
     else if (histogramsStr.Contains("D"))
       configStr += "Double";
     
+    if (histogramsStr.Contains("P"))
+      configStr += "Paged";
+    
     fNumberDensityPhi = new AliUEHist(configStr, binningStr);
   }
   
@@ -247,6 +312,7 @@ AliUEHistograms::AliUEHistograms(const AliUEHistograms &c) :
   fPtOrder(kTRUE),
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
+  fUsePackedPairKernel(kFALSE),
   fRunNumber(0),
   fMergeCount(1)
 {
@@ -686,6 +752,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
     }
     
+    // the packed path applies the same cuts and fills as the loop below but works on contiguous arrays
+    if (fUsePackedPairKernel)
+      FillCorrelationsPacked(centrality, zVtx, step, particles, mixed, weight, fillpT, firstTime, twoTrackEfficiencyCut, bSign, twoTrackEfficiencyCutValue, applyEfficiency, triggerWeighting, kResonanceDaughterFlag);
+    else
     for (Int_t i=0; i<particles->GetEntriesFast(); i++)
     {
       AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
@@ -945,60 +1015,374 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
  
       if (firstTime)
+        FillTrigger(centrality, zVtx, step, triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), applyEfficiency, triggerWeighting);
+    }
+    
+    if (triggerWeighting)
+    {
+      delete triggerWeighting;
+      triggerWeighting = 0;
+    }
+  }
+  
+  fCentralityDistribution->Fill(centrality);
+  fCentralityCorrelation->Fill(centrality, particles->GetEntriesFast());
+  FillEvent(centrality, step);
+}
+  
+//____________________________________________________________________
+void AliUEHistograms::FillTrigger(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, Double_t triggerPt, Float_t triggerEta, Double_t triggerPhi, Bool_t applyEfficiency, TH1* triggerWeighting)
+{
+  // fills the per-trigger histograms (once per trigger particle)
+  
+  Double_t vars[3];
+  vars[0] = triggerPt;
+  vars[1] = centrality;
+  vars[2] = zVtx;
+
+  Double_t useWeight = 1;
+  if (fEfficiencyCorrectionTriggers && applyEfficiency)
+  {
+    Int_t effVars[4];
+    
+    // trigger particle
+    effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
+    effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(vars[0]); //pt
+    effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(vars[1]); //centrality
+    effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(vars[2]); //zVtx
+    useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
+  }
+
+  if (TMath::Abs(triggerEta) < 0.8 && triggerPt > 0)
+    fInvYield2->Fill(centrality, triggerPt, useWeight / triggerPt);
+
+  if (fWeightPerEvent)
+  {
+    // leads effectively to a filling of one entry per filled trigger particle pT bin
+    Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[0]);
+    useWeight /= triggerWeighting->GetBinContent(weightBin);
+  }
+  
+  fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
+
+  // QA
+  fCorrelationpT->Fill(centrality, triggerPt);
+  fCorrelationEta->Fill(centrality, triggerEta);
+  fCorrelationPhi->Fill(centrality, triggerPhi);
+  fYields->Fill(centrality, triggerPt, triggerEta);
+}
+
+//____________________________________________________________________
+void AliUEHistograms::FillCorrelationsPacked(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, Float_t weight, Bool_t fillpT, Bool_t firstTime, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency, TH1* triggerWeighting, UInt_t resonanceDaughterFlag)
+{
+  // pair loop of FillCorrelations working on contiguous arrays
+  //
+  // triggers and associated particles are packed once per call, the cheap pair cuts are evaluated for one trigger
+  // against all associated particles in simple loops over these arrays (which the compiler can vectorize) and
+  // only the surviving pairs go through the invariant mass cuts, the two-track cut and the filling.
+  // The arithmetic (including the float/double conversions) and the filling order are the same as in the
+  // default path, therefore the filled histograms are identical.
+  
+  const Bool_t needEventIndex = fCheckEventNumberInCorrelation;
+  
+  AliUEPackedParticles triggers;
+  triggers.Pack(particles, needEventIndex, resonanceDaughterFlag);
+  
+  AliUEPackedParticles associatedStore;
+  if (mixed)
+    associatedStore.Pack(mixed, needEventIndex, resonanceDaughterFlag);
+  const AliUEPackedParticles& associated = (mixed) ? associatedStore : triggers;
+  
+  const Int_t nTriggers = triggers.fN;
+  const Int_t jMax = associated.fN;
+  
+  // associated efficiency only depends on the associated particle
+  std::vector<Double_t> associatedEfficiency;
+  if (applyEfficiency && fEfficiencyCorrectionAssociated)
+  {
+    associatedEfficiency.resize(jMax);
+    for (Int_t j=0; j<jMax; j++)
+    {
+      Int_t effVars[4];
+      effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(associated.fEta[j]);
+      effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(associated.fPt[j]); //pt
+      effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(centrality); //centrality
+      effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin((Double_t) zVtx); //zVtx
+      associatedEfficiency[j] = fEfficiencyCorrectionAssociated->GetBinContent(effVars);
+    }
+  }
+  
+  std::vector<UChar_t> accept(jMax);
+  std::vector<Float_t> deltaEta(jMax);
+  std::vector<Double_t> deltaPhi(jMax);
+  
+  const Double_t* assocPt = (jMax > 0) ? &associated.fPt[0] : 0;
+  const Float_t* assocEta = (jMax > 0) ? &associated.fEta[0] : 0;
+  const Double_t* assocPhi = (jMax > 0) ? &associated.fPhi[0] : 0;
+  const Short_t* assocCharge = (jMax > 0) ? &associated.fCharge[0] : 0;
+  UChar_t* acc = (jMax > 0) ? &accept[0] : 0;
+  Float_t* dEta = (jMax > 0) ? &deltaEta[0] : 0;
+  Double_t* dPhi = (jMax > 0) ? &deltaPhi[0] : 0;
+  
+  const Double_t kPi = TMath::Pi();
+  const Double_t kTwoPi = TMath::TwoPi();
+  
+  for (Int_t i=0; i<nTriggers; i++)
+  {
+    const Double_t triggerPt = triggers.fPt[i];
+    const Float_t triggerEta = triggers.fEta[i];
+    const Double_t triggerPhi = triggers.fPhi[i];
+    const Short_t triggerCharge = triggers.fCharge[i];
+    
+    if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
+      continue;
+
+    if (fOnlyOneEtaSide != 0)
+    {
+      if (fOnlyOneEtaSide * triggerEta < 0)
+	continue;
+    }
+    
+    if (fTriggerSelectCharge != 0)
+      if (triggerCharge * fTriggerSelectCharge < 0)
+	continue;
+    
+    if (fRejectResonanceDaughters > 0 && triggers.fResonanceDaughter[i])
+      continue;
+    
+    // --- stage 1: branch-free cuts over the associated arrays
+    for (Int_t j=0; j<jMax; j++)
+    {
+      acc[j] = 1;
+      dEta[j] = triggerEta - assocEta[j];
+      Double_t dphi = triggerPhi - assocPhi[j];
+      dphi -= (dphi > 1.5 * kPi) ? kTwoPi : 0;
+      dphi += (dphi < -0.5 * kPi) ? kTwoPi : 0;
+      dPhi[j] = dphi;
+    }
+    
+    if (!mixed && i < jMax)
+      acc[i] = 0;
+    
+    if (needEventIndex)
+    {
+      const Long64_t triggerEventIndex = triggers.fEventIndex[i];
+      for (Int_t j=0; j<jMax; j++)
+	acc[j] &= (associated.fEventIndex[j] != triggerEventIndex);
+    }
+    else if (mixed)
+    {
+      // same semantics as triggerParticle->IsEqual(particle)
+      if (triggers.fCompareUniqueID[i])
+      {
+	const UInt_t triggerID = triggers.fUniqueID[i];
+	for (Int_t j=0; j<jMax; j++)
+	  acc[j] &= (associated.fUniqueID[j] != triggerID);
+      }
+      else
       {
-        // once per trigger particle
-        Double_t vars[3];
-        vars[0] = triggerParticle->Pt();
-        vars[1] = centrality;
-	vars[2] = zVtx;
-
-	Double_t useWeight = 1;
-	if (fEfficiencyCorrectionTriggers && applyEfficiency)
+	const TObject* triggerObject = triggers.fObject[i];
+	for (Int_t j=0; j<jMax; j++)
+	  if (acc[j] && triggerObject->IsEqual(associated.fObject[j]))
+	    acc[j] = 0;
+      }
+    }
+    
+    if (fPtOrder)
+      for (Int_t j=0; j<jMax; j++)
+	acc[j] &= (assocPt[j] < triggerPt);
+    
+    if (fAssociatedSelectCharge != 0)
+      for (Int_t j=0; j<jMax; j++)
+	acc[j] &= (assocCharge[j] * fAssociatedSelectCharge >= 0);
+    
+    if (fSelectCharge == 1)
+      for (Int_t j=0; j<jMax; j++)
+	acc[j] &= (assocCharge[j] * triggerCharge <= 0);
+    else if (fSelectCharge == 2)
+      for (Int_t j=0; j<jMax; j++)
+	acc[j] &= (assocCharge[j] * triggerCharge >= 0);
+    
+    if (fEtaOrdering)
+    {
+      if (triggerEta < 0)
+	for (Int_t j=0; j<jMax; j++)
+	  acc[j] &= !(assocEta[j] < triggerEta);
+      if (triggerEta > 0)
+	for (Int_t j=0; j<jMax; j++)
+	  acc[j] &= !(assocEta[j] > triggerEta);
+    }
+    
+    if (fRejectResonanceDaughters > 0)
+      for (Int_t j=0; j<jMax; j++)
+	acc[j] &= !associated.fResonanceDaughter[j];
+    
+    // trigger-dependent factors of the pair weight
+    Double_t triggerEfficiency = 1;
+    if (applyEfficiency && fEfficiencyCorrectionTriggers)
+    {
+      Int_t effVars[4];
+      effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
+      effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(triggerPt); //pt
+      effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(centrality); //centrality
+      effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin((Double_t) zVtx); //zVtx
+      triggerEfficiency = fEfficiencyCorrectionTriggers->GetBinContent(effVars);
+    }
+    
+    Double_t triggerWeight = 1;
+    if (fWeightPerEvent)
+      triggerWeight = triggerWeighting->GetBinContent(triggerWeighting->GetXaxis()->FindBin(triggerPt));
+    
+    // --- stage 2: pair mass cuts, two-track cut and filling for the surviving pairs (in the order of the default path)
+    for (Int_t j=0; j<jMax; j++)
+    {
+      if (!acc[j])
+	continue;
+      
+      const Double_t pt = assocPt[j];
+      const Float_t eta = assocEta[j];
+      const Double_t phi = assocPhi[j];
+      const Short_t charge = assocCharge[j];
+      const Bool_t unlikeSign = (charge * triggerCharge < 0);
+      
+      // conversions
+      if (fCutConversionsV > 0 && unlikeSign)
+      {
+	Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, pt, eta, phi, 0.510e-3, 0.510e-3);
+	
+	if (mass < fCutConversionsV * 5)
 	{
-	  Int_t effVars[4];
+	  mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, pt, eta, phi, 0.510e-3, 0.510e-3);
 	  
-	  // trigger particle
-	  effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
-	  effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(vars[0]); //pt
-	  effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(vars[1]); //centrality
-	  effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(vars[2]); //zVtx
-	  useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
+	  fControlConvResoncances->Fill(0.0, mass);
+
+	  if (mass < fCutConversionsV*fCutConversionsV) 
+	    continue;
 	}
+      }
+      
+      // K0s
+      if (fCutResonancesV > 0 && unlikeSign)
+      {
+	Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, pt, eta, phi, 0.1396, 0.1396);
+	
+	const Float_t kK0smass = 0.4976;
+	
+	if (TMath::Abs(mass - kK0smass*kK0smass) < fCutResonancesV * 5)
+	{
+	  mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, pt, eta, phi, 0.1396, 0.1396);
+	  
+	  fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
 
-	if (TMath::Abs(triggerEta) < 0.8 && triggerParticle->Pt() > 0)
-	  fInvYield2->Fill(centrality, triggerParticle->Pt(), useWeight / triggerParticle->Pt());
+	  if (mass > (kK0smass-fCutResonancesV)*(kK0smass-fCutResonancesV) && mass < (kK0smass+fCutResonancesV)*(kK0smass+fCutResonancesV))
+	    continue;
+	}
+      }
+      
+      // Lambda
+      if (fCutResonancesV > 0 && unlikeSign)
+      {
+	Float_t mass1 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, pt, eta, phi, 0.1396, 0.9383);
+	Float_t mass2 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, pt, eta, phi, 0.9383, 0.1396);
+	
+	const Float_t kLambdaMass = 1.115;
 
-	if (fWeightPerEvent)
+	if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	{
-	  // leads effectively to a filling of one entry per filled trigger particle pT bin
-	  Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[0]);
-// 	  Printf("Using weight %f", triggerWeighting->GetBinContent(weightBin));
-	  useWeight /= triggerWeighting->GetBinContent(weightBin);
+	  mass1 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, pt, eta, phi, 0.1396, 0.9383);
+
+	  fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
+	  
+	  if (mass1 > (kLambdaMass-fCutResonancesV)*(kLambdaMass-fCutResonancesV) && mass1 < (kLambdaMass+fCutResonancesV)*(kLambdaMass+fCutResonancesV))
+	    continue;
 	}
-	
-        fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
+	if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
+	{
+	  mass2 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, pt, eta, phi, 0.9383, 0.1396);
 
-	// QA
-        fCorrelationpT->Fill(centrality, triggerParticle->Pt());
-        fCorrelationEta->Fill(centrality, triggerEta);
-        fCorrelationPhi->Fill(centrality, triggerParticle->Phi());
-	fYields->Fill(centrality, triggerParticle->Pt(), triggerEta);
-	
-/*        if (dynamic_cast<AliAODTrack*>(triggerParticle))
-          fITSClusterMap->Fill(((AliAODTrack*) triggerParticle)->GetITSClusterMap(), centrality, triggerParticle->Pt());*/
+	  fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
+
+	  if (mass2 > (kLambdaMass-fCutResonancesV)*(kLambdaMass-fCutResonancesV) && mass2 < (kLambdaMass+fCutResonancesV)*(kLambdaMass+fCutResonancesV))
+	    continue;
+	}
       }
+
+      if (twoTrackEfficiencyCut)
+      {
+	Float_t phi1 = triggerPhi;
+	Float_t pt1 = triggerPt;
+	Float_t charge1 = triggerCharge;
+	  
+	Float_t phi2 = phi;
+	Float_t pt2 = pt;
+	Float_t charge2 = charge;
+	    
+	Float_t deta = dEta[j];
+	    
+	if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
+	{
+	  Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
+	  Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
+	  
+	  const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
+
+	  Float_t dphistarminabs = 1e5;
+	  Float_t dphistarmin = 1e5;
+	  if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
+	  {
+	    for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
+	    {
+	      Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
+
+	      Float_t dphistarabs = TMath::Abs(dphistar);
+	      
+	      if (dphistarabs < dphistarminabs)
+	      {
+		dphistarmin = dphistar;
+		dphistarminabs = dphistarabs;
+	      }
+	    }
+	    
+	    fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
+	    
+	    if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
+	      continue;
+
+	    fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
+	  }
+	}
+      }
+      
+      Double_t vars[6];
+      vars[0] = dEta[j];
+      vars[1] = pt;
+      vars[2] = triggerPt;
+      vars[3] = centrality;
+      vars[4] = dPhi[j];
+      vars[5] = zVtx;
+      
+      if (fillpT)
+	weight = pt;
+      
+      Double_t useWeight = weight;
+      if (applyEfficiency)
+      {
+	if (fEfficiencyCorrectionAssociated)
+	  useWeight *= associatedEfficiency[j];
+	if (fEfficiencyCorrectionTriggers)
+	  useWeight *= triggerEfficiency;
+      }
+      
+      if (fWeightPerEvent)
+	useWeight /= triggerWeight;
+      
+      // fill all in toward region and do not use the other regions
+      fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->Fill(vars, step, useWeight);
     }
     
-    if (triggerWeighting)
-    {
-      delete triggerWeighting;
-      triggerWeighting = 0;
-    }
+    if (firstTime)
+      FillTrigger(centrality, zVtx, step, triggerPt, triggerEta, triggerPhi, applyEfficiency, triggerWeighting);
   }
-  
-  fCentralityDistribution->Fill(centrality);
-  fCentralityCorrelation->Fill(centrality, particles->GetEntriesFast());
-  FillEvent(centrality, step);
 }
   
 //____________________________________________________________________
@@ -1281,6 +1665,7 @@ void AliUEHistograms::Copy(TObject& c) const
   target.fPtOrder = fPtOrder;
   target.fTwoTrackCutMinRadius = fTwoTrackCutMinRadius;
   target.fCheckEventNumberInCorrelation = fCheckEventNumberInCorrelation;
+  target.fUsePackedPairKernel = fUsePackedPairKernel;
 }
 
 //____________________________________________________________________
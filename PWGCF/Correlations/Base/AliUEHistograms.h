@@ -18,6 +18,7 @@ class AliVParticle;
 class TList;
 class TSeqCollection;
 class TObjArray;
+class TH1;
 class TH1F;
 class TH2F;
 class TH3F;
@@ -94,6 +95,8 @@ class AliUEHistograms : public TNamed
   void SetOnlyOneEtaSide(Int_t flag)    { fOnlyOneEtaSide = flag; }
   void SetPtOrder(Bool_t flag) { fPtOrder = flag; }
   void SetTwoTrackCutMinRadius(Float_t min) { fTwoTrackCutMinRadius = min; }
+  void SetUsePackedPairKernel(Bool_t flag) { fUsePackedPairKernel = flag; }
+  Bool_t GetUsePackedPairKernel() const { return fUsePackedPairKernel; }
 
   void SetCheckEventNumberInCorrelation(Bool_t val) { fCheckEventNumberInCorrelation = val; }
   void ExtendTrackingEfficiency(Bool_t verbose = kFALSE);
@@ -109,6 +112,8 @@ class AliUEHistograms : public TNamed
 protected:
   void FillRegion(AliUEHist::Region region, Float_t zVtx, AliUEHist::CFStep step, AliVParticle* leading, TList* list, Int_t multiplicity);
   Int_t CountParticles(TList* list, Float_t ptMin);
+  void FillCorrelationsPacked(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, Float_t weight, Bool_t fillpT, Bool_t firstTime, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency, TH1* triggerWeighting, UInt_t resonanceDaughterFlag);
+  void FillTrigger(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, Double_t triggerPt, Float_t triggerEta, Double_t triggerPhi, Bool_t applyEfficiency, TH1* triggerWeighting);
   void DeleteContainers();
   inline Float_t GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetInvMassSquaredCheap(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
@@ -158,12 +163,13 @@ protected:
   Float_t fTwoTrackCutMinRadius; // min radius for TTR cut
 
   Bool_t fCheckEventNumberInCorrelation; // do not correlate two particles from the same event (only works for AliBasicParticles)
+  Bool_t fUsePackedPairKernel;   // pack triggers and associated particles into contiguous arrays once per call and run the pair cuts over these arrays (same result as the default path)
 
   Long64_t fRunNumber;           // run number that has been processed
   
   Int_t fMergeCount;		// counts how many objects have been merged together
   
-  ClassDef(AliUEHistograms, 31)  // underlying event histogram container
+  ClassDef(AliUEHistograms, 32)  // underlying event histogram container
 };
 
 Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign)
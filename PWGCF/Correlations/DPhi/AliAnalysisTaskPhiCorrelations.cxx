@@ -181,7 +181,9 @@ fRemoveWeakDecaysInMC(kFALSE),
 fFillYieldRapidity(kFALSE),
 fFillCorrelationsRapidity(kFALSE),
 fUseDoublePrecision(kFALSE),
+fUsePagedStorage(kFALSE),
 fUseNewCentralityFramework(kFALSE),
+fUsePackedPairKernel(kFALSE),
 fFillpT(kFALSE),
 fJetBranchName("clustersAOD_ANTIKT04_B1_Filter00768_Cut00150_Skip00"),
 fTrackEtaMax(.9),
@@ -300,6 +302,8 @@ void  AliAnalysisTaskPhiCorrelations::CreateOutputObjects()
     histType += "C";
   if (fUseDoublePrecision)
     histType += "D";
+  if (fUsePagedStorage)
+    histType += "P";
   fHistos = new AliUEHistograms("AliUEHistogramsSame", histType, fCustomBinning);
   fHistosMixed = new AliUEHistograms("AliUEHistogramsMixed", histType, fCustomBinning);
 
@@ -343,6 +347,9 @@ void  AliAnalysisTaskPhiCorrelations::CreateOutputObjects()
   fHistos->SetTwoTrackCutMinRadius(fTwoTrackCutMinRadius);
   fHistosMixed->SetTwoTrackCutMinRadius(fTwoTrackCutMinRadius);
   
+  fHistos->SetUsePackedPairKernel(fUsePackedPairKernel);
+  fHistosMixed->SetUsePackedPairKernel(fUsePackedPairKernel);
+  
   if (fEfficiencyCorrectionTriggers)
    {
     fHistos->SetEfficiencyCorrectionTriggers(fEfficiencyCorrectionTriggers);
@@ -569,7 +576,9 @@ void  AliAnalysisTaskPhiCorrelations::AddSettingsTree()
   settingsTree->Branch("fRemoveWeakDecaysInMC", &fRemoveWeakDecaysInMC,"RemoveWeakDecaysInMC/O");
   settingsTree->Branch("fFillYieldRapidity", &fFillYieldRapidity,"fFillYieldRapidity/O");
   settingsTree->Branch("fFillCorrelationsRapidity", &fFillYieldRapidity,"fFillCorrelationsRapidity/O");
+  settingsTree->Branch("fUsePagedStorage", &fUsePagedStorage,"fUsePagedStorage/O");
   settingsTree->Branch("fUseNewCentralityFramework", &fUseNewCentralityFramework,"fUseNewCentralityFramework/O");
+  settingsTree->Branch("fUsePackedPairKernel", &fUsePackedPairKernel,"fUsePackedPairKernel/O");
   settingsTree->Branch("fTwoTrackEfficiencyCut", &fTwoTrackEfficiencyCut,"TwoTrackEfficiencyCut/D");
   settingsTree->Branch("fTwoTrackCutMinRadius", &fTwoTrackCutMinRadius,"TwoTrackCutMinRadius/D");
   
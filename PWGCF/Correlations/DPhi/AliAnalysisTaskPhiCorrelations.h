@@ -139,7 +139,9 @@ public:
   void   SetFillYieldRapidity(Bool_t flag) { fFillYieldRapidity = flag; }
   void   SetFillCorrelationsRapidity(Bool_t flag) { fFillCorrelationsRapidity = flag; }
   void   SetUseDoublePrecision(Bool_t flag) { fUseDoublePrecision = flag; }
+  void   SetUsePagedStorage(Bool_t flag) { fUsePagedStorage = flag; }
   void   SetUseNewCentralityFramework(Bool_t flag) { fUseNewCentralityFramework = flag; }
+  void   SetUsePackedPairKernel(Bool_t flag) { fUsePackedPairKernel = flag; }
 
   AliHelperPID* GetHelperPID() { return fHelperPID; }
   void   SetHelperPID(AliHelperPID* pid){ fHelperPID = pid; }
@@ -296,7 +298,9 @@ private:
   Bool_t fFillYieldRapidity;     // fill a control histogram centrality vs pT vs y
   Bool_t fFillCorrelationsRapidity; // fills correlation histograms with rapidity instead of pseudorapidity (default: kFALSE)
   Bool_t fUseDoublePrecision;    // use double precision for AliTHn
+  Bool_t fUsePagedStorage;       // use paged storage for AliTHn (only filled parts of the bin range are allocated)
   Bool_t fUseNewCentralityFramework; // use the AliMultSelection framework
+  Bool_t fUsePackedPairKernel;   // fill the correlations with the packed (contiguous array) pair kernel of AliUEHistograms
 
   Bool_t fFillpT;                // fill sum pT instead of number density
 
@@ -317,7 +321,7 @@ private:
   Bool_t                      fUsePtBinnedEventPool; // uses event pool in pt bins
   Bool_t                      fCheckEventNumberInMixedEvent; // check event number before correlation in mixed event
 
-  ClassDef(AliAnalysisTaskPhiCorrelations, 62); // Analysis task for delta phi correlations
+  ClassDef(AliAnalysisTaskPhiCorrelations, 64); // Analysis task for delta phi correlations
 };
 
 #endif
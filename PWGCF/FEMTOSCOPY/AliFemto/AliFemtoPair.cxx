@@ -712,26 +712,22 @@ void AliFemtoPair::CalcNonIdPar() const
   // Calculate generalized relative mometum
   // Use this instead of qXYZ() function when calculating
   // anything for non-identical particles
+  // The lab-frame momenta and masses are taken from the flat per-particle
+  // records, filled once per particle instead of once per pair
   fNonIdParNotCalculated=0;
-  double px1 = fTrack1->FourMomentum().vect().x();
-  double py1 = fTrack1->FourMomentum().vect().y();
-  double pz1 = fTrack1->FourMomentum().vect().z();
-  double pE1  = fTrack1->FourMomentum().e();
-  double tParticle1Mass;
-  if((pE1*pE1 - px1*px1 - py1*py1 - pz1*pz1)>0)
-    tParticle1Mass = ::sqrt(pE1*pE1 - px1*px1 - py1*py1 - pz1*pz1);
-  else
-    tParticle1Mass = 0;
-
-  double px2 = fTrack2->FourMomentum().vect().x();
-  double py2 = fTrack2->FourMomentum().vect().y();
-  double pz2 = fTrack2->FourMomentum().vect().z();
-  double pE2  = fTrack2->FourMomentum().e();
-  double tParticle2Mass;
-  if((pE2*pE2 - px2*px2 - py2*py2 - pz2*pz2)>0)
-    tParticle2Mass = ::sqrt(pE2*pE2 - px2*px2 - py2*py2 - pz2*pz2);
-  else
-    tParticle2Mass = 0;
+  const AliFemtoParticle::Kinematics &tKin1 = fTrack1->LabKinematics();
+  double px1 = tKin1.fPx;
+  double py1 = tKin1.fPy;
+  double pz1 = tKin1.fPz;
+  double pE1  = tKin1.fE;
+  double tParticle1Mass = tKin1.fMass;
+
+  const AliFemtoParticle::Kinematics &tKin2 = fTrack2->LabKinematics();
+  double px2 = tKin2.fPx;
+  double py2 = tKin2.fPy;
+  double pz2 = tKin2.fPz;
+  double pE2  = tKin2.fE;
+  double tParticle2Mass = tKin2.fMass;
 
   double tPx = px1+px2;
   double tPy = py1+py2;
@@ -5,6 +5,7 @@
 #include "AliFemtoKink.h"
 #include "AliFemtoParticle.h"
 #include "AliFemtoXi.h"
+#include "TMath.h"
 
 double AliFemtoParticle::fgPrimPimPar0 = 9.05632e-01;
 double AliFemtoParticle::fgPrimPimPar1 = -2.26737e-01;
@@ -25,6 +26,57 @@ int TpcLocalTransform(AliFmThreeVectorD &xgl,
                       float &xlocal,
                       double &ttPhi);
 
+namespace {
+  /// Number of particles allocated at once when the pool is empty
+  const size_t kParticlesPerChunk = 512;
+
+  /// Head of the list of free blocks; the first bytes of a free block
+  /// hold the pointer to the next one. Chunks are kept until the end of
+  /// the process, their number is set by the largest number of particles
+  /// alive at the same time (mixing buffer depth times multiplicity).
+  void *gFreeParticles = nullptr;
+}
+
+//_____________________
+void* AliFemtoParticle::operator new(size_t size)
+{
+  // Take a block from the particle pool
+
+  if (size != sizeof(AliFemtoParticle)) {
+    return ::operator new(size);
+  }
+
+  if (gFreeParticles == nullptr) {
+    char *chunk = static_cast<char*>(::operator new(kParticlesPerChunk * sizeof(AliFemtoParticle)));
+    // thread the blocks backwards so that they are handed out in address order
+    for (size_t i = kParticlesPerChunk; i-- > 0; ) {
+      void *block = chunk + i * sizeof(AliFemtoParticle);
+      *static_cast<void**>(block) = gFreeParticles;
+      gFreeParticles = block;
+    }
+  }
+
+  void *block = gFreeParticles;
+  gFreeParticles = *static_cast<void**>(block);
+  return block;
+}
+//_____________________
+void AliFemtoParticle::operator delete(void *ptr, size_t size)
+{
+  // Return a block to the particle pool
+
+  if (ptr == nullptr) {
+    return;
+  }
+
+  if (size != sizeof(AliFemtoParticle)) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  *static_cast<void**>(ptr) = gFreeParticles;
+  gFreeParticles = ptr;
+}
 
 //_____________________
 AliFemtoParticle::AliFemtoParticle() :
@@ -42,7 +94,14 @@ AliFemtoParticle::AliFemtoParticle() :
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fKinematics(),
+  fKinematicsCalculated(false),
+  fPhiStarShifts(),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0),
+  fPhiStarStep(0)
 {
   // Default constructor
   std::fill_n(fPurity, 6, 0.0);
@@ -63,7 +122,14 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoParticle &aParticle):
   fTpcV0PosExitPoint(aParticle.fTpcV0PosExitPoint),
   fHelixV0Neg(aParticle.fHelixV0Neg),
   fTpcV0NegEntrancePoint(aParticle.fTpcV0NegEntrancePoint),
-  fTpcV0NegExitPoint(aParticle.fTpcV0NegExitPoint)
+  fTpcV0NegExitPoint(aParticle.fTpcV0NegExitPoint),
+  fKinematics(),
+  fKinematicsCalculated(false),
+  fPhiStarShifts(),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0),
+  fPhiStarStep(0)
 {
   // Copy constructor
   memcpy(fPurity, aParticle.fPurity, sizeof(fPurity));
@@ -106,7 +172,14 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoTrack *const hbtTrack, const do
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fKinematics(),
+  fKinematicsCalculated(false),
+  fPhiStarShifts(),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0),
+  fPhiStarStep(0)
 {
   // Constructor from normal track
   /* TO JA ODZNACZYLEM NIE WIEM DLACZEGO
@@ -140,7 +213,14 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoV0 *const hbtV0, const double &
   fTpcV0PosExitPoint(),
   fHelixV0Neg(hbtV0->HelixNeg()),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fKinematics(),
+  fKinematicsCalculated(false),
+  fPhiStarShifts(),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0),
+  fPhiStarStep(0)
 {
   // Constructor from V0
 
@@ -167,7 +247,14 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoKink *const hbtKink, const doub
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fKinematics(),
+  fKinematicsCalculated(false),
+  fPhiStarShifts(),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0),
+  fPhiStarStep(0)
 {
   // Constructor from Kink
   for (int ip = 0; ip < 6; ip++) fPurity[ip] = 0.0;
@@ -191,7 +278,14 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoXi *const hbtXi, const double &
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fKinematics(),
+  fKinematicsCalculated(false),
+  fPhiStarShifts(),
+  fPhiStarMagSign(0),
+  fPhiStarMinRad(0),
+  fPhiStarMaxRad(0),
+  fPhiStarStep(0)
 {
   // Constructor from Xi
   for (int ip = 0; ip < 6; ip++) fPurity[ip] = 0.0;
@@ -280,8 +374,69 @@ AliFemtoParticle &AliFemtoParticle::operator=(const AliFemtoParticle &aParticle)
   fTpcV0NegEntrancePoint = aParticle.fTpcV0NegEntrancePoint;
   fTpcV0NegExitPoint = aParticle.fTpcV0NegExitPoint;
 
+  ResetCachedKinematics();
+
   return *this;
 }
+//_____________________
+void AliFemtoParticle::CalculateKinematics() const
+{
+  // fill the flat lab-frame record from the four-momentum
+
+  fKinematics.fPx = fFourMomentum.vect().x();
+  fKinematics.fPy = fFourMomentum.vect().y();
+  fKinematics.fPz = fFourMomentum.vect().z();
+  fKinematics.fE = fFourMomentum.e();
+
+  const double m2 = fKinematics.fE * fKinematics.fE
+                  - fKinematics.fPx * fKinematics.fPx
+                  - fKinematics.fPy * fKinematics.fPy
+                  - fKinematics.fPz * fKinematics.fPz;
+  fKinematics.fMass = (m2 > 0) ? ::sqrt(m2) : 0;
+
+  fKinematicsCalculated = true;
+}
+//_____________________
+void AliFemtoParticle::ResetCachedKinematics()
+{
+  // forget everything derived from the momentum
+  fKinematicsCalculated = false;
+  fPhiStarShifts.clear();
+  fPhiStarStep = 0;
+}
+//_____________________
+const std::vector<double>& AliFemtoParticle::PhiStarShifts(double magSign, double minRad, double maxRad, double step) const
+{
+  // phi* bending terms of the track at radii minRad, minRad+step, ... < maxRad.
+  // The radii are accumulated exactly like in the pair cut loops, so that
+  // the i-th entry belongs to the i-th radius there.
+
+  if (step > 0
+      && magSign == fPhiStarMagSign
+      && minRad == fPhiStarMinRad
+      && maxRad == fPhiStarMaxRad
+      && step == fPhiStarStep) {
+    return fPhiStarShifts;
+  }
+
+  fPhiStarShifts.clear();
+  fPhiStarMagSign = magSign;
+  fPhiStarMinRad = minRad;
+  fPhiStarMaxRad = maxRad;
+  fPhiStarStep = step;
+
+  if (!fTrack || step <= 0) {
+    return fPhiStarShifts;
+  }
+
+  const double chg = fTrack->Charge();
+  const double pt = fTrack->Pt();
+  for (double rad = minRad; rad < maxRad; rad += step) {
+    fPhiStarShifts.push_back(TMath::ASin(-0.075 * chg * magSign * rad / pt));
+  }
+
+  return fPhiStarShifts;
+}
 // //_____________________
 // const AliFemtoThreeVector& AliFemtoParticle::NominalTpcExitPoint() const{
 //   // in future, may want to calculate this "on demand" only, sot this routine may get more sophisticated
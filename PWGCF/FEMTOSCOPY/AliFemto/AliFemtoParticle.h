@@ -17,6 +17,8 @@
 #include "AliFemtoXi.h"
 #include "AliFmPhysicalHelixD.h"
 
+#include <vector>
+
 // ***
 class AliFemtoHiddenInfo;
 // ***
@@ -33,6 +35,14 @@ public:
 
   AliFemtoParticle &operator=(const AliFemtoParticle &aParticle);
 
+  /// Particles are allocated from a pool of fixed-size blocks. Blocks of
+  /// deleted particles (e.g. of events leaving the mixing buffer) are
+  /// handed out again to the particles of the next events, so that the
+  /// particles of one event are close in memory and no malloc is needed
+  /// per particle. The pool is not thread safe.
+  static void* operator new(size_t size);
+  static void operator delete(void *ptr, size_t size);
+
   const AliFemtoLorentzVector& FourMomentum() const;
 
   AliFmPhysicalHelixD& Helix();
@@ -64,6 +74,24 @@ public:
 
   void ResetFourMomentum(const AliFemtoLorentzVector &fourMomentum);
 
+  /// Lab-frame four-momentum and mass in a flat record, computed once per
+  /// particle. Pair kinematics (see AliFemtoPair::CalcNonIdPar) are
+  /// evaluated from two of these records.
+  struct Kinematics {
+    double fPx;   ///< momentum x
+    double fPy;   ///< momentum y
+    double fPz;   ///< momentum z
+    double fE;    ///< energy
+    double fMass; ///< sqrt(E^2-p^2), 0 if not positive
+  };
+  const Kinematics& LabKinematics() const;
+
+  /// Bending term asin(-0.075 q B r / pT) of phi* = phi + asin(...) of the
+  /// track at the radii r = minRad, minRad+step, ... < maxRad [m]. Computed
+  /// once per particle, as long as the same field sign and radii are asked
+  /// for. Only for particles made of tracks.
+  const std::vector<double>& PhiStarShifts(double magSign, double minRad, double maxRad, double step) const;
+
   const AliFemtoHiddenInfo* HiddenInfo() const;
 
   AliFemtoHiddenInfo* GetHiddenInfo() const;
@@ -126,6 +154,17 @@ private:
   AliFmPhysicalHelixD fHelixV0Neg;            // helix for negative V0 daughter
   AliFemtoThreeVector fTpcV0NegEntrancePoint; // negative V0 daughter entrance point to TPC
   AliFemtoThreeVector fTpcV0NegExitPoint;     // negative V0 daughter exit point from TPC
+
+  void CalculateKinematics() const;
+  void ResetCachedKinematics();
+
+  mutable Kinematics fKinematics;             // lab-frame kinematics
+  mutable bool fKinematicsCalculated;         // fKinematics is up to date
+  mutable std::vector<double> fPhiStarShifts; // phi* bending terms at the radii below
+  mutable double fPhiStarMagSign;             // field sign of fPhiStarShifts
+  mutable double fPhiStarMinRad;              // first radius of fPhiStarShifts
+  mutable double fPhiStarMaxRad;              // upper radius limit of fPhiStarShifts
+  mutable double fPhiStarStep;                // radius step of fPhiStarShifts
 };
 
 inline AliFemtoTrack *AliFemtoParticle::Track() const
@@ -197,6 +236,13 @@ inline void AliFemtoParticle::SetHiddenInfo(AliFemtoHiddenInfo *aHiddenInfo)
 inline void AliFemtoParticle::ResetFourMomentum(const AliFemtoLorentzVector &vec)
 {
   fFourMomentum = vec;
+  fKinematicsCalculated = false;
+}
+
+inline const AliFemtoParticle::Kinematics& AliFemtoParticle::LabKinematics() const
+{
+  if (!fKinematicsCalculated) CalculateKinematics();
+  return fKinematics;
 }
 
 inline AliFemtoKink *AliFemtoParticle::Kink() const
@@ -29,20 +29,24 @@
 #ifndef AliFemtoParticleCollection_hh
 #define AliFemtoParticleCollection_hh
 #include "AliFemtoParticle.h"
-#include <list>
+#include <vector>
+
+// The particles of a picoEvent are stored contiguously: pair loops walk a
+// vector of pointers instead of chasing list nodes, and the particles
+// themselves come from the AliFemtoParticle pool (see AliFemtoParticle.h).
 
 #if !defined(ST_NO_NAMESPACES)
-using std::list;
+using std::vector;
 #endif
 
 #ifdef ST_NO_TEMPLATE_DEF_ARGS
-typedef list<AliFemtoParticle *, allocator<AliFemtoParticle *> >            AliFemtoParticleCollection;
-typedef list<AliFemtoParticle *, allocator<AliFemtoParticle *> >::iterator  AliFemtoParticleIterator;
-typedef list<AliFemtoParticle *, allocator<AliFemtoParticle *> >::const_iterator  AliFemtoParticleConstIterator;
+typedef vector<AliFemtoParticle *, allocator<AliFemtoParticle *> >            AliFemtoParticleCollection;
+typedef vector<AliFemtoParticle *, allocator<AliFemtoParticle *> >::iterator  AliFemtoParticleIterator;
+typedef vector<AliFemtoParticle *, allocator<AliFemtoParticle *> >::const_iterator  AliFemtoParticleConstIterator;
 #else
-typedef list<AliFemtoParticle *>            AliFemtoParticleCollection;
-typedef list<AliFemtoParticle *>::iterator  AliFemtoParticleIterator;
-typedef list<AliFemtoParticle *>::const_iterator  AliFemtoParticleConstIterator;
+typedef vector<AliFemtoParticle *>            AliFemtoParticleCollection;
+typedef vector<AliFemtoParticle *>::iterator  AliFemtoParticleIterator;
+typedef vector<AliFemtoParticle *>::const_iterator  AliFemtoParticleConstIterator;
 #endif
 
 #endif
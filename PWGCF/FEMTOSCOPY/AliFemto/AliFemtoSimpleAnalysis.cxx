@@ -535,7 +535,7 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
     collection2 = nullptr;
   }
 
-  MakePairs("real", collection1, collection2, EnablePairMonitors());
+  MakePairs(kRealPairs, collection1, collection2, EnablePairMonitors());
 
   if (fVerbose) {
     cout << "AliFemtoSimpleAnalysis::ProcessEvent() - reals done ";
@@ -546,15 +546,15 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
 
     // If identical - only mix the first particle collections
     if (AnalyzeIdenticalParticles()) {
-      MakePairs("mixed", collection1, storedEvent->FirstParticleCollection());
+      MakePairs(kMixedPairs, collection1, storedEvent->FirstParticleCollection());
 
     // If non-identical - mix both combinations of first and second particles
     } else {
-        MakePairs("mixed", collection1,
-                           storedEvent->SecondParticleCollection());
+        MakePairs(kMixedPairs, collection1,
+                               storedEvent->SecondParticleCollection());
 
-        MakePairs("mixed", storedEvent->FirstParticleCollection(),
-                           collection2);
+        MakePairs(kMixedPairs, storedEvent->FirstParticleCollection(),
+                               collection2);
     }
   }
 
@@ -587,92 +587,99 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
 
   const string type = typeIn;
 
-  //  int swpart = ((long int) partCollection1) % 2;
+  if (type == "real") {
+    MakePairs(kRealPairs, partCollection1, partCollection2, enablePairMonitors);
+  } else if (type == "mixed") {
+    MakePairs(kMixedPairs, partCollection1, partCollection2, enablePairMonitors);
+  } else {
+    cout << "Problem with pair type, type = " << type << endl;
+  }
+}
+//_________________________
+void AliFemtoSimpleAnalysis::MakePairs(EPairType type,
+                                       AliFemtoParticleCollection *partCollection1,
+                                       AliFemtoParticleCollection *partCollection2,
+                                       Bool_t enablePairMonitors)
+{
+/// Build pairs, check pair cuts, and call CFs' AddRealPair() or
+/// AddMixedPair() methods. If no second particle collection is
+/// specfied, make pairs within first particle collection.
+
+  if (type == kRealPairs) {
+    MakePairsOfType<kRealPairs>(partCollection1, partCollection2, enablePairMonitors);
+  } else {
+    MakePairsOfType<kMixedPairs>(partCollection1, partCollection2, enablePairMonitors);
+  }
+}
+//_________________________
+template <AliFemtoSimpleAnalysis::EPairType TYPE>
+void AliFemtoSimpleAnalysis::MakePairsOfType(AliFemtoParticleCollection *partCollection1,
+                                             AliFemtoParticleCollection *partCollection2,
+                                             Bool_t enablePairMonitors)
+{
+/// Pair loop over the contiguous particle collections. The choice between
+/// AddRealPair and AddMixedPair is a template parameter, so the per-pair
+/// code does not test the pair type.
 
   // Used to swap particle 1 & 2 in identical-particle analysis
   // to avoid any implicit ordering in the event collection
   // "Seed" this here.
   bool swpart = fNeventsProcessed % 2;
 
-  // Setup iterator ranges
-  //
-  // The outer loop alway starts at beginning of particle collection 1.
-  // * If we are iterating over both particle collections, then the loop simply
-  // runs through both from beginning to end.
-  // * If we are only iterating over one particle collection, the inner loop
-  // loops over all particles between the outer iterator and the end of the
-  // collection. The outer loop must skip the last entry of the list.
-  AliFemtoParticleConstIterator tStartOuterLoop = partCollection1->begin(),
-                                tEndOuterLoop = partCollection1->end(),
-                                tStartInnerLoop,
-                                tEndInnerLoop;
-
-  if (partCollection2) {                         // Two collections:
-    tStartInnerLoop = partCollection2->begin();  //   Full inner & outer loops
-    tEndInnerLoop   = partCollection2->end();    //
-  }
-  else {                                         // One collection:
-    tEndOuterLoop--;                             //   Outer loop goes to next-to-last particle
-    tEndInnerLoop = partCollection1->end() ;     //   Inner loop goes to last particle
-  }
-
   // Create the pair outside the loop - only allocate once
   AliFemtoPair* tPair = new AliFemtoPair;
 
-  // Begin the outer loop
-  for (AliFemtoParticleConstIterator tPartIter1 = tStartOuterLoop;
-                                     tPartIter1 != tEndOuterLoop;
-                                     ++tPartIter1) {
+  // check the pair cut and, if passed, hand the pair to all CFs
+  auto processPair = [&] () {
+    const bool tmpPassPair = fPairCut->Pass(tPair);
 
-    // If analyzing identical particles, start inner loop at the particle
-    // after the current outer loop position, (loops until end)
-    if (!partCollection2) {
-      tStartInnerLoop = tPartIter1;
-      tStartInnerLoop++;
+    // This is a condition for speed reasons
+    if (enablePairMonitors) {
+      fPairCut->FillCutMonitor(tPair, tmpPassPair);
     }
 
-    // If we have two collections - set the first track
-    if (partCollection2 != nullptr) {
-      tPair->SetTrack1(*tPartIter1);
+    if (!tmpPassPair) {
+      return;
     }
 
-    // Begin the inner loop
-    for (AliFemtoParticleConstIterator tPartIter2 = tStartInnerLoop;
-                                       tPartIter2 != tEndInnerLoop;
-                                     ++tPartIter2) {
-      // If we have two collections - only set the second track
-      if (partCollection2 != nullptr) {
-        tPair->SetTrack2(*tPartIter2);
-
-      // Swap between first and second particles to avoid biased ordering
+    for (auto &tCorrFctn : *fCorrFctnCollection) {
+      if (TYPE == kRealPairs) {
+        tCorrFctn->AddRealPair(tPair);
       } else {
-        tPair->SetTrack1(swpart ? *tPartIter2 : *tPartIter1);
-        tPair->SetTrack2(swpart ? *tPartIter1 : *tPartIter2);
-        swpart = !swpart;
+        tCorrFctn->AddMixedPair(tPair);
       }
+    }
+  };
 
-      // check if the pair passes the cut
-      bool tmpPassPair = fPairCut->Pass(tPair);
+  AliFemtoParticle *const *particles1 = partCollection1->data();
+  const size_t nParticles1 = partCollection1->size();
 
-      // This is a condition for speed reasons
-      if (enablePairMonitors) {
-        fPairCut->FillCutMonitor(tPair, tmpPassPair);
-      }
+  if (partCollection2) {
+    // Two collections: full inner & outer loops
+    AliFemtoParticle *const *particles2 = partCollection2->data();
+    const size_t nParticles2 = partCollection2->size();
 
-      // If pair passes cut, loop over CF's and add pair to real/mixed
-      if (tmpPassPair) {
-        for (auto &tCorrFctn : *fCorrFctnCollection) {
-          if (type == "real")
-            tCorrFctn->AddRealPair(tPair);
-          else if(type == "mixed")
-            tCorrFctn->AddMixedPair(tPair);
-          else
-            cout << "Problem with pair type, type = " << type << endl;
-        } // loop over corellatoin functions
+    for (size_t i = 0; i < nParticles1; ++i) {
+      tPair->SetTrack1(particles1[i]);
+      for (size_t j = 0; j < nParticles2; ++j) {
+        tPair->SetTrack2(particles2[j]);
+        processPair();
       }
-
-    }    // loop over second particle
-  }      // loop over first particle
+    }
+  }
+  else {
+    // One collection: the inner loop runs over the particles after the
+    // current outer one, swapping first and second particles to avoid
+    // biased ordering
+    for (size_t i = 0; i + 1 < nParticles1; ++i) {
+      for (size_t j = i + 1; j < nParticles1; ++j) {
+        tPair->SetTrack1(swpart ? particles1[j] : particles1[i]);
+        tPair->SetTrack2(swpart ? particles1[i] : particles1[j]);
+        swpart = !swpart;
+        processPair();
+      }
+    }
+  }
 
   // we are done with the pair
   delete tPair;
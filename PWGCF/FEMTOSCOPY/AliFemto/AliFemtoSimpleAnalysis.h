@@ -159,6 +159,24 @@ protected:
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// Which correlation function method receives the pairs
+  enum EPairType { kRealPairs,   ///< AddRealPair
+                   kMixedPairs   ///< AddMixedPair
+                 };
+
+  /// Same as above, with the pair type given as enum. The type is resolved
+  /// once per call instead of once per pair and correlation function.
+  void MakePairs(EPairType type,
+                 AliFemtoParticleCollection* ParticlesPassingCut1,
+                 AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
+                 Bool_t enablePairMonitors=kFALSE);
+
+  /// Pair loop for a pair type known at compile time
+  template <EPairType TYPE>
+  void MakePairsOfType(AliFemtoParticleCollection* ParticlesPassingCut1,
+                       AliFemtoParticleCollection* ParticlesPssingCut2,
+                       Bool_t enablePairMonitors);
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
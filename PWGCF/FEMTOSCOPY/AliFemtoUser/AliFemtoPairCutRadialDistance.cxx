@@ -17,6 +17,7 @@
 #include "AliFemtoPairCutRadialDistance.h"
 #include <string>
 #include <cstdio>
+#include <algorithm>
 
 #ifdef __ROOT__
 ClassImp(AliFemtoPairCutRadialDistance)
@@ -117,14 +118,21 @@ bool AliFemtoPairCutRadialDistance::Pass(const AliFemtoPair* pair){
   rad = fMinRad;
 
   if (fPhistarmin) {
-    for (rad = fMinRad; rad < fMaxRad; rad += 0.01) {
-      Double_t dps = (phi2-phi1+(TMath::ASin(-0.075*chg2*fMagSign*rad/ptv2))-(TMath::ASin(-0.075*chg1*fMagSign*rad/ptv1)));
-      dps = TVector2::Phi_mpi_pi(dps);
-      Double_t etad = eta2 - eta1;
-      if (fabs(etad)<fEtaMin && fabs(dps)<fDPhiStarMin) {
-        // cout << "5% cut is not passed - returning" << endl;
-        pass5 = kFALSE;
-        break;
+    // eta does not depend on the radius, only pairs close in eta need the scan
+    Double_t etad = eta2 - eta1;
+    if (fabs(etad)<fEtaMin) {
+      // bending terms of phi* at each radius, computed once per particle
+      const std::vector<double> &shifts1 = pair->Track1()->PhiStarShifts(fMagSign, fMinRad, fMaxRad, 0.01);
+      const std::vector<double> &shifts2 = pair->Track2()->PhiStarShifts(fMagSign, fMinRad, fMaxRad, 0.01);
+      const size_t nrad = std::min(shifts1.size(), shifts2.size());
+      for (size_t irad = 0; irad < nrad; irad++) {
+        Double_t dps = (phi2-phi1+shifts2[irad]-shifts1[irad]);
+        dps = TVector2::Phi_mpi_pi(dps);
+        if (fabs(dps)<fDPhiStarMin) {
+          // cout << "5% cut is not passed - returning" << endl;
+          pass5 = kFALSE;
+          break;
+        }
       }
     }
   }
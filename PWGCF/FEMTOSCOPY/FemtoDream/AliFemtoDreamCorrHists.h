@@ -21,6 +21,13 @@ class AliFemtoDreamCorrHists {
   virtual ~AliFemtoDreamCorrHists();
   void FillSameEventDist(int i,double RelK){fSameEventDist[i]->Fill(RelK);};
   void FillMixedEventDist(int i,double RelK){fMixedEventDist[i]->Fill(RelK);};
+  //Fill nPairs values of k* at once
+  void FillSameEventDist(int i,int nPairs,const double *RelK){
+    if (nPairs>0) fSameEventDist[i]->FillN(nPairs,RelK,0);
+  }
+  void FillMixedEventDist(int i,int nPairs,const double *RelK){
+    if (nPairs>0) fMixedEventDist[i]->FillN(nPairs,RelK,0);
+  }
   void FillPartnersSE(int hist,int nPart1,int nPart2){
     fPairCounterSE[hist]->Fill(nPart1,nPart2);
   }
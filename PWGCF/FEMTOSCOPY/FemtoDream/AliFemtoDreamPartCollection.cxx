@@ -63,6 +63,18 @@ void AliFemtoDreamPartCollection::PrintEvent(int ZVtx,int Mult) {
   return;
 }
 
+void AliFemtoDreamPartCollection::SetMixingDepth(int ZVtx,int Mult,
+                                                 int MixingDepth) {
+  //Overrides the mixing depth of the configuration for one zVtx/Mult bin
+  if (ZVtx<0||ZVtx>=(int)fZVtxMultBuffer.size()) {
+    return;
+  }
+  if (Mult<0||Mult>=(int)fZVtxMultBuffer[ZVtx].size()) {
+    return;
+  }
+  fZVtxMultBuffer[ZVtx][Mult].SetMixingDepth(MixingDepth);
+}
+
 void AliFemtoDreamPartCollection::FindBin(double ZVtxPos,double Multiplicity,
                                           int *returnBins) {
   returnBins[0]=-99;
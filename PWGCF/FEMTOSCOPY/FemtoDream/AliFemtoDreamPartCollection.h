@@ -25,6 +25,7 @@ class AliFemtoDreamPartCollection {
   void SetEvent(std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
                 double ZVtx,double Mult);
   void PrintEvent(int ZVtx,int Mult);
+  void SetMixingDepth(int ZVtx,int Mult,int MixingDepth);
   TList* GetHistList(){return fResults->GetHistList();};
   TList* GetQAList(){return fResults->GetQAHists();};
  private:
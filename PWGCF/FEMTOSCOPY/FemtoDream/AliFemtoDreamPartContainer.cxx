@@ -12,14 +12,20 @@
 #include "TVector3.h"
 ClassImp(AliFemtoDreamPartContainer)
 AliFemtoDreamPartContainer::AliFemtoDreamPartContainer() : fPartBuffer(),
-    fMixingDepth(0)
+    fMomentumBuffer(),
+    fMixingDepth(0),
+    fHead(0),
+    fNEvents(0)
 {
 
 }
 
 AliFemtoDreamPartContainer::AliFemtoDreamPartContainer(int MixingDepth)
-:fPartBuffer(),
- fMixingDepth(MixingDepth)
+:fPartBuffer(MixingDepth>0?MixingDepth:0)
+,fMomentumBuffer(MixingDepth>0?MixingDepth:0)
+,fMixingDepth(MixingDepth>0?MixingDepth:0)
+,fHead(0)
+,fNEvents(0)
 {
 
 }
@@ -29,15 +35,11 @@ AliFemtoDreamPartContainer& AliFemtoDreamPartContainer::operator=(
   if(this == &obj){
     return *this;
   }
-//  std::deque<std::deque<AliFemtoDreamBasePart>>::iterator copyIter;
-//  std::deque<std::deque<AliFemtoDreamBasePart>>::iterator objIter;
-//  for (objIter=obj.fPartBuffer.begin();objIter!=obj.fPartBuffer.end();
-//      ++objIter)
-//  {
-//
-//  }
   this->fMixingDepth=obj.fMixingDepth;
   this->fPartBuffer=obj.fPartBuffer;
+  this->fMomentumBuffer=obj.fMomentumBuffer;
+  this->fHead=obj.fHead;
+  this->fNEvents=obj.fNEvents;
   return (*this);
 }
 
@@ -47,22 +49,71 @@ AliFemtoDreamPartContainer::~AliFemtoDreamPartContainer() {
 void AliFemtoDreamPartContainer::SetEvent(
     std::vector<AliFemtoDreamBasePart> &Particles)
 {
-  if (!(fPartBuffer.size() < fMixingDepth)){
-//    std::cout << "Popping Front" << std::endl;
-    fPartBuffer.pop_front();
+  //The new event replaces the oldest one in its slot, the storage of the slot
+  //is reused, nothing else in the buffer is moved.
+  if (fMixingDepth==0) {
+    return;
+  }
+  fPartBuffer[fHead]=Particles;
+  FillMomenta(Particles,fMomentumBuffer[fHead]);
+  fHead=(fHead+1)%fMixingDepth;
+  if (fNEvents<fMixingDepth) {
+    ++fNEvents;
   }
-  fPartBuffer.push_back(Particles);
-//  std::cout << "PartBuffer Size: "<<fPartBuffer.size()<<'\t'<<"Input Size: "
-//      << Particles.size() << '\n';
   return;
 }
 
+void AliFemtoDreamPartContainer::SetMixingDepth(int MixingDepth) {
+  //Changes the number of slots, the most recent events are kept.
+  unsigned int newDepth=MixingDepth>0?MixingDepth:0;
+  unsigned int nKeep=fNEvents<newDepth?fNEvents:newDepth;
+  std::vector<std::vector<AliFemtoDreamBasePart>> partBuffer(newDepth);
+  std::vector<std::vector<float>> momentumBuffer(newDepth);
+  for (unsigned int iEvt=0;iEvt<nKeep;++iEvt) {
+    unsigned int iSlot=Slot(fNEvents-nKeep+iEvt);
+    partBuffer[iEvt].swap(fPartBuffer[iSlot]);
+    momentumBuffer[iEvt].swap(fMomentumBuffer[iSlot]);
+  }
+  fPartBuffer.swap(partBuffer);
+  fMomentumBuffer.swap(momentumBuffer);
+  fMixingDepth=newDepth;
+  fNEvents=nKeep;
+  fHead=newDepth>0?nKeep%newDepth:0;
+}
+
+void AliFemtoDreamPartContainer::FillMomenta(
+    const std::vector<AliFemtoDreamBasePart> &Particles,
+    std::vector<float> &Momenta)
+{
+  //Flat layout: px of all particles, then py, then pz
+  const unsigned int nPart=Particles.size();
+  Momenta.resize(3*nPart);
+  float *px=Momenta.data();
+  float *py=px+nPart;
+  float *pz=py+nPart;
+  for (unsigned int iPart=0;iPart<nPart;++iPart) {
+    const TVector3 &P=Particles[iPart].GetMomentum();
+    px[iPart]=P.X();
+    py[iPart]=P.Y();
+    pz[iPart]=P.Z();
+  }
+}
+
+std::deque<std::vector<AliFemtoDreamBasePart>>
+AliFemtoDreamPartContainer::GetEventBuffer() const {
+  std::deque<std::vector<AliFemtoDreamBasePart>> buffer;
+  for (unsigned int iEvt=0;iEvt<fNEvents;++iEvt) {
+    buffer.push_back(fPartBuffer[Slot(iEvt)]);
+  }
+  return buffer;
+}
+
 void AliFemtoDreamPartContainer::PrintLastEvent() {
-  for (std::deque<std::vector<AliFemtoDreamBasePart>>::iterator itEvt=
-      fPartBuffer.begin(); itEvt!=fPartBuffer.end();++itEvt) {
-    std::cout << "Printing Last Event with size: "<<itEvt->size() << '\n';
-    for (std::vector<AliFemtoDreamBasePart>::iterator itPart=itEvt->begin();
-        itPart!=itEvt->end();++itPart) {
+  for (unsigned int iEvt=0;iEvt<fNEvents;++iEvt) {
+    std::vector<AliFemtoDreamBasePart> &Evt=fPartBuffer[Slot(iEvt)];
+    std::cout << "Printing Last Event with size: "<<Evt.size() << '\n';
+    for (std::vector<AliFemtoDreamBasePart>::iterator itPart=Evt.begin();
+        itPart!=Evt.end();++itPart) {
       TVector3 P(itPart->GetMomentum());
       std::cout<<"Px: "<<P.X()<<'\t'<<"Py: "<<P.Y()<<'\t'<<"Pz: "<<
           P.Z()<<std::endl;
@@ -70,7 +121,5 @@ void AliFemtoDreamPartContainer::PrintLastEvent() {
   }
 }
 std::vector<AliFemtoDreamBasePart> &AliFemtoDreamPartContainer::GetEvent(int Depth) {
-  std::deque<std::vector<AliFemtoDreamBasePart>>::iterator itEvt=
-        fPartBuffer.begin()+Depth;
-  return *itEvt;
+  return fPartBuffer[Slot(Depth)];
 }
@@ -16,6 +16,10 @@
 //Class Containing the Particles from previous Events up to a certain mixing
 //depth for one Particle Species and Mult/ZVtx Bin
 //ZVtx bin.
+//The events are kept in a ring of fMixingDepth slots, a new event overwrites
+//the oldest one in place. Next to the particles the momenta of each event are
+//stored as flat float arrays (all px, then all py, then all pz) for the pair
+//loops of the mixed event distribution.
 class AliFemtoDreamPartContainer {
  public:
   AliFemtoDreamPartContainer();
@@ -24,14 +28,30 @@ class AliFemtoDreamPartContainer {
   virtual ~AliFemtoDreamPartContainer();
   void PrintLastEvent();
   void SetEvent(std::vector<AliFemtoDreamBasePart> &Particles);
-  std::deque<std::vector<AliFemtoDreamBasePart>> GetEventBuffer()
-      const {return fPartBuffer;};
+  void SetMixingDepth(int MixingDepth);
+  std::deque<std::vector<AliFemtoDreamBasePart>> GetEventBuffer() const;
+  //Depth 0 is the oldest event in the buffer
   std::vector<AliFemtoDreamBasePart> &GetEvent(int Depth);
-  unsigned int GetMixingDepth() const {return fPartBuffer.size();};
+  unsigned int GetEventSize(int Depth) const {
+    return fPartBuffer[Slot(Depth)].size();
+  };
+  const float *GetMomenta(int Depth) const {
+    return fMomentumBuffer[Slot(Depth)].data();
+  };
+  unsigned int GetMixingDepth() const {return fNEvents;};
+  unsigned int GetMaxMixingDepth() const {return fMixingDepth;};
+  static void FillMomenta(const std::vector<AliFemtoDreamBasePart> &Particles,
+                          std::vector<float> &Momenta);
  private:
-  std::deque<std::vector<AliFemtoDreamBasePart>> fPartBuffer;
+  unsigned int Slot(int Depth) const {
+    return (fHead+fMixingDepth-fNEvents+Depth)%fMixingDepth;
+  };
+  std::vector<std::vector<AliFemtoDreamBasePart>> fPartBuffer;
+  std::vector<std::vector<float>> fMomentumBuffer;
   unsigned int fMixingDepth;
-  ClassDef(AliFemtoDreamPartContainer,1);
+  unsigned int fHead;
+  unsigned int fNEvents;
+  ClassDef(AliFemtoDreamPartContainer,2);
 };
 
 #endif /* ALIFEMTODREAMPARTCONTAINER_H_ */
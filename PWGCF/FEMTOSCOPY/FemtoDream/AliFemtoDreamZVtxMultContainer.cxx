@@ -7,12 +7,15 @@
 //#include "AliLog.h"
 #include <iostream>
 #include "AliFemtoDreamZVtxMultContainer.h"
-#include "TLorentzVector.h"
 #include "TDatabasePDG.h"
+#include "TMath.h"
 ClassImp(AliFemtoDreamPartContainer)
 AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer()
 :fPartContainer(0),
- fPDGParticleSpecies(0)
+ fPDGParticleSpecies(0),
+ fMasses(0),
+ fMomenta(0),
+ fRelK(0)
 {
 
 }
@@ -22,15 +25,51 @@ AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer(
 :fPartContainer(conf->GetNParticles(),
                 AliFemtoDreamPartContainer(conf->GetMixingDepth()))
 ,fPDGParticleSpecies(conf->GetPDGCodes())
+,fMasses(0)
+,fMomenta(0)
+,fRelK(0)
 {
   std::cout<<"Number of Particles: "<<conf->GetNParticles()<<
       "MixingDepth: "<<conf->GetMixingDepth()<<std::endl;
+  SetMasses();
 }
 
 AliFemtoDreamZVtxMultContainer::~AliFemtoDreamZVtxMultContainer() {
   // TODO Auto-generated destructor stub
 }
 
+void AliFemtoDreamZVtxMultContainer::SetMasses() {
+  //The masses are looked up once instead of for every pair
+  fMasses.resize(fPDGParticleSpecies.size());
+  for (unsigned int iSpec=0;iSpec<fPDGParticleSpecies.size();++iSpec) {
+    TParticlePDG *part=
+        TDatabasePDG::Instance()->GetParticle(fPDGParticleSpecies[iSpec]);
+    if (!part) {
+      AliError("Invalid PDG Code");
+      fMasses[iSpec]=0.;
+    } else {
+      fMasses[iSpec]=part->Mass();
+    }
+  }
+}
+
+void AliFemtoDreamZVtxMultContainer::SetMixingDepth(int MixingDepth) {
+  //Mixing depth of this zVtx/Mult bin, the most recent events are kept
+  for (auto itContainer=fPartContainer.begin();
+      itContainer!=fPartContainer.end();++itContainer) {
+    itContainer->SetMixingDepth(MixingDepth);
+  }
+}
+
+void AliFemtoDreamZVtxMultContainer::FillMomenta(
+    std::vector<std::vector<AliFemtoDreamBasePart>> &Particles)
+{
+  fMomenta.resize(Particles.size());
+  for (unsigned int iSpec=0;iSpec<Particles.size();++iSpec) {
+    AliFemtoDreamPartContainer::FillMomenta(Particles[iSpec],fMomenta[iSpec]);
+  }
+}
+
 void AliFemtoDreamZVtxMultContainer::SetEvent(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles)
 {
@@ -59,39 +98,36 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
     AliFemtoDreamCorrHists *ResultsHist)
 {
-  double RelativeK = 0;
-  int _intSpec1 = 0;
+  FillMomenta(Particles);
+  const int nSpecies=Particles.size();
   int HistCounter=0;
   //First loop over all the different Species
- auto itPDGPar1 = fPDGParticleSpecies.begin();
-  for (auto itSpec1=Particles.begin();itSpec1!=Particles.end();++itSpec1) {
-    auto itPDGPar2 = fPDGParticleSpecies.begin();
-    itPDGPar2+=itSpec1-Particles.begin();
-    int _intSpec2 = itSpec1-Particles.begin();
-    for (auto itSpec2=itSpec1;itSpec2!=Particles.end();++itSpec2) {
-      ResultsHist->FillPartnersSE(HistCounter,itSpec1->size(),itSpec2->size());
-      //Now loop over the actual Particles and correlate them
-      for (auto itPart1=itSpec1->begin();itPart1!=itSpec1->end();++itPart1) {
-        std::vector<AliFemtoDreamBasePart>::iterator itPart2;
-        if (itSpec1==itSpec2) {
-          itPart2=itPart1+1;
-        } else {
-          itPart2=itSpec2->begin();
-        }
-        while (itPart2!=itSpec2->end()) {
-          RelativeK=RelativePairMomentum(itPart1->GetMomentum(),*itPDGPar1,
-                                         itPart2->GetMomentum(),
-                                         *itPDGPar2);
-          ResultsHist->FillSameEventDist(HistCounter,RelativeK);
-          ++itPart2;
-        }
+  for (int iSpec1=0;iSpec1<nSpecies;++iSpec1) {
+    const int nPart1=Particles[iSpec1].size();
+    const float *Px1=fMomenta[iSpec1].data();
+    const float *Py1=Px1+nPart1;
+    const float *Pz1=Py1+nPart1;
+    for (int iSpec2=iSpec1;iSpec2<nSpecies;++iSpec2) {
+      const int nPart2=Particles[iSpec2].size();
+      const float *Px2=fMomenta[iSpec2].data();
+      const float *Py2=Px2+nPart2;
+      const float *Pz2=Py2+nPart2;
+      ResultsHist->FillPartnersSE(HistCounter,nPart1,nPart2);
+      //Now loop over the actual Particles and correlate them, each particle
+      //with the block of its partners
+      fRelK.resize(nPart1*nPart2);
+      int nPairs=0;
+      for (int iPart1=0;iPart1<nPart1;++iPart1) {
+        const int iFirst=(iSpec1==iSpec2)?iPart1+1:0;
+        RelativePairMomenta(Px1[iPart1],Py1[iPart1],Pz1[iPart1],
+                            fMasses[iSpec1],nPart2-iFirst,Px2+iFirst,
+                            Py2+iFirst,Pz2+iFirst,fMasses[iSpec2],
+                            fRelK.data()+nPairs);
+        nPairs+=nPart2-iFirst;
       }
+      ResultsHist->FillSameEventDist(HistCounter,nPairs,fRelK.data());
       ++HistCounter;
-      _intSpec2++;
-      itPDGPar2++;
     }
-    _intSpec1++;
-    itPDGPar1++;
   }
 }
 
@@ -99,74 +135,69 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
     AliFemtoDreamCorrHists *ResultsHist)
 {
-  double RelativeK = 0;
-  int _intSpec1 = 0;
+  FillMomenta(Particles);
+  const int nSpecies=Particles.size();
   int HistCounter=0;
-  auto itPDGPar1 = fPDGParticleSpecies.begin();
   //First loop over all the different Species
-  for (auto itSpec1=Particles.begin();itSpec1!=Particles.end();++itSpec1) {
+  for (int iSpec1=0;iSpec1<nSpecies;++iSpec1) {
+    const int nPart1=Particles[iSpec1].size();
+    const float *Px1=fMomenta[iSpec1].data();
+    const float *Py1=Px1+nPart1;
+    const float *Pz1=Py1+nPart1;
     //We dont want to correlate the particles twice. Mixed Event Dist. of
     //Particle1 + Particle2 == Particle2 + Particle 1
-    int SkipPart=itSpec1-Particles.begin();
-    int _intSpec2 = SkipPart;
-    auto itPDGPar2 = fPDGParticleSpecies.begin()+
-        SkipPart;
-    for (auto itSpec2=fPartContainer.begin()+SkipPart;
-        itSpec2!=fPartContainer.end();++itSpec2) {
-      for(int iDepth=0;iDepth<(int)itSpec2->GetMixingDepth();++iDepth){
-        std::vector<AliFemtoDreamBasePart> ParticlesOfEvent=
-            itSpec2->GetEvent(iDepth);
-        ResultsHist->FillPartnersME(
-            HistCounter,itSpec1->size(),ParticlesOfEvent.size());
-        for (auto itPart1=itSpec1->begin();itPart1!=itSpec1->end();++itPart1) {
-          for(auto itPart2=ParticlesOfEvent.begin();
-              itPart2!=ParticlesOfEvent.end();++itPart2) {
-            RelativeK=RelativePairMomentum(itPart1->GetMomentum(),*itPDGPar1,
-                                           itPart2->GetMomentum(),*itPDGPar2);
-            ResultsHist->FillMixedEventDist(HistCounter,RelativeK);
-          }
+    for (int iSpec2=iSpec1;iSpec2<(int)fPartContainer.size();++iSpec2) {
+      AliFemtoDreamPartContainer &Container=fPartContainer[iSpec2];
+      int nPairs=0;
+      for(int iDepth=0;iDepth<(int)Container.GetMixingDepth();++iDepth){
+        const int nPart2=Container.GetEventSize(iDepth);
+        ResultsHist->FillPartnersME(HistCounter,nPart1,nPart2);
+        const float *Px2=Container.GetMomenta(iDepth);
+        const float *Py2=Px2+nPart2;
+        const float *Pz2=Py2+nPart2;
+        fRelK.resize(nPairs+nPart1*nPart2);
+        for (int iPart1=0;iPart1<nPart1;++iPart1) {
+          RelativePairMomenta(Px1[iPart1],Py1[iPart1],Pz1[iPart1],
+                              fMasses[iSpec1],nPart2,Px2,Py2,Pz2,
+                              fMasses[iSpec2],fRelK.data()+nPairs);
+          nPairs+=nPart2;
         }
       }
+      ResultsHist->FillMixedEventDist(HistCounter,nPairs,fRelK.data());
       ++HistCounter;
-      ++_intSpec2;
-      ++itPDGPar2;
     }
-    ++_intSpec1;
-    ++itPDGPar1;
   }
 }
-double AliFemtoDreamZVtxMultContainer::RelativePairMomentum(TVector3 Part1Momentum,
-                                                            int PDGPart1,
-                                                            TVector3 Part2Momentum,
-                                                            int PDGPart2)
-{
-    if(PDGPart1 == 0 || PDGPart2== 0){
-      AliError("Invalid PDG Code");
-    }
-  double results = 0.;
-  TLorentzVector SPtrack,TPProng,trackSum,SPtrackCMS,TPProngCMS;
-  //Even if the Daughter tracks were switched up during PID doesn't play a role here cause we are
-  //only looking at the mother mass
-  SPtrack.SetXYZM(Part1Momentum.X(), Part1Momentum.Y(),Part1Momentum.Z(),
-                  TDatabasePDG::Instance()->GetParticle(PDGPart1)->Mass());
-  TPProng.SetXYZM(Part2Momentum.X(), Part2Momentum.Y(),Part2Momentum.Z(),
-                  TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass());
-  trackSum = SPtrack + TPProng;
 
-  double beta = trackSum.Beta();
-  double betax = beta*cos(trackSum.Phi())*sin(trackSum.Theta());
-  double betay = beta*sin(trackSum.Phi())*sin(trackSum.Theta());
-  double betaz = beta*cos(trackSum.Theta());
-
-  SPtrackCMS = SPtrack;
-  TPProngCMS = TPProng;
-
-  SPtrackCMS.Boost(-betax,-betay,-betaz);
-  TPProngCMS.Boost(-betax,-betay,-betaz);
-
-  TLorentzVector trackRelK;
-
-  trackRelK = SPtrackCMS - TPProngCMS;
-  results = 0.5*trackRelK.P();
-  return results;
+void AliFemtoDreamZVtxMultContainer::RelativePairMomenta(
+    float Px1,float Py1,float Pz1,double Mass1,int nPart2,const float *Px2,
+    const float *Py2,const float *Pz2,double Mass2,double *RelK)
+{
+  //k* of particle 1 with each of the nPart2 partners, i.e. the momentum of
+  //either particle in the pair rest frame. With P=p1+p2 and q=p1-p2
+  //k*^2 = ((P.q)^2/P^2-q^2)/4 and P.q=m1^2-m2^2, which is the same as half the
+  //momentum difference after boosting both particles into the pair rest frame,
+  //without building and boosting Lorentz vectors.
+  const double E1=TMath::Sqrt(
+      (double)Px1*Px1+(double)Py1*Py1+(double)Pz1*Pz1+Mass1*Mass1);
+  const double MassDiff=Mass1*Mass1-Mass2*Mass2;
+  const double MassDiff2=MassDiff*MassDiff;
+  for (int iPart2=0;iPart2<nPart2;++iPart2) {
+    const double px2=Px2[iPart2];
+    const double py2=Py2[iPart2];
+    const double pz2=Pz2[iPart2];
+    const double E2=TMath::Sqrt(px2*px2+py2*py2+pz2*pz2+Mass2*Mass2);
+    const double PE=E1+E2;
+    const double Px=Px1+px2;
+    const double Py=Py1+py2;
+    const double Pz=Pz1+pz2;
+    const double qE=E1-E2;
+    const double qx=Px1-px2;
+    const double qy=Py1-py2;
+    const double qz=Pz1-pz2;
+    const double PInv2=PE*PE-Px*Px-Py*Py-Pz*Pz;
+    const double qInv2=qE*qE-qx*qx-qy*qy-qz*qz;
+    const double kStar2=0.25*(MassDiff2/PInv2-qInv2);
+    RelK[iPart2]=kStar2>0.?TMath::Sqrt(kStar2):0.;
+  }
 }
@@ -15,6 +15,9 @@
 #include "AliFemtoDreamPartContainer.h"
 //Class containing the array buffer of the different particle species for one
 //Multiplicity bin
+//The pair loops work on the flat momentum arrays of the particle containers,
+//k* of one particle with a block of partners is computed in a single loop and
+//the results for each species pair are filled into the histograms at once.
 class AliFemtoDreamZVtxMultContainer {
  public:
   AliFemtoDreamZVtxMultContainer();
@@ -27,13 +30,20 @@ class AliFemtoDreamZVtxMultContainer {
       std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
       AliFemtoDreamCorrHists *ResultsHist);
   void SetEvent(std::vector<std::vector<AliFemtoDreamBasePart>> &Particles);
+  void SetMixingDepth(int MixingDepth);
   TString ClassName() {return "zVtxMult Container";};
+  static void RelativePairMomenta(float Px1,float Py1,float Pz1,double Mass1,
+                                  int nPart2,const float *Px2,const float *Py2,
+                                  const float *Pz2,double Mass2,double *RelK);
  private:
-  double RelativePairMomentum(TVector3 Part1Momentum,int PDGPart1,
-                              TVector3 Part2Momentum,int PDGPart2);
+  void SetMasses();
+  void FillMomenta(std::vector<std::vector<AliFemtoDreamBasePart>> &Particles);
   std::vector<AliFemtoDreamPartContainer> fPartContainer;
   std::vector<int> fPDGParticleSpecies;
-  ClassDef(AliFemtoDreamZVtxMultContainer,1);
+  std::vector<double> fMasses;                  //! masses of the species
+  std::vector<std::vector<float>> fMomenta;     //! flat momenta of the current event
+  std::vector<double> fRelK;                    //! k* of the current species pair
+  ClassDef(AliFemtoDreamZVtxMultContainer,2);
 };
 
 #endif /* ALIFEMTODREAMZVTXMULTCONTAINER_H_ */
@@ -134,6 +134,7 @@ AliDielectron::AliDielectron() :
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
   fPairCandidates(new TObjArray(11)),
+  fPairPool(),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
   fRotatePP(kFALSE),
@@ -211,6 +212,7 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
   fPairCandidates(new TObjArray(11)),
+  fPairPool(),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
   fRotatePP(kFALSE),
@@ -270,6 +272,7 @@ AliDielectron::~AliDielectron()
   if (fHistos) delete fHistos;
   if (fUsedVars) delete fUsedVars;
   if (fPairCandidates && fEventProcess) delete fPairCandidates;
+  fPairPool.Delete();
   if (fDebugTree) delete fDebugTree;
   if (fMixing) delete fMixing;
   if (fEvtVsTrkHist) delete fEvtVsTrkHist;
@@ -1269,11 +1272,16 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
           //relate to the production vertex
           //       if (AliDielectronVarManager::GetKFVertex()) candidate.SetProductionVertex(*AliDielectronVarManager::GetKFVertex());
 
+          AliDielectronVarManager::SetPairCache(&candidate);
+
           //pair cuts
           UInt_t cutMask=pairPreFilter->IsSelected(&candidate);
 
           //apply cut
-          if (cutMask!=selectedMask) continue;
+          if (cutMask!=selectedMask) {
+            AliDielectronVarManager::ResetPairCache();
+            continue;
+          }
       //    Double_t likelihood = prefilterN == 1 ?  candidate.PhivPair(ev->GetMagneticField()) - 21. * candidate.M() : -1. * candidate.M();
             Double_t likelihood =  candidate.GetKFNdf() / candidate.GetKFChi2();
           if( likelihood > maxLikelihood1[itrack1]   && likelihood > maxLikelihood2[itrack2]  ){
@@ -1285,6 +1293,7 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
 
           if (fCfManagerPair) fCfManagerPair->Fill(selectedMaskPair+1 ,&candidate);
           if (fHistos) FillHistogramsPair(&candidate,kTRUE);
+          AliDielectronVarManager::ResetPairCache();
           //set flags for track removal
         }
       }
@@ -1321,13 +1330,19 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
           //relate to the production vertex
           //       if (AliDielectronVarManager::GetKFVertex()) candidate.SetProductionVertex(*AliDielectronVarManager::GetKFVertex());
 
+          AliDielectronVarManager::SetPairCache(&candidate);
+
           //pair cuts
           UInt_t cutMask=pairPreFilter->IsSelected(&candidate);
 
           //apply cut
-          if (cutMask!=selectedMask) continue;
+          if (cutMask!=selectedMask) {
+            AliDielectronVarManager::ResetPairCache();
+            continue;
+          }
           if (fCfManagerPair) fCfManagerPair->Fill(selectedMaskPair+1 ,&candidate);
           if (fHistos) FillHistogramsPair(&candidate,kTRUE);
+          AliDielectronVarManager::ResetPairCache();
           //set flags for track removal
           bTracks1RP[itrack1]=kTRUE;
           bTracks2RP[itrack2]=kTRUE;
@@ -1415,8 +1430,7 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
   Int_t ntrack1=arrTracks1.GetEntriesFast();
   Int_t ntrack2=arrTracks2.GetEntriesFast();
 
-  AliDielectronPair *candidate=new AliDielectronPair;
-  candidate->SetKFUsage(fUseKF);
+  AliDielectronPair *candidate=NewPairCandidate();
 
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
 
@@ -1442,6 +1456,9 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
       // should we set the pdgmothercode and the label
       }
 
+      // the candidate is final: evaluate its variables only once for the cuts, CF, QA and histograms
+      AliDielectronVarManager::SetPairCache(candidate);
+
       //pair cuts
       UInt_t cutMask=fPairFilter.IsSelected(candidate);
 
@@ -1455,20 +1472,64 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
       }
 
       //apply cut
-      if (cutMask!=selectedMask) continue;
+      if (cutMask!=selectedMask) {
+        AliDielectronVarManager::ResetPairCache();
+        continue;
+      }
 
       //histogram array for the pair
       if (fHistoArray) fHistoArray->Fill(pairIndex,candidate);
+      AliDielectronVarManager::ResetPairCache();
 
       //add the candidate to the candidate array
       PairArray(pairIndex)->Add(candidate);
       //get a new candidate
-      candidate=new AliDielectronPair;
-      candidate->SetKFUsage(fUseKF);
+      candidate=NewPairCandidate();
     }
   }
-  //delete the surplus candidate
-  delete candidate;
+  //keep the surplus candidate for the next call
+  fPairPool.AddLast(candidate);
+}
+
+//________________________________________________________________
+AliDielectronPair* AliDielectron::NewPairCandidate()
+{
+  //
+  // Get an empty pair candidate, reusing one of the candidates
+  // released by ClearArrays if available
+  //
+  AliDielectronPair *candidate=0x0;
+  if (fPairPool.GetEntriesFast()>0){
+    candidate=static_cast<AliDielectronPair*>(fPairPool.RemoveAt(fPairPool.GetLast()));
+    *candidate=AliDielectronPair();
+  } else {
+    candidate=new AliDielectronPair;
+  }
+  candidate->SetKFUsage(fUseKF);
+  return candidate;
+}
+
+//________________________________________________________________
+void AliDielectron::ClearArrays()
+{
+  //
+  // Reset the Arrays
+  // The pairs are not deleted but kept in the pool for the next event
+  //
+  for (Int_t i=0;i<4;++i){
+    fTracks[i].Clear();
+  }
+  for (Int_t i=0;i<11;++i){
+    TObjArray *arr=PairArray(i);
+    if (!arr) continue;
+    for (Int_t ipair=0; ipair<arr->GetEntriesFast(); ++ipair){
+      TObject *obj=arr->UncheckedAt(ipair);
+      if (!obj) continue;
+      if (obj->IsA()==AliDielectronPair::Class()) fPairPool.AddLast(obj);
+      else delete obj;
+    }
+    arr->Clear();
+  }
 }
 
 //________________________________________________________________
@@ -1486,6 +1547,7 @@ void AliDielectron::FillPairArrayTR()
     candidate.SetTracks(&fTrackRotator->GetKFTrackP(), &fTrackRotator->GetKFTrackN(),
                         fTrackRotator->GetVTrackP(),fTrackRotator->GetVTrackN());
     candidate.SetType(kEv1PMRot);
+    AliDielectronVarManager::SetPairCache(&candidate);
 
     //pair cuts
     UInt_t cutMask=fPairFilter.IsSelected(&candidate);
@@ -1500,8 +1562,13 @@ void AliDielectron::FillPairArrayTR()
       if (fHistoArray) fHistoArray->Fill((Int_t)kEv1PMRot,&candidate);
 
       if(fHistos) FillHistogramsPair(&candidate);
-      if(fStoreRotatedPairs) PairArray(kEv1PMRot)->Add(new AliDielectronPair(candidate));
+      if(fStoreRotatedPairs) {
+        AliDielectronPair *rotated=NewPairCandidate();
+        *rotated=candidate;
+        PairArray(kEv1PMRot)->Add(rotated);
+      }
     }
+    AliDielectronVarManager::ResetPairCache();
   }
 }
 
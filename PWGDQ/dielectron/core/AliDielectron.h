@@ -244,6 +244,7 @@ private:
 
   TObjArray *fPairCandidates;     //! Pair candidate arrays
                                   //TODO: better way to store it? TClonesArray?
+  TObjArray fPairPool;            //! Pair candidates of previous events, reused by NewPairCandidate
 
   AliDielectronCF *fCfManagerPair;//Correction Framework Manager for the Pair
   AliDielectronTrackRotator *fTrackRotator; //Track rotator
@@ -284,6 +285,7 @@ private:
 
   void InitPairCandidateArrays();
   void ClearArrays();
+  AliDielectronPair* NewPairCandidate();
 
   TObjArray* PairArray(Int_t i);
   TObject* InitEffMap(TString filename, TString generatedname, TString foundname);
@@ -312,7 +314,7 @@ private:
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,17);
+  ClassDef(AliDielectron,18);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
@@ -336,17 +338,4 @@ inline TObjArray* AliDielectron::PairArray(Int_t i)
   return static_cast<TObjArray*>(fPairCandidates->UncheckedAt(i));
 }
 
-inline void AliDielectron::ClearArrays()
-{
-  //
-  // Reset the Arrays
-  //
-  for (Int_t i=0;i<4;++i){
-    fTracks[i].Clear();
-  }
-  for (Int_t i=0;i<11;++i){
-    if (PairArray(i)) PairArray(i)->Delete();
-  }
-}
-
 #endif
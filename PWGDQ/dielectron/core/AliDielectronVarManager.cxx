@@ -22,10 +22,31 @@
 //                                                                       //
 ///////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
+#include <vector>
+
 #include "AliDielectronVarManager.h"
 
 ClassImp(AliDielectronVarManager)
 
+namespace {
+  // values of the cached pair for one fill map: the variables written by FillVarDielectronPair and their values,
+  // the number of particles filled (each draws one random number) and the requested random plane angles
+  struct AliDielectronPairCacheEntry {
+    AliDielectronPairCacheEntry() : fMap(0x0), fIndex(), fValue(), fNParticleRndm(0), fPlaneAngleRan() {}
+    const TBits *fMap;
+    std::vector<Int_t> fIndex;
+    std::vector<Double_t> fValue;
+    UInt_t fNParticleRndm;
+    Bool_t fPlaneAngleRan[4];
+  };
+  std::vector<AliDielectronPairCacheEntry> gPairCache; // entries of the cached pair (storage is reused)
+  UInt_t gNPairCache=0;                                // entries in use for the cached pair
+
+  // marks the variables not written by FillVarDielectronPair (quiet NaN with a payload no computation produces)
+  const ULong64_t kPairCacheUnset=0x7ffc0fee0fee0feeULL;
+}
+
 const char* AliDielectronVarManager::fgkParticleNames[AliDielectronVarManager::kNMaxValues][3] = {
   {"Px",                     "#it{p}_{x}",                                         "(GeV/#it{c})"},
   {"Py",                     "#it{p}_{y}",                                         "(GeV/#it{c})"},
@@ -661,6 +682,8 @@ TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
 TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
 TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
 TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
+const AliDielectronPair* AliDielectronVarManager::fgCachePair = 0x0;
+UInt_t                   AliDielectronVarManager::fgNParticleRndm = 0;
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
 TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
@@ -743,6 +766,78 @@ AliDielectronVarManager::~AliDielectronVarManager()
 
 }
 
+//________________________________________________________________
+void AliDielectronVarManager::SetPairCache(const AliDielectronPair *pair)
+{
+  //
+  // Cache the values of 'pair' until ResetPairCache is called:
+  // the first Fill of the pair for a given fill map evaluates the variables,
+  // further Fill calls with the same map (e.g. from the pair cuts, the CF manager
+  // and the cut QA) copy them. The pair must not be modified while it is cached.
+  // The random reaction plane and the random numbers are drawn again for every Fill.
+  // FillHistograms does not use the cache: it fills the stored pairs once, with its
+  // own map, at the end of the event.
+  //
+  fgCachePair=pair;
+  gNPairCache=0;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::FillVarCachedPair(Double_t * const values)
+{
+  //
+  // Fill the values of the cached pair. Only the variables written by FillVarDielectronPair
+  // for the current fill map are set, all other entries of 'values' are left untouched
+  //
+  UInt_t ientry=0;
+  while (ientry<gNPairCache && gPairCache[ientry].fMap!=fgFillMap) ++ientry;
+
+  if (ientry==gNPairCache) {
+    // first Fill of the pair with this map: find the written variables by evaluating into a marked buffer
+    if (gPairCache.size()==gNPairCache) gPairCache.resize(gNPairCache+1);
+    AliDielectronPairCacheEntry &entry=gPairCache[gNPairCache++];
+    entry.fMap=fgFillMap;
+    entry.fIndex.clear();
+    entry.fValue.clear();
+
+    static Double_t buffer[kNMaxValues];
+    for (Int_t i=0; i<kNMaxValues; ++i) memcpy(&buffer[i], &kPairCacheUnset, sizeof(Double_t));
+    const UInt_t nParticleRndm=fgNParticleRndm;
+    FillVarDielectronPair(fgCachePair, buffer);
+    entry.fNParticleRndm=fgNParticleRndm-nParticleRndm;
+    const Int_t planeAngleRan[4]={kPairPlaneAngle1Ran,kPairPlaneAngle2Ran,kPairPlaneAngle3Ran,kPairPlaneAngle4Ran};
+    for (Int_t i=0; i<4; ++i) entry.fPlaneAngleRan[i]=memcmp(&buffer[planeAngleRan[i]], &kPairCacheUnset, sizeof(Double_t))!=0;
+    for (Int_t i=0; i<kNMaxValues; ++i) {
+      if (!memcmp(&buffer[i], &kPairCacheUnset, sizeof(Double_t))) continue;
+      entry.fIndex.push_back(i);
+      entry.fValue.push_back(buffer[i]);
+      values[i]=buffer[i];
+    }
+    return;
+  }
+
+  const AliDielectronPairCacheEntry &entry=gPairCache[ientry];
+  for (UInt_t i=0; i<entry.fIndex.size(); ++i) values[entry.fIndex[i]]=entry.fValue[i];
+
+  // draw the random numbers in the same order and number as FillVarDielectronPair: kRndm of the
+  // pair (FillVarVParticle), the random reaction plane, one per leg Fill, and kRndmPair
+  // (kRndm and kRndmPair are the same variable)
+  gRandom->Rndm();
+  values[AliDielectronVarManager::kRandomRP] = gRandom->Uniform(-TMath::Pi()/2.0,TMath::Pi()/2.0);
+  for (UInt_t i=1; i<entry.fNParticleRndm; ++i) gRandom->Rndm();
+  values[AliDielectronVarManager::kRndmPair]=gRandom->Rndm();
+  fgNParticleRndm+=entry.fNParticleRndm;
+
+  // values derived from the random reaction plane
+  values[AliDielectronVarManager::kDeltaPhiRandomRP] = values[AliDielectronVarManager::kPhi] - values[kRandomRP];
+  if ( values[AliDielectronVarManager::kDeltaPhiRandomRP] > TMath::Pi() )
+    values[AliDielectronVarManager::kDeltaPhiRandomRP] -= TMath::TwoPi();
+  const Int_t planeAngleRan[4]={kPairPlaneAngle1Ran,kPairPlaneAngle2Ran,kPairPlaneAngle3Ran,kPairPlaneAngle4Ran};
+  for (Int_t i=0; i<4; ++i) {
+    if (entry.fPlaneAngleRan[i]) values[planeAngleRan[i]] = fgCachePair->GetPairPlaneAngle(values[kRandomRP],i+1);
+  }
+}
+
 //________________________________________________________________
 UInt_t AliDielectronVarManager::GetValueType(const char* valname) {
   //
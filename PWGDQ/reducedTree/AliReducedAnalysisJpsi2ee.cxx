@@ -47,7 +47,10 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee() :
   fJpsiCandidates(),
   fLegCandidatesMCcuts(),
   fJpsiMotherMCcuts(),
-  fJpsiElectronMCcuts()
+  fJpsiElectronMCcuts(),
+  fConfigEventCuts(),
+  fConfigPairCuts(),
+  fConfigEventMask(~ULong_t(0))
 {
   //
   // default constructor
@@ -79,7 +82,10 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
   fJpsiCandidates(),
   fLegCandidatesMCcuts(),
   fJpsiMotherMCcuts(),
-  fJpsiElectronMCcuts()
+  fJpsiElectronMCcuts(),
+  fConfigEventCuts(),
+  fConfigPairCuts(),
+  fConfigEventMask(~ULong_t(0))
 {
   //
   // named constructor
@@ -97,6 +103,8 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
    fLegCandidatesMCcuts.SetOwner(kTRUE);
    fJpsiMotherMCcuts.SetOwner(kTRUE);
    fJpsiElectronMCcuts.SetOwner(kTRUE);
+   fConfigEventCuts.SetOwner(kTRUE);
+   fConfigPairCuts.SetOwner(kTRUE);
 }
 
 
@@ -109,6 +117,7 @@ AliReducedAnalysisJpsi2ee::~AliReducedAnalysisJpsi2ee()
    fEventCuts.Clear("C"); fTrackCuts.Clear("C"); fPreFilterTrackCuts.Clear("C"); fPreFilterPairCuts.Clear("C"); fPairCuts.Clear("C");
    fPosTracks.Clear("C"); fNegTracks.Clear("C"); fPrefilterPosTracks.Clear("C"); fPrefilterNegTracks.Clear("C");
    fJpsiCandidates.Clear("C");
+   fConfigEventCuts.Clear("C"); fConfigPairCuts.Clear("C");
    if(fHistosManager) delete fHistosManager;
    if(fMixingHandler) delete fMixingHandler;
 }
@@ -129,6 +138,27 @@ void AliReducedAnalysisJpsi2ee::AddTrackCut(AliReducedInfoCut* cut) {
 }
 
 
+//___________________________________________________________________________
+void AliReducedAnalysisJpsi2ee::AddCutConfiguration(AliReducedInfoCut* trackCut, AliReducedInfoCut* eventCut /*=0x0*/, AliReducedInfoCut* pairCut /*=0x0*/) {
+   //
+   // Add a cut configuration, to be evaluated in the same pass as all the other configurations
+   // The track cut is added as a new parallel track cut and its name is used for the histogram classes.
+   // The event cut (if any) is applied on top of the common event cuts and the pair cut (if any) on top of
+   //    the common pair cuts, only for this configuration. The configuration histograms are filled using the
+   //    track flags, so an event or pair rejected by a configuration only removes the corresponding bit.
+   // NOTE: Each configuration needs its own cut objects, since the lists own the cuts.
+   //
+   if(fTrackCuts.GetEntries()>=Int_t(8*sizeof(ULong_t))) {
+      cout << "ERROR: AliReducedAnalysisJpsi2ee::AddCutConfiguration() at most " << 8*sizeof(ULong_t) << " configurations are supported" << endl;
+      return;
+   }
+   Int_t index = fTrackCuts.GetEntries();
+   AddTrackCut(trackCut);
+   if(eventCut) fConfigEventCuts.AddAtAndExpand(eventCut, index);
+   if(pairCut) fConfigPairCuts.AddAtAndExpand(pairCut, index);
+}
+
+
 //___________________________________________________________________________
 Bool_t AliReducedAnalysisJpsi2ee::IsEventSelected(AliReducedBaseEvent* event, Float_t* values/*=0x0*/) {
   //
@@ -153,6 +183,7 @@ Bool_t AliReducedAnalysisJpsi2ee::IsTrackSelected(AliReducedBaseTrack* track, Fl
   track->ResetFlags();
   
   for(Int_t i=0; i<fTrackCuts.GetEntries(); ++i) {
+    if(!(fConfigEventMask & (ULong_t(1)<<i))) continue;      // configuration rejected the event
     AliReducedInfoCut* cut = (AliReducedInfoCut*)fTrackCuts.At(i);
     if(values) { if(cut->IsSelected(track, values)) track->SetFlag(i); }
     else { if(cut->IsSelected(track)) track->SetFlag(i); }
@@ -190,6 +221,33 @@ Bool_t AliReducedAnalysisJpsi2ee::IsPairSelected(Float_t* values) {
   return kTRUE;
 }
 
+//___________________________________________________________________________
+ULong_t AliReducedAnalysisJpsi2ee::EvaluateConfigEventCuts(AliReducedBaseEvent* event, Float_t* values) {
+   //
+   // return the bit map of the cut configurations selecting the event
+   // (all bits set if no configuration has an event cut)
+   //
+   ULong_t mask = ~ULong_t(0);
+   for(Int_t i=0; i<fConfigEventCuts.GetEntriesFast(); ++i) {
+      AliReducedInfoCut* cut = (AliReducedInfoCut*)fConfigEventCuts.UncheckedAt(i);
+      if(cut && !cut->IsSelected(event, values)) mask &= ~(ULong_t(1)<<i);
+   }
+   return mask;
+}
+
+//___________________________________________________________________________
+ULong_t AliReducedAnalysisJpsi2ee::ApplyConfigPairCuts(ULong_t mask, Float_t* values) {
+   //
+   // remove from the mask the cut configurations whose pair cut rejects the pair
+   //
+   for(Int_t i=0; i<fConfigPairCuts.GetEntriesFast(); ++i) {
+      if(!(mask & (ULong_t(1)<<i))) continue;
+      AliReducedInfoCut* cut = (AliReducedInfoCut*)fConfigPairCuts.UncheckedAt(i);
+      if(cut && !cut->IsSelected(values)) mask &= ~(ULong_t(1)<<i);
+   }
+   return mask;
+}
+
 //___________________________________________________________________________
 Bool_t AliReducedAnalysisJpsi2ee::IsPairPreFilterSelected(Float_t* values) {
    //
@@ -255,6 +313,10 @@ void AliReducedAnalysisJpsi2ee::Process() {
   
   // fill event information before event cuts
   AliReducedVarManager::FillEventInfo(fEvent, fValues);
+  // evaluate the event cuts on the values filled above, before they are modified by the tag and trigger loops,
+  //   so the event information is computed only once for the common cuts and all the cut configurations
+  Bool_t eventSelected = IsEventSelected(fEvent, fValues);
+  if(eventSelected) fConfigEventMask = EvaluateConfigEventCuts(fEvent, fValues);
   fHistosManager->FillHistClass("Event_BeforeCuts", fValues);
   for(UShort_t ibit=0; ibit<64; ++ibit) {
      AliReducedVarManager::FillEventTagInput(fEvent, ibit, fValues);
@@ -267,7 +329,8 @@ void AliReducedAnalysisJpsi2ee::Process() {
   
   
   // apply event selection
-  if(!IsEventSelected(fEvent)) return;
+  if(!eventSelected) return;
+  if(!fConfigEventMask) return;       // rejected by all the cut configurations
   
   if(fOptionRunOverMC) FillMCTruthHistograms();
   
@@ -305,6 +368,11 @@ void AliReducedAnalysisJpsi2ee::Process() {
  
   // fill event info histograms after cuts
   fHistosManager->FillHistClass("Event_AfterCuts", fValues);
+  for(Int_t i=0; i<fConfigEventCuts.GetEntriesFast(); ++i) {
+     if(!fConfigEventCuts.UncheckedAt(i)) continue;
+     if(fConfigEventMask & (ULong_t(1)<<i))
+        fHistosManager->FillHistClass(Form("Event_AfterCuts_%s", fTrackCuts.At(i)->GetName()), fValues);
+  }
   for(UShort_t ibit=0; ibit<64; ++ibit) {
      AliReducedVarManager::FillEventTagInput(fEvent, ibit, fValues);
      fHistosManager->FillHistClass("EventTag_AfterCuts", fValues);
@@ -522,12 +590,13 @@ void AliReducedAnalysisJpsi2ee::RunSameEventPairing(TString pairClass /*="PairSE
          // verify that the two current tracks have at least 1 common bit
          if(!(pTrack->GetFlags() & nTrack->GetFlags())) continue;
          AliReducedVarManager::FillPairInfo(pTrack, nTrack, AliReducedPairInfo::kJpsiToEE, fValues);
-         if(IsPairSelected(fValues)) {
-            FillPairHistograms(pTrack->GetFlags() & nTrack->GetFlags(), 1, pairClass, (fOptionRunOverMC ? CheckReconstructedLegMCTruth(pTrack, nTrack) : 0));    // 1 is for +- pairs 
+         ULong_t pairMask = (IsPairSelected(fValues) ? ApplyConfigPairCuts(pTrack->GetFlags() & nTrack->GetFlags(), fValues) : 0);
+         if(pairMask) {
+            FillPairHistograms(pairMask, 1, pairClass, (fOptionRunOverMC ? CheckReconstructedLegMCTruth(pTrack, nTrack) : 0));    // 1 is for +- pairs 
             fValues[AliReducedVarManager::kNpairsSelected] += 1.0;
             if(fOptionStoreJpsiCandidates) {
                AliReducedPairInfo* pair = new AliReducedPairInfo();
-               pair->SetFlags(pTrack->GetFlags() & nTrack->GetFlags());
+               pair->SetFlags(pairMask);
                pair->PtPhiEta(fValues[AliReducedVarManager::kPt], fValues[AliReducedVarManager::kPhi], fValues[AliReducedVarManager::kEta]);
                pair->SetMass(fValues[AliReducedVarManager::kMass]);
                pair->CandidateId(AliReducedPairInfo::kJpsiToEE);
@@ -545,12 +614,13 @@ void AliReducedAnalysisJpsi2ee::RunSameEventPairing(TString pairClass /*="PairSE
             // verify that the two current tracks have at least 1 common bit
             if(!(pTrack->GetFlags() & pTrack2->GetFlags())) continue;
             AliReducedVarManager::FillPairInfo(pTrack, pTrack2, AliReducedPairInfo::kJpsiToEE, fValues);
-            if(IsPairSelected(fValues)) {
-               FillPairHistograms(pTrack->GetFlags() & pTrack2->GetFlags(), 0, pairClass);       // 0 is for ++ pairs 
+            ULong_t pairMask = (IsPairSelected(fValues) ? ApplyConfigPairCuts(pTrack->GetFlags() & pTrack2->GetFlags(), fValues) : 0);
+            if(pairMask) {
+               FillPairHistograms(pairMask, 0, pairClass);       // 0 is for ++ pairs 
                fValues[AliReducedVarManager::kNpairsSelected] += 1.0;
                if(fOptionStoreJpsiCandidates) {
                   AliReducedPairInfo* pair = new AliReducedPairInfo();
-                  pair->SetFlags(pTrack->GetFlags() & pTrack2->GetFlags());
+                  pair->SetFlags(pairMask);
                   pair->PtPhiEta(fValues[AliReducedVarManager::kPt], fValues[AliReducedVarManager::kPhi], fValues[AliReducedVarManager::kEta]);
                   pair->SetMass(fValues[AliReducedVarManager::kMass]);
                   pair->CandidateId(AliReducedPairInfo::kJpsiToEE);
@@ -574,12 +644,13 @@ void AliReducedAnalysisJpsi2ee::RunSameEventPairing(TString pairClass /*="PairSE
             // verify that the two current tracks have at least 1 common bit
             if(!(nTrack->GetFlags() & nTrack2->GetFlags())) continue;
             AliReducedVarManager::FillPairInfo(nTrack, nTrack2, AliReducedPairInfo::kJpsiToEE, fValues);
-            if(IsPairSelected(fValues)) {
-               FillPairHistograms(nTrack->GetFlags() & nTrack2->GetFlags(), 2, pairClass);      // 2 is for -- pairs
+            ULong_t pairMask = (IsPairSelected(fValues) ? ApplyConfigPairCuts(nTrack->GetFlags() & nTrack2->GetFlags(), fValues) : 0);
+            if(pairMask) {
+               FillPairHistograms(pairMask, 2, pairClass);      // 2 is for -- pairs
                fValues[AliReducedVarManager::kNpairsSelected] += 1.0;
                if(fOptionStoreJpsiCandidates) {
                   AliReducedPairInfo* pair = new AliReducedPairInfo();
-                  pair->SetFlags(nTrack->GetFlags() & nTrack2->GetFlags());
+                  pair->SetFlags(pairMask);
                   pair->PtPhiEta(fValues[AliReducedVarManager::kPt], fValues[AliReducedVarManager::kPhi], fValues[AliReducedVarManager::kEta]);
                   pair->SetMass(fValues[AliReducedVarManager::kMass]);
                   pair->CandidateId(AliReducedPairInfo::kJpsiToEE);
@@ -6,6 +6,7 @@
 #define ALIREDUCEDANALYSISJPSI2EE_H
 
 #include <TList.h>
+#include <TObjArray.h>
 
 #include "AliReducedAnalysisTaskSE.h"
 #include "AliReducedInfoCut.h"
@@ -34,6 +35,7 @@ public:
   // setters
   void AddEventCut(AliReducedInfoCut* cut) {fEventCuts.Add(cut);}
   void AddTrackCut(AliReducedInfoCut* cut);
+  void AddCutConfiguration(AliReducedInfoCut* trackCut, AliReducedInfoCut* eventCut=0x0, AliReducedInfoCut* pairCut=0x0);
   void AddPrefilterTrackCut(AliReducedInfoCut* cut) {fPreFilterTrackCuts.Add(cut);}
   void AddPairCut(AliReducedInfoCut* cut) {fPairCuts.Add(cut);}
   void AddPrefilterPairCut(AliReducedInfoCut* cut) {fPreFilterPairCuts.Add(cut);}
@@ -63,6 +65,7 @@ public:
   virtual AliMixingHandler* GetMixingHandler() const {return fMixingHandler;}
   Int_t GetNTrackCuts() const {return fTrackCuts.GetEntries();}
   const Char_t* GetTrackCutName(Int_t i) const {return (i<fTrackCuts.GetEntries() ? fTrackCuts.At(i)->GetName() : "");} 
+  ULong_t GetConfigEventMask() const {return fConfigEventMask;}
   Bool_t GetRunOverMC() const {return fOptionRunOverMC;};
   Bool_t GetRunLikeSignPairing() const {return fOptionRunLikeSignPairing;}
   Bool_t GetRunEventMixing() const {return fOptionRunMixing;}
@@ -118,11 +121,21 @@ protected:
    //  NOTE: The number of selections on the jpsi electron needs to be the same and in sync with the number of fJpsiMotherMCcuts cuts
    TList fJpsiElectronMCcuts;
    
+   // Cut configurations evaluated in the same pass over the events (see AddCutConfiguration)
+   // Each configuration is a track cut (one bit of the track flags) with an optional event cut and pair cut,
+   //   stored at the index of the track cut; a missing entry means no additional cut for that configuration.
+   //   The event and pair cuts are applied on the values already filled for the event / pair.
+   TObjArray fConfigEventCuts;     // additional event cut for each configuration
+   TObjArray fConfigPairCuts;       // additional pair cut for each configuration
+   ULong_t fConfigEventMask;       //! configurations selecting the current event
+   
   Bool_t IsEventSelected(AliReducedBaseEvent* event, Float_t* values=0x0);
   Bool_t IsTrackSelected(AliReducedBaseTrack* track, Float_t* values=0x0);
   Bool_t IsTrackPrefilterSelected(AliReducedBaseTrack* track, Float_t* values=0x0);
   Bool_t IsPairSelected(Float_t* values);
   Bool_t IsPairPreFilterSelected(Float_t* values);
+  ULong_t EvaluateConfigEventCuts(AliReducedBaseEvent* event, Float_t* values);
+  ULong_t ApplyConfigPairCuts(ULong_t mask, Float_t* values);
   UInt_t CheckReconstructedLegMCTruth(AliReducedBaseTrack* ptrack, AliReducedBaseTrack* ntrack);
   UInt_t CheckReconstructedLegMCTruth(AliReducedBaseTrack* track);
   void    FindJpsiTruthLegs(AliReducedTrackInfo* mother, Int_t& leg1Label, Int_t& leg2Label);
@@ -140,7 +153,7 @@ protected:
   void FillPairHistograms(ULong_t mask, Int_t pairType, TString pairClass = "PairSE", UInt_t mcDecisions = 0);
   void FillMCTruthHistograms();
   
-  ClassDef(AliReducedAnalysisJpsi2ee,5);
+  ClassDef(AliReducedAnalysisJpsi2ee,6);
 };
 
 #endif
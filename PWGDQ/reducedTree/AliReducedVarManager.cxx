@@ -135,6 +135,11 @@ TString AliReducedVarManager::fgVariableUnits[AliReducedVarManager::kNVars] = {"
 AliReducedBaseEvent* AliReducedVarManager::fgEvent = 0x0;
 AliReducedEventPlaneInfo* AliReducedVarManager::fgEventPlane = 0x0;
 Bool_t AliReducedVarManager::fgUsedVars[AliReducedVarManager::kNVars] = {kFALSE};
+Int_t AliReducedVarManager::fgTrackFillPlan[AliReducedVarManager::kNTrackFillSteps] = {0};
+Int_t AliReducedVarManager::fgNTrackFillSteps = 0;
+std::vector<Int_t> AliReducedVarManager::fgHarmonicsPlan;
+std::vector<Int_t> AliReducedVarManager::fgVZEROFlowPlan;
+std::vector<Int_t> AliReducedVarManager::fgTPCFlowPlan;
 TH2F* AliReducedVarManager::fgTPCelectronCentroidMap = 0x0;
 TH2F* AliReducedVarManager::fgTPCelectronWidthMap = 0x0;
 AliReducedVarManager::Variables AliReducedVarManager::fgVarDependencyX = kNothing;
@@ -319,6 +324,8 @@ void AliReducedVarManager::SetVariableDependencies() {
     fgUsedVars[kPt]               = kTRUE;
     fgUsedVars[kPairDcaXYSqrt]    = kTRUE;
   }
+  
+  BuildTrackFillPlan();
 }
 
 //__________________________________________________________________
@@ -1146,6 +1153,151 @@ void AliReducedVarManager::FillMCTruthInfo(TRACK* p, Float_t* values, TRACK* leg
       GetThetaPhiCM(leg1, leg2, values[kPairThetaHE], values[kPairPhiHE], values[kPairThetaCS], values[kPairPhiCS]);
 }
 
+//__________________________________________________________________
+void AliReducedVarManager::BuildTrackFillPlan() {
+  //
+  // Build the evaluation plan used by FillTrackInfo() for the variables which are computed from
+  // the event plane, the harmonics of the track azimuth and the pair efficiency map.
+  // Only the steps and the (VZERO side, harmonic) combinations with at least one used variable are kept,
+  // such that the per-track fill does not scan the whole blocks of variables.
+  // The steps are ordered as their dependencies require (e.g. the flow variables need kPhi, the pair efficiency
+  // may depend on the kinematic variables); the dependencies between the variables are resolved beforehand
+  // in SetVariableDependencies(), which calls this function.
+  //
+  fgNTrackFillSteps = 0;
+  fgHarmonicsPlan.clear();
+  fgVZEROFlowPlan.clear();
+  fgTPCFlowPlan.clear();
+  
+  for(Int_t ih=1; ih<=6; ++ih)
+    if(fgUsedVars[kCosNPhi+ih-1] || fgUsedVars[kSinNPhi+ih-1]) fgHarmonicsPlan.push_back(ih);
+  if(!fgHarmonicsPlan.empty()) fgTrackFillPlan[fgNTrackFillSteps++] = kFillHarmonics;
+  
+  if(fgUsedVars[kPairEff] || fgUsedVars[kOneOverPairEff] || fgUsedVars[kOneOverPairEffSq])
+    fgTrackFillPlan[fgNTrackFillSteps++] = kFillPairEfficiency;
+  
+  for(Int_t iVZEROside=0; iVZEROside<3; ++iVZEROside) {
+    for(Int_t ih=0; ih<6; ++ih) {
+      Int_t idx = iVZEROside*6+ih;
+      if(fgUsedVars[kVZEROFlowVn+idx] || fgUsedVars[kVZEROFlowSine+idx] ||
+         (iVZEROside<2 && (fgUsedVars[kVZEROuQ+idx] || fgUsedVars[kVZEROuQsine+idx])))
+        fgVZEROFlowPlan.push_back(idx);
+    }
+  }
+  if(!fgVZEROFlowPlan.empty()) fgTrackFillPlan[fgNTrackFillSteps++] = kFillVZEROFlow;
+  
+  for(Int_t ih=0; ih<6; ++ih)
+    if(fgUsedVars[kTPCFlowVn+ih] || fgUsedVars[kTPCFlowSine+ih] || fgUsedVars[kTPCuQ+ih] || fgUsedVars[kTPCuQsine+ih])
+      fgTPCFlowPlan.push_back(ih);
+  if(!fgTPCFlowPlan.empty()) fgTrackFillPlan[fgNTrackFillSteps++] = kFillTPCFlow;
+}
+
+//__________________________________________________________________
+void AliReducedVarManager::FillTrackHarmonics(BASETRACK* p, Float_t* values) {
+  //
+  // fill cos(n*phi) and sin(n*phi) for the harmonics in the evaluation plan
+  //
+  Float_t phi = p->Phi();
+  for(std::vector<Int_t>::const_iterator it=fgHarmonicsPlan.begin(); it!=fgHarmonicsPlan.end(); ++it) {
+     Int_t ih = *it;
+     if(fgUsedVars[kCosNPhi+ih-1]) values[kCosNPhi+ih-1] = TMath::Cos(phi*ih);
+     if(fgUsedVars[kSinNPhi+ih-1]) values[kSinNPhi+ih-1] = TMath::Sin(phi*ih);
+  }
+}
+
+//__________________________________________________________________
+void AliReducedVarManager::FillTrackPairEfficiency(Float_t* values) {
+  //
+  // fill the pair efficiency variables from the 2D efficiency map
+  //
+  if(!fgPairEffMap) return;
+  Int_t binX = fgPairEffMap->GetXaxis()->FindBin(values[fgEffMapVarDependencyX]);
+  if(binX==0) binX = 1;
+  if(binX==fgPairEffMap->GetXaxis()->GetNbins()+1) binX -= 1;
+  Int_t binY = fgPairEffMap->GetYaxis()->FindBin(values[fgEffMapVarDependencyY]);
+  if(binY==0) binY=1;
+  if(binY==fgPairEffMap->GetYaxis()->GetNbins()+1) binY -= 1;
+  Float_t pairEff = fgPairEffMap->GetBinContent(binX, binY);
+  Float_t oneOverPairEff = 1;
+  if (pairEff > 1.0e-6) oneOverPairEff = 1/pairEff;
+  values[kPairEff] = pairEff;
+  values[kOneOverPairEff] = oneOverPairEff;
+  values[kOneOverPairEffSq] = oneOverPairEff*oneOverPairEff;
+}
+
+//__________________________________________________________________
+void AliReducedVarManager::FillTrackVZEROFlow(Float_t* values) {
+  //
+  // fill the VZERO flow variables for the (side, harmonic) combinations in the evaluation plan
+  //
+  for(std::vector<Int_t>::const_iterator it=fgVZEROFlowPlan.begin(); it!=fgVZEROFlowPlan.end(); ++it) {
+     Int_t idx = *it;
+     Int_t iVZEROside = idx/6;
+     Int_t ih = idx%6;
+     if(fgUsedVars[kVZEROFlowVn+idx])
+        values[kVZEROFlowVn+idx] = TMath::Cos((values[kPhi]-values[kVZERORP+idx])*(ih+1));
+     if(fgUsedVars[kVZEROFlowSine+idx])
+        values[kVZEROFlowSine+idx] = TMath::Sin((values[kPhi]-values[kVZERORP+idx])*(ih+1));
+     if(iVZEROside<2) {
+        if(fgUsedVars[kVZEROuQ+idx]) {
+           values[kVZEROuQ+idx] = TMath::Cos((values[kPhi]-values[kVZERORP+idx])*(ih+1));
+           values[kVZEROuQ+idx] *= TMath::Sqrt(values[kVZEROQvecX+idx]*values[kVZEROQvecX+idx] +
+                                               values[kVZEROQvecY+idx]*values[kVZEROQvecY+idx]);
+        }
+        if(fgUsedVars[kVZEROuQsine+idx]) {
+           values[kVZEROuQsine+idx] = TMath::Sin((values[kPhi]-values[kVZERORP+idx])*(ih+1));
+           values[kVZEROuQsine+idx] *= TMath::Sqrt(values[kVZEROQvecX+idx]*values[kVZEROQvecX+idx] +
+                                                   values[kVZEROQvecY+idx]*values[kVZEROQvecY+idx]);
+        }
+     }
+  }
+}
+
+//__________________________________________________________________
+void AliReducedVarManager::FillTrackTPCFlow(BASETRACK* p, Float_t* values) {
+  //
+  // fill the TPC flow variables for the harmonics in the evaluation plan
+  // Subtract the q vector of the track or of the pair legs from the event q-vector 
+  //
+  Float_t tpcEPsubtracted[6] = {0.0};
+  Double_t qVec[6][2] = {{0.0}};
+  for(Int_t ih=0; ih<6; ++ih) {qVec[ih][0]=values[kTPCQvecXtotal+ih]; qVec[ih][1]=values[kTPCQvecYtotal+ih];}
+  EVENT* eventInfo = NULL;
+  if(fgEvent->IsA()==EVENT::Class()) eventInfo = (EVENT*)fgEvent;
+  if((p->IsA() == AliReducedTrackInfo::Class()) && eventInfo) {
+     eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)p,qVec,EVENTPLANE::kTPC,-0.8,-0.5*fgkTPCQvecRapGap);
+     eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)p,qVec,EVENTPLANE::kTPC,0.5*fgkTPCQvecRapGap,0.8);
+  }
+
+  // TODO: Make sure the pair legs are properly subtracted from the TPC event plane calculation
+  //              For the moment this part of the code is commented out
+  /* else if((p->IsA() == AliReducedPairInfo::Class()) && eventInfo) {
+     cout<<"id  "<<((AliReducedPairInfo*)p)->LegId(1)<<endl;
+     eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)eventInfo->GetTrack(((AliReducedPairInfo*)p)->LegId(0)),qVec,EVENTPLANE::kTPC,-0.8,-0.5*fgkTPCQvecRapGap);
+     eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)eventInfo->GetTrack(((AliReducedPairInfo*)p)->LegId(0)),qVec,EVENTPLANE::kTPC,0.5*fgkTPCQvecRapGap,0.8);
+     eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)eventInfo->GetTrack(((AliReducedPairInfo*)p)->LegId(1)),qVec,EVENTPLANE::kTPC,-0.8,-0.5*fgkTPCQvecRapGap);
+     eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)eventInfo->GetTrack(((AliReducedPairInfo*)p)->LegId(1)),qVec,EVENTPLANE::kTPC,0.5*fgkTPCQvecRapGap,0.8);
+  }  */
+  // recalculate the TPC event plane, only for the needed harmonics
+  for(std::vector<Int_t>::const_iterator it=fgTPCFlowPlan.begin(); it!=fgTPCFlowPlan.end(); ++it) {
+     Int_t ih = *it;
+     tpcEPsubtracted[ih] = TMath::ATan2(qVec[ih][1], qVec[ih][0])/Double_t(ih+1);
+     // vn using Psi_n
+     if(fgUsedVars[kTPCFlowVn+ih])
+        values[kTPCFlowVn+ih] = TMath::Cos(DeltaPhi(values[kPhi],tpcEPsubtracted[ih])*(ih+1));
+     if(fgUsedVars[kTPCFlowSine+ih]) 
+        values[kTPCFlowSine+ih] = TMath::Sin(DeltaPhi(values[kPhi],tpcEPsubtracted[ih])*(ih+1));
+     if(fgUsedVars[kTPCuQ+ih]) {
+        values[kTPCuQ+ih] = TMath::Cos((values[kPhi]-tpcEPsubtracted[ih])*(ih+1));
+        values[kTPCuQ+ih] *= TMath::Sqrt(qVec[ih][0]*qVec[ih][0] + qVec[ih][1]*qVec[ih][1]);
+     }
+     if(fgUsedVars[kTPCuQsine+ih]) {
+        values[kTPCuQsine+ih] = TMath::Sin((values[kPhi]-tpcEPsubtracted[ih])*(ih+1));
+        values[kTPCuQsine+ih] *= TMath::Sqrt(qVec[ih][0]*qVec[ih][0] + qVec[ih][1]*qVec[ih][1]);
+     }
+  }
+}
+
 //_________________________________________________________________
 void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   //
@@ -1165,97 +1317,25 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   if(fgUsedVars[kTheta])     values[kTheta]     = p->Theta();
   if(fgUsedVars[kPhi])       values[kPhi]       = p->Phi();
   if(fgUsedVars[kEta])       values[kEta]       = p->Eta();
-  for(Int_t ih=1; ih<=6; ++ih) {
-     if(fgUsedVars[kCosNPhi+ih-1]) values[kCosNPhi+ih-1] = TMath::Cos(p->Phi()*ih);
-     if(fgUsedVars[kSinNPhi+ih-1]) values[kSinNPhi+ih-1] = TMath::Sin(p->Phi()*ih);
-  }
-
-  //pair efficiency variables
-  if((fgUsedVars[kPairEff] || fgUsedVars[kOneOverPairEff] || fgUsedVars[kOneOverPairEffSq]) && fgPairEffMap) {
-    Int_t binX = fgPairEffMap->GetXaxis()->FindBin(values[fgEffMapVarDependencyX]);
-    if(binX==0) binX = 1;
-    if(binX==fgPairEffMap->GetXaxis()->GetNbins()+1) binX -= 1;
-    Int_t binY = fgPairEffMap->GetYaxis()->FindBin(values[fgEffMapVarDependencyY]);
-    if(binY==0) binY=1;
-    if(binY==fgPairEffMap->GetYaxis()->GetNbins()+1) binY -= 1;
-    Float_t pairEff = fgPairEffMap->GetBinContent(binX, binY);
-    Float_t oneOverPairEff = 1;
-    if (pairEff > 1.0e-6) oneOverPairEff = 1/pairEff;
-    values[kPairEff] = pairEff;
-    values[kOneOverPairEff] = oneOverPairEff;
-    values[kOneOverPairEffSq] = oneOverPairEff*oneOverPairEff;
-  }
 
-  // Fill VZERO flow variables
-  for(Int_t iVZEROside=0; iVZEROside<3; ++iVZEROside) {
-     for(Int_t ih=0; ih<6; ++ih) {
-        if(fgUsedVars[kVZEROFlowVn+iVZEROside*6+ih])
-           values[kVZEROFlowVn+iVZEROside*6+ih] = TMath::Cos((values[kPhi]-values[kVZERORP+iVZEROside*6+ih])*(ih+1));
-        if(fgUsedVars[kVZEROFlowSine+iVZEROside*6+ih])
-           values[kVZEROFlowSine+iVZEROside*6+ih] = TMath::Sin((values[kPhi]-values[kVZERORP+iVZEROside*6+ih])*(ih+1));
-        if(iVZEROside<2) {
-           if(fgUsedVars[kVZEROuQ+iVZEROside*6+ih]) {
-              values[kVZEROuQ+iVZEROside*6+ih] = TMath::Cos((values[kPhi]-values[kVZERORP+iVZEROside*6+ih])*(ih+1));
-              values[kVZEROuQ+iVZEROside*6+ih] *= TMath::Sqrt(values[kVZEROQvecX+iVZEROside*6+ih]*values[kVZEROQvecX+iVZEROside*6+ih] +
-              values[kVZEROQvecY+iVZEROside*6+ih]*values[kVZEROQvecY+iVZEROside*6+ih]); 
-           }
-           if(fgUsedVars[kVZEROuQsine+iVZEROside*6+ih]) {
-              values[kVZEROuQsine+iVZEROside*6+ih] = TMath::Sin((values[kPhi]-values[kVZERORP+iVZEROside*6+ih])*(ih+1));
-              values[kVZEROuQsine+iVZEROside*6+ih] *= TMath::Sqrt(values[kVZEROQvecX+iVZEROside*6+ih]*values[kVZEROQvecX+iVZEROside*6+ih] +
-              values[kVZEROQvecY+iVZEROside*6+ih]*values[kVZEROQvecY+iVZEROside*6+ih]); 
-           }	    
-        }
-     }  // end loop over harmonics
-  }  // end loop over VZERO sides
-  
-  // Fill TPC flow variables
-  // Subtract the q vector of the track or of the pair legs from the event q-vector 
-  Bool_t tpcEPUsed = kFALSE;
-  for(Int_t ih=0; ih<6; ++ih) {
-     if(fgUsedVars[kTPCFlowVn+ih]) {tpcEPUsed = kTRUE; break;}
-     if(fgUsedVars[kTPCFlowSine+ih]) {tpcEPUsed = kTRUE; break;}
-     if(fgUsedVars[kTPCuQ+ih]) {tpcEPUsed = kTRUE; break;}
-     if(fgUsedVars[kTPCuQsine+ih]) {tpcEPUsed = kTRUE; break;}
-  }
-
-  if(tpcEPUsed) {
-     Float_t tpcEPsubtracted[6] = {0.0};
-     Double_t qVec[6][2] = {{0.0}};
-     for(Int_t ih=0; ih<6; ++ih) {qVec[ih][0]=values[kTPCQvecXtotal+ih]; qVec[ih][1]=values[kTPCQvecYtotal+ih];}
-     EVENT* eventInfo = NULL;
-     if(fgEvent->IsA()==EVENT::Class()) eventInfo = (EVENT*)fgEvent;
-     if((p->IsA() == AliReducedTrackInfo::Class()) && eventInfo) {
-        eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)p,qVec,EVENTPLANE::kTPC,-0.8,-0.5*fgkTPCQvecRapGap);
-        eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)p,qVec,EVENTPLANE::kTPC,0.5*fgkTPCQvecRapGap,0.8);
-     }
-
-     // TODO: Make sure the pair legs are properly subtracted from the TPC event plane calculation
-     //              For the moment this part of the code is commented out
-     /* else if((p->IsA() == AliReducedPairInfo::Class()) && eventInfo) {
-        cout<<"id  "<<((AliReducedPairInfo*)p)->LegId(1)<<endl;
-        eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)eventInfo->GetTrack(((AliReducedPairInfo*)p)->LegId(0)),qVec,EVENTPLANE::kTPC,-0.8,-0.5*fgkTPCQvecRapGap);
-        eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)eventInfo->GetTrack(((AliReducedPairInfo*)p)->LegId(0)),qVec,EVENTPLANE::kTPC,0.5*fgkTPCQvecRapGap,0.8);
-        eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)eventInfo->GetTrack(((AliReducedPairInfo*)p)->LegId(1)),qVec,EVENTPLANE::kTPC,-0.8,-0.5*fgkTPCQvecRapGap);
-        eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)eventInfo->GetTrack(((AliReducedPairInfo*)p)->LegId(1)),qVec,EVENTPLANE::kTPC,0.5*fgkTPCQvecRapGap,0.8);
-     }  */
-     // recalculate the TPC event plane
-     for(Int_t ih=0; ih<6;++ih) 
-        tpcEPsubtracted[ih] = TMath::ATan2(qVec[ih][1], qVec[ih][0])/Double_t(ih+1);
-     for(Int_t ih=0; ih<6; ++ih) {
-        // vn using Psi_n
-        if(fgUsedVars[kTPCFlowVn+ih])
-           values[kTPCFlowVn+ih] = TMath::Cos(DeltaPhi(values[kPhi],tpcEPsubtracted[ih])*(ih+1));
-        if(fgUsedVars[kTPCFlowSine+ih]) 
-           values[kTPCFlowSine+ih] = TMath::Sin(DeltaPhi(values[kPhi],tpcEPsubtracted[ih])*(ih+1));
-        if(fgUsedVars[kTPCuQ+ih]) {
-           values[kTPCuQ+ih] = TMath::Cos((values[kPhi]-tpcEPsubtracted[ih])*(ih+1));
-           values[kTPCuQ+ih] *= TMath::Sqrt(qVec[ih][0]*qVec[ih][0] + qVec[ih][1]*qVec[ih][1]);
-        }
-        if(fgUsedVars[kTPCuQsine+ih]) {
-           values[kTPCuQsine+ih] = TMath::Sin((values[kPhi]-tpcEPsubtracted[ih])*(ih+1));
-           values[kTPCuQsine+ih] *= TMath::Sqrt(qVec[ih][0]*qVec[ih][0] + qVec[ih][1]*qVec[ih][1]);
-        }
-     }
+  // Execute the evaluation plan: only the steps needed by the used variables, in dependency order
+  for(Int_t istep=0; istep<fgNTrackFillSteps; ++istep) {
+    switch(fgTrackFillPlan[istep]) {
+      case kFillHarmonics :
+        FillTrackHarmonics(p, values);
+        break;
+      case kFillPairEfficiency :
+        FillTrackPairEfficiency(values);
+        break;
+      case kFillVZEROFlow :
+        FillTrackVZEROFlow(values);
+        break;
+      case kFillTPCFlow :
+        FillTrackTPCFlow(p, values);
+        break;
+      default :
+        break;
+    }
   }
 
   if(p->IsA()!=TRACK::Class()) return;
@@ -8,6 +8,8 @@
 #ifndef ALIREDUCEDVARMANAGER_H
 #define ALIREDUCEDVARMANAGER_H
 
+#include <vector>
+
 #include <TObject.h>
 #include <TString.h>
 #include <TChain.h>
@@ -652,6 +654,26 @@ class AliReducedVarManager : public TObject {
                                                  //   when a variable is used
   static void SetVariableDependencies();       // toggle those variables on which other used variables might depend 
   
+  // evaluation plan of FillTrackInfo(): ordered list of the fill steps needed by the used variables,
+  //   rebuilt from fgUsedVars whenever the used variables change (see BuildTrackFillPlan())
+  enum TrackFillSteps {
+    kFillHarmonics=0,       // cos(n*phi), sin(n*phi)
+    kFillPairEfficiency,    // pair efficiency from the 2D map
+    kFillVZEROFlow,         // flow variables w.r.t. the VZERO event plane
+    kFillTPCFlow,           // flow variables w.r.t. the TPC event plane, with the track removed from the Q-vector
+    kNTrackFillSteps
+  };
+  static Int_t fgTrackFillPlan[kNTrackFillSteps];   // fill steps to be executed, in order
+  static Int_t fgNTrackFillSteps;                   // number of fill steps in the plan
+  static std::vector<Int_t> fgHarmonicsPlan;        // harmonics (1-6) for which cos(n*phi) or sin(n*phi) is used
+  static std::vector<Int_t> fgVZEROFlowPlan;        // VZERO side*6+harmonic for which a VZERO flow variable is used
+  static std::vector<Int_t> fgTPCFlowPlan;          // harmonics (0-5) for which a TPC flow variable is used
+  static void BuildTrackFillPlan();
+  static void FillTrackHarmonics(AliReducedBaseTrack* p, Float_t* values);
+  static void FillTrackPairEfficiency(Float_t* values);
+  static void FillTrackVZEROFlow(Float_t* values);
+  static void FillTrackTPCFlow(AliReducedBaseTrack* p, Float_t* values);
+  
 
   static Double_t DeltaPhi(Double_t phi1, Double_t phi2);  
   static void GetThetaPhiCM(AliReducedBaseTrack* leg1, AliReducedBaseTrack* leg2,
@@ -48,6 +48,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     void CalculatePi0Candidates();
     void CalculateBackground();
     void CalculateBackgroundRP();
+    void FillBackgroundCandidate(const AliAODConversionPhoton *gamma0, const AliAODConversionPhoton *gamma1, Int_t zbin, Int_t mbin);
     void ProcessMCParticles();
     void ProcessAODMCParticles();
     void RelabelAODPhotonCandidates(Bool_t mode);
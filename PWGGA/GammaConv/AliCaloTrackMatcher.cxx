@@ -47,6 +47,31 @@ using namespace std;
 
 ClassImp(AliCaloTrackMatcher)
 
+namespace {
+  // Stable counting sort of the match records by a non-negative ID (cluster or track ID). offsets[id] and
+  // offsets[id+1] delimit the records of id in sorted. Records with negative IDs are not indexed.
+  // If setIndex, fIndex of every record is set to its position in sorted.
+  void SortMatches(vector<AliCaloTrackMatcher::MatchRecord> &matches, vector<AliCaloTrackMatcher::MatchRecord> &sorted,
+                   vector<Int_t> &offsets, Int_t AliCaloTrackMatcher::MatchRecord::*id, Bool_t setIndex){
+    Int_t maxID = -1;
+    for(UInt_t i = 0; i < matches.size(); i++) if(matches[i].*id > maxID) maxID = matches[i].*id;
+    offsets.assign(maxID+2,0);
+    for(UInt_t i = 0; i < matches.size(); i++) if(matches[i].*id >= 0) offsets[matches[i].*id+1]++;
+    for(Int_t j = 0; j <= maxID; j++) offsets[j+1] += offsets[j];
+    sorted.resize(offsets[maxID+1]);
+    // place the records at the start of their ID, advancing it, then shift the starts back
+    for(UInt_t i = 0; i < matches.size(); i++){
+      if(matches[i].*id < 0) continue;
+      Int_t pos = offsets[matches[i].*id]++;
+      if(setIndex) matches[i].fIndex = pos;
+      sorted[pos] = matches[i];
+    }
+    for(Int_t j = maxID; j > 0; j--) offsets[j] = offsets[j-1];
+    offsets[0] = 0;
+  }
+}
+}
+
 //________________________________________________________________________
 AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType) : AliAnalysisTaskSE(name),
   fClusterType(clusterType),
@@ -58,11 +83,12 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType) :
   fRunNumber(-1),
   fGeomEMCAL(NULL),
   fGeomPHOS(NULL),
-  fMapTrackToCluster(),
-  fMapClusterToTrack(),
-  fNEntries(1),
-  fVectorDeltaEtaDeltaPhi(0),
-  fMap_TrID_ClID_ToIndex(),
+  fMatches(),
+  fMatchesByCluster(),
+  fMatchesByTrack(),
+  fClusterOffsets(),
+  fTrackOffsets(),
+  fPtDepWindows(),
   fSecMapTrackToCluster(),
   fSecMapClusterToTrack(),
   fSecNEntries(1),
@@ -80,10 +106,12 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType) :
 //________________________________________________________________________
 AliCaloTrackMatcher::~AliCaloTrackMatcher(){
     // default deconstructor
-    fMapTrackToCluster.clear();
-    fMapClusterToTrack.clear();
-    fVectorDeltaEtaDeltaPhi.clear();
-    fMap_TrID_ClID_ToIndex.clear();
+    fMatches.clear();
+    fMatchesByCluster.clear();
+    fMatchesByTrack.clear();
+    fClusterOffsets.clear();
+    fTrackOffsets.clear();
+    fPtDepWindows.clear();
 
     fSecMapTrackToCluster.clear();
     fSecMapClusterToTrack.clear();
@@ -102,10 +130,12 @@ AliCaloTrackMatcher::~AliCaloTrackMatcher(){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::Terminate(Option_t *){
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
-  fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
+  fMatches.clear();
+  fMatchesByCluster.clear();
+  fMatchesByTrack.clear();
+  fClusterOffsets.clear();
+  fTrackOffsets.clear();
+  fPtDepWindows.clear();
 
   fSecMapTrackToCluster.clear();
   fSecMapClusterToTrack.clear();
@@ -155,11 +185,13 @@ void AliCaloTrackMatcher::UserCreateOutputObjects(){
 //________________________________________________________________________
 void AliCaloTrackMatcher::Initialize(Int_t runNumber){
   // Initialize function to be called once before analysis
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
-  fNEntries = 1;
-  fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
+  // keep the capacity of the match records from one event to the next
+  fMatches.clear();
+  fMatchesByCluster.clear();
+  fMatchesByTrack.clear();
+  fClusterOffsets.clear();
+  fTrackOffsets.clear();
+  for(map<TF1*,vector<Double_t> >::iterator it = fPtDepWindows.begin(); it != fPtDepWindows.end(); ++it) it->second.clear();
 
   fSecMapTrackToCluster.clear();
   fSecMapClusterToTrack.clear();
@@ -406,25 +438,36 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
 //cout << dEta << " - " << dPhi << " - " << dR2 << endl;
       if(dR2 > fMatchingResidual) continue;
       nClusterMatchesToTrack++;
-      if(aodev){
-        fMapTrackToCluster.insert(make_pair(itr,cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),itr));
-      }else{
-        fMapTrackToCluster.insert(make_pair(inTrack->GetID(),cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),inTrack->GetID()));
-      }
-      fVectorDeltaEtaDeltaPhi.push_back(make_pair(dEta,dPhi));
-      fMap_TrID_ClID_ToIndex[make_pair(inTrack->GetID(),cluster->GetID())] = fNEntries++;
-      if( (Int_t)fVectorDeltaEtaDeltaPhi.size() != (fNEntries-1)) AliFatal("Fatal error in AliCaloTrackMatcher, vector and map are not in sync!");
+      MatchRecord match;
+      match.fCluster = cluster->GetID();
+      match.fTrack   = aodev ? itr : inTrack->GetID();
+      match.fTrackID = inTrack->GetID();
+      match.fIndex   = -1;
+      match.fCharge  = inTrack->Charge();
+      match.fPt      = inTrack->Pt();
+      match.fDEta    = dEta;
+      match.fDPhi    = dPhi;
+      fMatches.push_back(match);
     }
     if(nClusterMatchesToTrack == 0) fHistControlMatches->Fill(5.,inTrack->Pt());
     else fHistControlMatches->Fill(6.,inTrack->Pt());
     delete trackParam;
   }
 
+  BuildMatchIndex();
   return;
 }
 
+//________________________________________________________________________
+void AliCaloTrackMatcher::BuildMatchIndex(){
+  // Order the matches of the event by cluster and by track ID and fill the offset tables, such that all
+  // matches of a cluster or track are found without searching. Matches of the same cluster (track) stay
+  // in the order in which they were found.
+  SortMatches(fMatches,fMatchesByCluster,fClusterOffsets,&MatchRecord::fCluster,kTRUE);
+  // the records by track keep fIndex, the position of the same match in fMatchesByCluster
+  SortMatches(fMatches,fMatchesByTrack,fTrackOffsets,&MatchRecord::fTrackID,kFALSE);
+}
+
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliVTrack* inSecTrack, AliVCluster* cluster, AliVEvent* event, Float_t &dEta, Float_t &dPhi){
 
@@ -603,348 +646,206 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForCluster(clusterID,nMatches);
+  for(Int_t i = 0; i < nMatches; i++){
+    if(matches[i].fTrackID != trackID) continue;
+    dEta = matches[i].fDEta;
+    dPhi = matches[i].fDPhi;
+    return kTRUE;
+  }
+  return kFALSE;
+}
 
-  pairFloat tempEtaPhi = fVectorDeltaEtaDeltaPhi.at(position-1);
-  dEta = tempEtaPhi.first;
-  dPhi = tempEtaPhi.second;
-  return kTRUE;
+//________________________________________________________________________
+const AliCaloTrackMatcher::MatchRecord* AliCaloTrackMatcher::GetMatchesForCluster(Int_t clusterID, Int_t &nMatches) const{
+  nMatches = 0;
+  if(clusterID < 0 || clusterID+1 >= (Int_t)fClusterOffsets.size()) return NULL;
+  nMatches = fClusterOffsets[clusterID+1] - fClusterOffsets[clusterID];
+  return nMatches > 0 ? &fMatchesByCluster[fClusterOffsets[clusterID]] : NULL;
 }
+
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
-    }
-  }
+const AliCaloTrackMatcher::MatchRecord* AliCaloTrackMatcher::GetMatchesForTrack(Int_t trackID, Int_t &nMatches) const{
+  nMatches = 0;
+  if(trackID < 0 || trackID+1 >= (Int_t)fTrackOffsets.size()) return NULL;
+  nMatches = fTrackOffsets[trackID+1] - fTrackOffsets[trackID];
+  return nMatches > 0 ? &fMatchesByTrack[fTrackOffsets[trackID]] : NULL;
+}
 
-  return matched;
+//________________________________________________________________________
+const Double_t* AliCaloTrackMatcher::GetPtDepWindows(TF1* func){
+  // func evaluated at the track pT of every match in fMatchesByCluster, computed once per event and function
+  vector<Double_t> &windows = fPtDepWindows[func];
+  if(windows.size() != fMatchesByCluster.size()){
+    windows.resize(fMatchesByCluster.size());
+    for(UInt_t i = 0; i < fMatchesByCluster.size(); i++) windows[i] = func->Eval(fMatchesByCluster[i].fPt);
+  }
+  return windows.empty() ? NULL : &windows[0];
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
+Int_t AliCaloTrackMatcher::SelectMatches(const MatchRecord* matches, Int_t nMatches, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, Bool_t clusters, vector<Int_t>* selected) const{
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )matched++;
-      }
+  for(Int_t i = 0; i < nMatches; i++){
+    const MatchRecord &match = matches[i];
+    Bool_t isMatched = kFALSE;
+    if(match.fCharge>0){
+      isMatched = (dEtaMin < match.fDEta) && (match.fDEta < dEtaMax) && (dPhiMin < match.fDPhi) && (match.fDPhi < dPhiMax);
+    }else if(match.fCharge<0){
+      dPhiMin*=-1;
+      dPhiMax*=-1;
+      isMatched = (dEtaMin < match.fDEta) && (match.fDEta < dEtaMax) && (dPhiMin > match.fDPhi) && (match.fDPhi > dPhiMax);
     }
+    if(!isMatched) continue;
+    matched++;
+    if(selected) selected->push_back(clusters ? match.fCluster : match.fTrack);
   }
   return matched;
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
+Int_t AliCaloTrackMatcher::SelectMatches(const MatchRecord* matches, Int_t nMatches, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, Bool_t clusters, vector<Int_t>* selected){
+  if(nMatches == 0) return 0;
+  const Double_t* windowsEta = GetPtDepWindows(fFuncPtDepEta);
+  const Double_t* windowsPhi = GetPtDepWindows(fFuncPtDepPhi);
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
+  for(Int_t i = 0; i < nMatches; i++){
+    const MatchRecord &match = matches[i];
+    Double_t windowEta = match.fIndex >= 0 ? windowsEta[match.fIndex] : fFuncPtDepEta->Eval(match.fPt);
+    Double_t windowPhi = match.fIndex >= 0 ? windowsPhi[match.fIndex] : fFuncPtDepPhi->Eval(match.fPt);
+    if( TMath::Abs(match.fDEta) < windowEta && TMath::Abs(match.fDPhi) < windowPhi ){
+      matched++;
+      if(selected) selected->push_back(clusters ? match.fCluster : match.fTrack);
     }
   }
   return matched;
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+Int_t AliCaloTrackMatcher::SelectMatches(const MatchRecord* matches, Int_t nMatches, Float_t dR, Bool_t clusters, vector<Int_t>* selected) const{
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
+  for(Int_t i = 0; i < nMatches; i++){
+    const MatchRecord &match = matches[i];
+    if (TMath::Sqrt(match.fDEta*match.fDEta + match.fDPhi*match.fDPhi) < dR ){
+      matched++;
+      if(selected) selected->push_back(clusters ? match.fCluster : match.fTrack);
     }
   }
   return matched;
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent* /*event*/, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForCluster(clusterID,nMatches);
+  return SelectMatches(matches,nMatches,dEtaMax,dEtaMin,dPhiMax,dPhiMin,kFALSE,NULL);
+}
 
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent* /*event*/, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForCluster(clusterID,nMatches);
+  return SelectMatches(matches,nMatches,fFuncPtDepEta,fFuncPtDepPhi,kFALSE,NULL);
+}
 
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent* /*event*/, Int_t clusterID, Float_t dR){
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForCluster(clusterID,nMatches);
+  return SelectMatches(matches,nMatches,dR,kFALSE,NULL);
+}
 
-        if (match_dPhi && match_dEta )matched++;
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent* /*event*/, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForTrack(trackID,nMatches);
+  return SelectMatches(matches,nMatches,dEtaMax,dEtaMin,dPhiMax,dPhiMin,kTRUE,NULL);
+}
 
-      }
-    }
-  }
-  return matched;
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent* /*event*/, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForTrack(trackID,nMatches);
+  return SelectMatches(matches,nMatches,fFuncPtDepEta,fFuncPtDepPhi,kTRUE,NULL);
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent* /*event*/, Int_t trackID, Float_t dR){
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForTrack(trackID,nMatches);
+  return SelectMatches(matches,nMatches,dR,kTRUE,NULL);
+}
 
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
-    }
-  }
-  return matched;
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent* /*event*/, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, vector<Int_t> &matchedTracks){
+  matchedTracks.clear();
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForCluster(clusterID,nMatches);
+  return SelectMatches(matches,nMatches,dEtaMax,dEtaMin,dPhiMax,dPhiMin,kFALSE,&matchedTracks);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent* /*event*/, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, vector<Int_t> &matchedTracks){
+  matchedTracks.clear();
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForCluster(clusterID,nMatches);
+  return SelectMatches(matches,nMatches,fFuncPtDepEta,fFuncPtDepPhi,kFALSE,&matchedTracks);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent* /*event*/, Int_t clusterID, Float_t dR, vector<Int_t> &matchedTracks){
+  matchedTracks.clear();
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForCluster(clusterID,nMatches);
+  return SelectMatches(matches,nMatches,dR,kFALSE,&matchedTracks);
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }
-      }
-    }
-  }
+  GetMatchedTrackIDsForCluster(event,clusterID,dEtaMax,dEtaMin,dPhiMax,dPhiMin,tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedTracks.push_back(it->second);
-
-      }
-    }
-  }
+  GetMatchedTrackIDsForCluster(event,clusterID,fFuncPtDepEta,fFuncPtDepPhi,tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  Float_t dR){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(it->second);
-      }
-    }
-  }
+  GetMatchedTrackIDsForCluster(event,clusterID,dR,tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
-vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent* /*event*/, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }
-      }
-    }
-  }
-
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForTrack(trackID,nMatches);
+  SelectMatches(matches,nMatches,dEtaMax,dEtaMin,dPhiMax,dPhiMin,kTRUE,&tempMatchedClusters);
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
-vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent* /*event*/, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedClusters.push_back(it->second);
-      }
-    }
-  }
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForTrack(trackID,nMatches);
+  SelectMatches(matches,nMatches,fFuncPtDepEta,fFuncPtDepPhi,kTRUE,&tempMatchedClusters);
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
-vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent* /*event*/, Int_t trackID, Float_t dR){
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(it->second);
-      }
-    }
-  }
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForTrack(trackID,nMatches);
+  SelectMatches(matches,nMatches,dR,kTRUE,&tempMatchedClusters);
   return tempMatchedClusters;
 }
 
@@ -954,7 +855,9 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetSecTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fSecMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
+  mapT::const_iterator it = fSecMap_TrID_ClID_ToIndex.find(make_pair(trackID,clusterID));
+  if(it == fSecMap_TrID_ClID_ToIndex.end()) return kFALSE;
+  Int_t position = it->second;
   if(position == 0) return kFALSE;
 
   pairFloat tempEtaPhi = fSecVectorDeltaEtaDeltaPhi.at(position-1);
@@ -964,15 +867,16 @@ Bool_t AliCaloTrackMatcher::GetSecTrackClusterMatchingResidual(Int_t trackID, In
 }
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::IsSecTrackClusterAlreadyTried(Int_t trackID, Int_t clusterID){
-  Int_t position = fSecMap_TrID_ClID_AlreadyTried[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  mapT::const_iterator it = fSecMap_TrID_ClID_AlreadyTried.find(make_pair(trackID,clusterID));
+  if(it == fSecMap_TrID_ClID_AlreadyTried.end() || it->second == 0) return kFALSE;
   else return kTRUE;
 }
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapClusterToTrack.upper_bound(clusterID);
+  for (it=fSecMapClusterToTrack.lower_bound(clusterID); it!=itEnd; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -996,7 +900,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, In
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapClusterToTrack.upper_bound(clusterID);
+  for (it=fSecMapClusterToTrack.lower_bound(clusterID); it!=itEnd; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -1022,7 +927,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, In
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapClusterToTrack.upper_bound(clusterID);
+  for (it=fSecMapClusterToTrack.lower_bound(clusterID); it!=itEnd; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -1054,7 +960,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapTrackToCluster.upper_bound(TrackPos);
+  for (it=fSecMapTrackToCluster.lower_bound(TrackPos); it!=itEnd; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1090,7 +997,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapTrackToCluster.upper_bound(TrackPos);
+  for (it=fSecMapTrackToCluster.lower_bound(TrackPos); it!=itEnd; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1129,7 +1037,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapTrackToCluster.upper_bound(TrackPos);
+  for (it=fSecMapTrackToCluster.lower_bound(TrackPos); it!=itEnd; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1145,7 +1054,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapClusterToTrack.upper_bound(clusterID);
+  for (it=fSecMapClusterToTrack.lower_bound(clusterID); it!=itEnd; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -1169,7 +1079,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *ev
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapClusterToTrack.upper_bound(clusterID);
+  for (it=fSecMapClusterToTrack.lower_bound(clusterID); it!=itEnd; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -1195,7 +1106,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *ev
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   vector<Int_t> tempMatchedTracks;
   multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapClusterToTrack.upper_bound(clusterID);
+  for (it=fSecMapClusterToTrack.lower_bound(clusterID); it!=itEnd; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -1227,7 +1139,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapTrackToCluster.upper_bound(TrackPos);
+  for (it=fSecMapTrackToCluster.lower_bound(TrackPos); it!=itEnd; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1263,7 +1176,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapTrackToCluster.upper_bound(TrackPos);
+  for (it=fSecMapTrackToCluster.lower_bound(TrackPos); it!=itEnd; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1301,7 +1215,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
   multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
+  multimap<Int_t,Int_t>::iterator itEnd = fSecMapTrackToCluster.upper_bound(TrackPos);
+  for (it=fSecMapTrackToCluster.lower_bound(TrackPos); it!=itEnd; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1316,12 +1231,14 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
 //________________________________________________________________________
 Float_t AliCaloTrackMatcher::SumTrackEtAroundCluster(AliVEvent* event, Int_t clusterID, Float_t dR){
   Float_t sumTrackEt = 0.;
-  vector<Int_t> labelsMatched = GetMatchedTrackIDsForCluster(event, clusterID, dR);
-  if((Int_t) labelsMatched.size()<1) return sumTrackEt;
+  Int_t nMatches = 0;
+  const MatchRecord* matches = GetMatchesForCluster(clusterID,nMatches);
+  if(nMatches<1) return sumTrackEt;
 
   TLorentzVector vecTrack;
-  for (UInt_t i = 0; i < labelsMatched.size(); i++){
-    AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(labelsMatched.at(i)));
+  for (Int_t i = 0; i < nMatches; i++){
+    if (TMath::Sqrt(matches[i].fDEta*matches[i].fDEta + matches[i].fDPhi*matches[i].fDPhi) >= dR) continue;
+    AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(matches[i].fTrack));
     if(!currTrack) continue;
     vecTrack.SetPxPyPzE(currTrack->Px(),currTrack->Py(),currTrack->Pz(),currTrack->E());
     sumTrackEt += vecTrack.Et();
@@ -1386,18 +1303,15 @@ void AliCaloTrackMatcher::DebugV0Matching(){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::DebugMatching(){
-  if(fVectorDeltaEtaDeltaPhi.size()>0){
+  if(fMatches.size()>0){
     cout << "******************************" << endl;
     cout << "******************************" << endl;
     cout << "NEW EVENT !" << endl;
-    cout << "vector etaphi:" << endl;
-    cout << fVectorDeltaEtaDeltaPhi.size() << endl;
-    cout << "multimap" << endl;
-    mapT::iterator iter = fMap_TrID_ClID_ToIndex.begin();
-    for (iter = fMap_TrID_ClID_ToIndex.begin(); iter != fMap_TrID_ClID_ToIndex.end(); ++iter){
-      Float_t dEta, dPhi = 0;
-      if(!GetTrackClusterMatchingResidual(iter->first.first,iter->first.second,dEta,dPhi)) continue;
-      cout << "  [" << iter->first.first << "/" << iter->first.second << ", " << iter->second << "] - (" << dEta << "/" << dPhi << ")" << endl;
+    cout << "matches:" << endl;
+    cout << fMatches.size() << endl;
+    for (UInt_t i = 0; i < fMatchesByCluster.size(); i++){
+      const MatchRecord &match = fMatchesByCluster[i];
+      cout << "  [" << match.fTrackID << "/" << match.fCluster << ", " << i << "] - (" << match.fDEta << "/" << match.fDPhi << ")" << endl;
     }
     cout << "mapTrackToCluster" << endl;
     AliESDEvent *esdev = dynamic_cast<AliESDEvent*>(fInputEvent);
@@ -1410,11 +1324,10 @@ void AliCaloTrackMatcher::DebugMatching(){
       cout << itr << " (" << tCharge << ") - " << GetNMatchedClusterIDsForTrack(fInputEvent,inTrack->GetID(),5,-5,0.2,-0.4) << "\t\t";
     }
     cout << endl;
-    multimap<Int_t,Int_t>::iterator it;
-    for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    for (UInt_t i = 0; i < fMatchesByTrack.size(); i++) cout << fMatchesByTrack[i].fTrack << " => " << fMatchesByTrack[i].fCluster << '\n';
     cout << "mapClusterToTrack" << endl;
-    Int_t tempClus = it->second;
-    for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    Int_t tempClus = fMatchesByCluster.back().fCluster;
+    for (UInt_t i = 0; i < fMatchesByCluster.size(); i++) cout << fMatchesByCluster[i].fCluster << " => " << fMatchesByCluster[i].fTrack << '\n';
     vector<Int_t> tempTracks = GetMatchedTrackIDsForCluster(fInputEvent,tempClus, 5, -5, 0.2, -0.4);
     for(UInt_t iJ=0; iJ<tempTracks.size();iJ++){
       cout << tempClus << " - " << tempTracks.at(iJ) << endl;
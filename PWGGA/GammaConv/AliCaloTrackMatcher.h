@@ -32,9 +32,31 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     void SetMatchingResidual(Float_t res) {fMatchingResidual = res; return;}
     void SetMatchingWindow(Float_t win) {fMatchingWindow = win; return;}
 
+    // one track <-> cluster match of the current event
+    struct MatchRecord {
+      Int_t    fCluster;    // cluster ID
+      Int_t    fTrack;      // track position in the event (AOD) or track ID (ESD), as returned by GetMatchedTrackIDsForCluster
+      Int_t    fTrackID;    // track ID
+      Int_t    fIndex;      // position of the match in the cluster ordered records
+      Short_t  fCharge;     // track charge
+      Double_t fPt;         // track pT
+      Float_t  fDEta;       // matching residual in eta
+      Float_t  fDPhi;       // matching residual in phi
+    };
+
     // for cluster <-> primary matching
     Bool_t GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi);
 
+    // all matches of a cluster or a track, without selection and without copying: returns a pointer to
+    // nMatches consecutive records (NULL if there is none), valid until the next event is processed
+    const MatchRecord* GetMatchesForCluster(Int_t clusterID, Int_t &nMatches) const;
+    const MatchRecord* GetMatchesForTrack(Int_t trackID, Int_t &nMatches) const;
+
+    // same as the vector returning getters below, but filling matchedTracks (cleared first) to reuse its storage
+    Int_t GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, vector<Int_t> &matchedTracks);
+    Int_t GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, vector<Int_t> &matchedTracks);
+    Int_t GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR, vector<Int_t> &matchedTracks);
+
     Int_t GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin);
     Int_t GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi);
     Int_t GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR);
@@ -87,6 +109,13 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     // private methods
     void Initialize(Int_t runNumber);
     void ProcessEvent(AliVEvent *event);
+    void BuildMatchIndex();
+    const Double_t* GetPtDepWindows(TF1* func);
+
+    // selection of matches in a window, counting them and storing their cluster (or track) in selected, if given
+    Int_t SelectMatches(const MatchRecord* matches, Int_t nMatches, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, Bool_t clusters, vector<Int_t>* selected) const;
+    Int_t SelectMatches(const MatchRecord* matches, Int_t nMatches, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, Bool_t clusters, vector<Int_t>* selected);
+    Int_t SelectMatches(const MatchRecord* matches, Int_t nMatches, Float_t dR, Bool_t clusters, vector<Int_t>* selected) const;
     void SetLogBinningYTH2(TH2* histoRebin);
 
     // debug methods
@@ -105,12 +134,13 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     AliEMCALGeometry*     fGeomEMCAL;              // pointer to EMCAL geometry
     AliPHOSGeometry*      fGeomPHOS;               // pointer to PHOS geometry
 
-    multimap<Int_t,Int_t> fMapTrackToCluster;      // connects a given track ID with all associated cluster IDs
-    multimap<Int_t,Int_t> fMapClusterToTrack;      // connects a given cluster ID with all associated track IDs
-
-    Int_t                 fNEntries;               // number of current TrackID/ClusterID -> Eta/Phi connections
-    vector<pairFloat>     fVectorDeltaEtaDeltaPhi; // vector of all matching residuals for a specific TrackID/ClusterID
-    mapT                  fMap_TrID_ClID_ToIndex;  // map tuple of (trackID,clusterID) to index in vector fVectorDeltaEtaDeltaPhi
+    // track <-> cluster matches of the current event, rebuilt in place every event
+    vector<MatchRecord>   fMatches;                //! matches in the order they are found
+    vector<MatchRecord>   fMatchesByCluster;       //! matches ordered by cluster ID
+    vector<MatchRecord>   fMatchesByTrack;         //! matches ordered by track ID
+    vector<Int_t>         fClusterOffsets;         //! first match of cluster ID i in fMatchesByCluster at [i], end at [i+1]
+    vector<Int_t>         fTrackOffsets;           //! first match of track ID i in fMatchesByTrack at [i], end at [i+1]
+    map<TF1*,vector<Double_t> > fPtDepWindows;     //! pT dependent windows evaluated for every match in fMatchesByCluster, per function
 
     // for cluster <-> V0-track matching (running with different mass hypthesis)
     multimap<Int_t,Int_t> fSecMapTrackToCluster;      // connects a given secondary track ID with all associated cluster IDs
@@ -126,7 +156,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     TH2F*                 fHistControlMatches;     // bookkeeping for processed tracks/clusters and succesful matches
     TH2F*                 fSecHistControlMatches;  // bookkeeping for processed V0-tracks/clusters and succesful matches
 
-    ClassDef(AliCaloTrackMatcher,4)
+    ClassDef(AliCaloTrackMatcher,5)
 };
 
 #endif
@@ -39,8 +39,8 @@ AliConversionAODBGHandlerRP::AliConversionAODBGHandlerRP(Bool_t IsHeavyIon,Bool_
   fBinLimitsArrayRP(NULL),
   fBinLimitsArrayZ(NULL),
   fBinLimitsArrayMultiplicity(NULL),
-  fBGEvents(fNBinsRP,AliGammaConversionVertexPositionVector(fNBinsZ,AliGammaConversionBGEventVector(fNEvents)))
-//   fBGPool(fNBinsZ,AliGammaConversionMultiplicityVector(fNBinsMultiplicity,AliGammaConversionBGEventVector(fNEvents)))
+  fBGEvents(fNBinsRP,AliGammaConversionVertexPositionVector(fNBinsZ,AliGammaConversionBGEventVector(fNEvents))),
+  fBGPool(fNBinsRP*fNBinsZ*fNEvents)
 {
   
   // RP angle Binning  
@@ -126,19 +126,7 @@ AliConversionAODBGHandlerRP::~AliConversionAODBGHandlerRP()
     fBGEventCounter = NULL;
   }
 
-  // Delete pool
-
-  for(Int_t psi = 0; psi < fNBinsRP; psi++){
-    for(Int_t z = 0; z < fNBinsZ; z++){
-      for(Int_t eventCounter=0; eventCounter < fNBGEvents[psi][z] && eventCounter<fNEvents; eventCounter++){
-
-          for(UInt_t d=0; d < fBGEvents[psi][z][eventCounter].size(); d++){
-            delete (AliAODConversionPhoton*)(fBGEvents[psi][z][eventCounter][d]);
-
-          }
-      }   
-    }
-  }
+  // the photons are owned by fBGPool
 
   if(fNBGEvents){
     for(Int_t psi = 0; psi < fNBinsRP; psi++){
@@ -298,17 +286,7 @@ void AliConversionAODBGHandlerRP::AddEvent(TObjArray * const eventGammas,AliVEve
 
     Int_t eventCounter = fBGEventCounter[psi][z];
 
-    //clear the vector for old gammas
-    for(UInt_t d = 0; d < fBGEvents[psi][z][eventCounter].size(); d++){
-      delete (AliAODConversionPhoton*)(fBGEvents[psi][z][eventCounter][d]);
-    }
-
-    fBGEvents[psi][z][eventCounter].clear();
-
-    // add the gammas to the vector
-    for(Int_t i = 0; i < eventGammas->GetEntriesFast(); i++){
-      fBGEvents[psi][z][eventCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
-    }
+    StoreEvent(eventGammas,eventGammas->GetEntriesFast(),psi,z,eventCounter);
 
     fBGEventCounter[psi][z]++;
   }
@@ -333,19 +311,29 @@ void AliConversionAODBGHandlerRP::AddEvent(TList * const eventGammas,AliVEvent *
 
     Int_t eventCounter = fBGEventCounter[psi][z];
 
-    //clear the vector for old gammas
-    for(UInt_t d = 0; d < fBGEvents[psi][z][eventCounter].size(); d++){
-      delete (AliAODConversionPhoton*)(fBGEvents[psi][z][eventCounter][d]);
-    }
+    StoreEvent(eventGammas,eventGammas->GetEntries(),psi,z,eventCounter);
 
-    fBGEvents[psi][z][eventCounter].clear();
+    fBGEventCounter[psi][z]++;
+  }
+}
 
-    // add the gammas to the vector
-    for(Int_t i = 0; i < eventGammas->GetEntries(); i++){
-      fBGEvents[psi][z][eventCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
-    }
+//-------------------------------------------------------------
+void AliConversionAODBGHandlerRP::StoreEvent(TSeqCollection * const eventGammas,Int_t nGammas,Int_t psi,Int_t z,Int_t eventCounter){
+  // Replace the photons of the slot by copies of eventGammas. The copies are kept by value
+  // in the pool of the slot, which keeps its capacity, and the photon vector returned by
+  // GetBGGoodGammas points into it.
+
+  AliGammaConversionPhotonPool &pool = fBGPool[(psi*fNBinsZ+z)*fNEvents+eventCounter];
+  pool.clear();
+  pool.reserve(nGammas);
+  for(Int_t i = 0; i < nGammas; i++){
+    pool.push_back(*(AliAODConversionPhoton*)(eventGammas->At(i)));
+  }
 
-    fBGEventCounter[psi][z]++;
+  AliGammaConversionPhotonVector &photons = fBGEvents[psi][z][eventCounter];
+  photons.clear();
+  for(UInt_t i = 0; i < pool.size(); i++){
+    photons.push_back(&pool[i]);
   }
 }
 
@@ -18,6 +18,7 @@ typedef vector<AliAODConversionPhoton*> AliGammaConversionPhotonVector;
 typedef vector<AliGammaConversionPhotonVector> AliGammaConversionBGEventVector;         // Event contains vector of gammas (AliConversionPhotons)
 typedef vector<AliGammaConversionBGEventVector> AliGammaConversionVertexPositionVector;       // z vertex position ...
 typedef vector<AliGammaConversionVertexPositionVector> AliGammaConversionBGVector;       // RP angle
+typedef vector<AliAODConversionPhoton> AliGammaConversionPhotonPool;                    // Photon copies of one event, owned by the handler
 
 
 
@@ -77,12 +78,18 @@ class AliConversionAODBGHandlerRP: public TObject{
     Double_t*                   fBinLimitsArrayZ;                 //! bin limits z array
     Double_t*                   fBinLimitsArrayMultiplicity;      //! bin limit multiplicity array
     AliGammaConversionBGVector  fBGEvents;                        //background events
-//     AliGammaConversionBGVector  fBGPool;                          //background events
+    vector<AliGammaConversionPhotonPool> fBGPool;                 //! photon copies per (psi,z,event) slot, fBGEvents points into them
+
+    void StoreEvent                                 ( TSeqCollection * const eventGammas,
+                                                      Int_t nGammas,
+                                                      Int_t psi,
+                                                      Int_t z,
+                                                      Int_t eventCounter );
 
     AliConversionAODBGHandlerRP(AliConversionAODBGHandlerRP &original);
     AliConversionAODBGHandlerRP &operator=(const AliConversionAODBGHandlerRP &ref);
 
-  ClassDef(AliConversionAODBGHandlerRP,1);
+  ClassDef(AliConversionAODBGHandlerRP,2);
 
 };
 #endif
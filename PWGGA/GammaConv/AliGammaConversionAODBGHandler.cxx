@@ -45,7 +45,8 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(),
 	fBGEventsENeg(),
-	fBGEventsMeson()
+	fBGEventsMeson(),
+	fBGPhotonPools()
 {
 	// constructor
 }
@@ -66,7 +67,8 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t binsZ,Int_t
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fBGPhotonPools(binsZ*binsMultiplicity*nEvents)
 {
 	// constructor
 }
@@ -89,7 +91,8 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t collisionSy
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fBGPhotonPools(binsZ*binsMultiplicity*nEvents)
 {
 	// constructor
     if(fNBinsZ>8) fNBinsZ = 8;
@@ -361,9 +364,19 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(const AliGammaCon
 	fBinLimitsArrayMultiplicity(original.fBinLimitsArrayMultiplicity),
 	fBGEvents(original.fBGEvents),
 	fBGEventsENeg(original.fBGEventsENeg),
-	fBGEventsMeson(original.fBGEventsMeson)
+	fBGEventsMeson(original.fBGEventsMeson),
+	fBGPhotonPools(original.fBGPhotonPools)
 {
 	//copy constructor	
+	// the photon vectors have to point to the copied pools, not to the ones of the original
+	if(fBGPhotonPools.size() < (UInt_t)(fNBinsZ*fNBinsMultiplicity*fNEvents)) return;
+	for(Int_t z=0;z<fNBinsZ;z++){
+		for(Int_t m=0;m<fNBinsMultiplicity;m++){
+			for(Int_t event=0;event<fNEvents;event++){
+				LinkPhotonPool(z,m,event);
+			}
+		}
+	}
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -593,19 +606,31 @@ void AliGammaConversionAODBGHandler::AddEvent(TList* const eventGammas,Double_t
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-    for(UInt_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
-		delete (AliAODConversionPhoton*)(fBGEvents[z][m][eventCounter][d]);
-	}
-	fBGEvents[z][m][eventCounter].clear();
+	// the photons are copied by value into the pool of the slot, which keeps its capacity
+	// from one event to the next, instead of allocating every photon on the heap
+	AliGammaConversionPhotonPool &pool = fBGPhotonPools[PoolIndex(z,m,eventCounter)];
+	pool.clear();
+	pool.reserve(eventGammas->GetEntries());
 	
 	// add the gammas to the vector
 	for(Int_t i=0; i< eventGammas->GetEntries();i++){
-		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEvents[z][m][eventCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
+		pool.push_back(*(AliAODConversionPhoton*)(eventGammas->At(i)));
 	}
+	LinkPhotonPool(z,m,eventCounter);
 	fBGEventCounter[z][m]++;
 }
 
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::LinkPhotonPool(Int_t z, Int_t m, Int_t event){
+	// point the photon vector of the slot, as returned by GetBGGoodV0s, to the photons in its pool
+	AliGammaConversionPhotonPool &pool = fBGPhotonPools[PoolIndex(z,m,event)];
+	AliGammaConversionAODVector &photons = fBGEvents[z][m][event];
+	photons.clear();
+	for(UInt_t i=0;i<pool.size();i++){
+		photons.push_back(&pool[i]);
+	}
+}
+
 //_____________________________________________________________________________________________________________________________
 void AliGammaConversionAODBGHandler::AddMesonEvent(TList* const eventMothers, Double_t xvalue, Double_t yvalue, Double_t zvalue, Int_t multiplicity, Double_t epvalue){
 
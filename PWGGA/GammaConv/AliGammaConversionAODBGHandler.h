@@ -43,6 +43,8 @@ class AliGammaConversionAODBGHandler : public TObject {
 	typedef std::vector<AliGammaConversionMotherAODVector> AliGammaConversionMotherBGEventVector;
 	typedef std::vector<AliGammaConversionMotherBGEventVector> AliGammaConversionMotherMultipicityVector;
 	typedef std::vector<AliGammaConversionMotherMultipicityVector> AliGammaConversionMotherBGVector;
+
+	typedef std::vector<AliAODConversionPhoton> AliGammaConversionPhotonPool;
 	
 
 	AliGammaConversionAODBGHandler();																							//constructor
@@ -84,6 +86,10 @@ class AliGammaConversionAODBGHandler : public TObject {
 
 	private:
 
+		// index of the (z, multiplicity, event) slot in fBGPhotonPools
+		Int_t PoolIndex(Int_t z, Int_t m, Int_t event) const {return (z*fNBinsMultiplicity+m)*fNEvents+event;}
+		void LinkPhotonPool(Int_t z, Int_t m, Int_t event);
+
 		Int_t 								fNEvents; 						// number of events
 		Int_t ** 							fBGEventCounter;				//! bg counter
 		Int_t ** 							fBGEventENegCounter;			//! bg electron counter
@@ -98,7 +104,8 @@ class AliGammaConversionAODBGHandler : public TObject {
 		AliGammaConversionBGVector 			fBGEvents; 						// photon background events
 		AliGammaConversionBGVector 			fBGEventsENeg; 					// electron background electron events
 		AliGammaConversionMotherBGVector 	fBGEventsMeson; 				// neutral meson background events
+		std::vector<AliGammaConversionPhotonPool> fBGPhotonPools;			//! photon copies per (z,m,event) slot, fBGEvents points into them
 		
-	ClassDef(AliGammaConversionAODBGHandler,6)
+	ClassDef(AliGammaConversionAODBGHandler,7)
 };
 #endif
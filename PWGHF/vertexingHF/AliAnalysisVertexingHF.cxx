@@ -70,11 +70,22 @@
 #include "AliCodeTimer.h"
 #include "AliMultSelection.h"
 #include <cstring>
+#include <algorithm>
 
 /// \cond CLASSIMP
 ClassImp(AliAnalysisVertexingHF);
 /// \endcond
 
+// above this number of selected tracks the pair DCAs are not cached (memory ~ n^2/2)
+static const Int_t kMaxTrksPairDCACache = 3000;
+
+//----------------------------------------------------------------------------
+static UInt_t FirstInCell(const std::vector<Int_t> &cell,Int_t iTrk)
+{
+  /// position of the first track with index >= iTrk in a cell of track indices
+  return std::lower_bound(cell.begin(),cell.end(),iTrk)-cell.begin();
+}
+
 //----------------------------------------------------------------------------
 AliAnalysisVertexingHF::AliAnalysisVertexingHF():
 fInputAOD(kFALSE),
@@ -138,6 +149,7 @@ fFindVertexForDstar(kTRUE),
 fFindVertexForCascades(kTRUE),
 fV0TypeForCascadeVertex(0),
 fMassCutBeforeVertexing(kFALSE),
+fPairMassCutBeforeVertexing(kFALSE),
 fMassCalc2(0),
 fMassCalc3(0),
 fMassCalc4(0),
@@ -157,7 +169,9 @@ fMassDplus(0.),
 fMassDs(0.),
 fMassLambdaC(0.),
 fMassDstar(0.),
-fMassJpsi(0.)
+fMassJpsi(0.),
+fStageCounts(),
+fPairDCA()
 {
   /// Default constructor
 
@@ -233,6 +247,7 @@ fFindVertexForDstar(source.fFindVertexForDstar),
 fFindVertexForCascades(source.fFindVertexForCascades),
 fV0TypeForCascadeVertex(source.fV0TypeForCascadeVertex),
 fMassCutBeforeVertexing(source.fMassCutBeforeVertexing),
+fPairMassCutBeforeVertexing(source.fPairMassCutBeforeVertexing),
 fMassCalc2(source.fMassCalc2),
 fMassCalc3(source.fMassCalc3),
 fMassCalc4(source.fMassCalc4),
@@ -252,7 +267,9 @@ fMassDplus(source.fMassDplus),
 fMassDs(source.fMassDs),
 fMassLambdaC(source.fMassLambdaC),
 fMassDstar(source.fMassDstar),
-fMassJpsi(source.fMassJpsi)
+fMassJpsi(source.fMassJpsi),
+fStageCounts(),
+fPairDCA()
 {
   ///
   /// Copy constructor
@@ -327,6 +344,7 @@ AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVerte
   fFindVertexForCascades = source.fFindVertexForCascades;
   fV0TypeForCascadeVertex = source.fV0TypeForCascadeVertex;
   fMassCutBeforeVertexing = source.fMassCutBeforeVertexing;
+  fPairMassCutBeforeVertexing = source.fPairMassCutBeforeVertexing;
   fMassCalc2 = source.fMassCalc2;
   fMassCalc3 = source.fMassCalc3;
   fMassCalc4 = source.fMassCalc4;
@@ -618,6 +636,31 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // Stage 1 inputs: the selected tracks are sorted once into cells of
+  // (charge, single-track selection bits), in increasing track index, so that
+  // the combinatorial loops below only visit tracks that can pass their
+  // per-track checks; momenta at the primary vertex for the pair pre-filter.
+  std::vector<Int_t> cellDispl,cellDisplNeg,cellDisplNeg3Prong,cellDisplPos3Prong,cellSoftPi;
+  std::vector<Double_t> momAtVertex(3*nSeleTrks);
+  for(Int_t iTrk=0; iTrk<nSeleTrks; iTrk++) {
+    ((AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrk))->GetPxPyPz(&momAtVertex[3*iTrk]);
+    if(TESTBIT(seleFlags[iTrk],kBitSoftPi)) cellSoftPi.push_back(iTrk);
+    if(!TESTBIT(seleFlags[iTrk],kBitDispl)) continue;
+    cellDispl.push_back(iTrk);
+    Short_t charge = ((AliESDtrack*)seleTrksArray.UncheckedAt(iTrk))->Charge();
+    Bool_t is3Prong = TESTBIT(seleFlags[iTrk],kBit3Prong);
+    if(charge<=0) cellDisplNeg.push_back(iTrk);
+    if(charge<=0 && is3Prong) cellDisplNeg3Prong.push_back(iTrk);
+    if(charge>=0 && is3Prong) cellDisplPos3Prong.push_back(iTrk);
+  }
+  const std::vector<Int_t> &cellN1 = (fLikeSign ? cellDispl : cellDisplNeg);
+  // pair DCAs are reused by the 3- and 4-prong loops
+  if((f3Prong || f4Prong) && nSeleTrks<=kMaxTrksPairDCACache) {
+    fPairDCA.assign((Long64_t)nSeleTrks*(nSeleTrks-1)/2,-1.);
+  } else {
+    fPairDCA.clear();
+  }
+
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -760,6 +803,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
           // DCA between the two tracks
           dcaCasc = postrack1->GetDCA(trackV0,fBzkG,xdummy,ydummy);
           // Vertexing+
+          fStageCounts[kVertexFits]++;
           vertexCasc = ReconstructSecondaryVertex(twoTrackArrayCasc,dispersion,kFALSE);
         } else {
           // assume Cascade decays at the primary vertex
@@ -782,6 +826,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
         // Create and store the Cascade if passed the cuts
         ioCascade = MakeCascade(twoTrackArrayCasc,event,vertexCasc,v0,dcaCasc,okCascades);
+        if(ioCascade) fStageCounts[kCandidates]++;
         if(okCascades && ioCascade) {
           //AliDebug(1,Form("Storing a cascade object... "));
           // add the vertex and the cascade to the AOD
@@ -828,7 +873,8 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
     if(postrack1->Charge()<0 && !fLikeSign) continue;
 
     // LOOP ON  NEGATIVE  TRACKS
-    for(iTrkN1=0; iTrkN1<nSeleTrks; iTrkN1++) {
+    for(UInt_t jTrkN1=0; jTrkN1<cellN1.size(); jTrkN1++) {
+      iTrkN1 = cellN1[jTrkN1];
 
       //if(iTrkN1%1==0) AliDebug(1,Form("    1st loop on neg: track number %d of %d",iTrkN1,nSeleTrks));
       //if(iTrkN1%1==0) printf("    1st loop on neg: track number %d of %d\n",iTrkN1,nSeleTrks);
@@ -867,12 +913,27 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       negtrack1->GetPxPyPz(momneg1);
 
       // DCA between the two tracks
-      dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+      fStageCounts[kPairs]++;
+      dcap1n1 = GetPairDCA(postrack1,iTrkP1,negtrack1,iTrkN1);
       if(dcap1n1>dcaMax) { negtrack1=0; continue; }
+      fStageCounts[kPairsDCA]++;
+
+      // kinematic pre-filter of the pair (momenta at the primary vertex),
+      // the vertex is needed anyway if the pair seeds 3- or 4-prongs
+      Bool_t pairMassOK=kTRUE;
+      if(fPairMassCutBeforeVertexing) {
+	Double_t pxDau[2]={momAtVertex[3*iTrkP1],momAtVertex[3*iTrkN1]};
+	Double_t pyDau[2]={momAtVertex[3*iTrkP1+1],momAtVertex[3*iTrkN1+1]};
+	Double_t pzDau[2]={momAtVertex[3*iTrkP1+2],momAtVertex[3*iTrkN1+2]};
+	pairMassOK = Select2ProngInvMassAndPt(pxDau,pyDau,pzDau);
+	if(!pairMassOK && !f3Prong && !f4Prong) { negtrack1=0; continue; }
+      }
+      if(pairMassOK) fStageCounts[kPairsKine]++;
 
       // Vertexing
       twoTrackArray1->AddAt(postrack1,0);
       twoTrackArray1->AddAt(negtrack1,1);
+      fStageCounts[kVertexFits]++;
       AliAODVertex *vertexp1n1 = ReconstructSecondaryVertex(twoTrackArray1,dispersion);
       if(!vertexp1n1) {
 	twoTrackArray1->Clear();
@@ -880,9 +941,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	continue;
       }
       // 2 prong candidate
-      if(fD0toKpi || fJPSItoEle || fDstar || fLikeSign) {
+      if((fD0toKpi || fJPSItoEle || fDstar || fLikeSign) && pairMassOK) {
 
 	io2Prong = Make2Prong(twoTrackArray1,event,vertexp1n1,dcap1n1,okD0,okJPSI,okD0fromDstar);
+	if(io2Prong) fStageCounts[kCandidates]++;
 
 	if((fD0toKpi && okD0) || (fJPSItoEle && okJPSI) || (isLikeSign2Prong && (okD0 || okJPSI))) {
 	  // add the vertex and the decay to the AOD
@@ -941,7 +1003,8 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  AliNeutralTrackParam *trackD0 = new AliNeutralTrackParam(io2Prong);
 
 	  // LOOP ON TRACKS THAT PASSED THE SOFT PION CUTS
-	  for(iTrkSoftPi=0; iTrkSoftPi<nSeleTrks; iTrkSoftPi++) {
+	  for(UInt_t jTrkSoftPi=0; jTrkSoftPi<cellSoftPi.size(); jTrkSoftPi++) {
+	    iTrkSoftPi = cellSoftPi[jTrkSoftPi];
 
 	    if(iTrkSoftPi==iTrkP1 || iTrkSoftPi==iTrkN1) continue;
 
@@ -976,6 +1039,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	      // DCA between the two tracks
 	      dcaCasc = trackPi->GetDCA(trackD0,fBzkG,xdummy,ydummy);
 	      // Vertexing
+	      fStageCounts[kVertexFits]++;
 	      vertexCasc = ReconstructSecondaryVertex(twoTrackArrayCasc,dispersion,kFALSE);
 	    } else {
 	      // assume Dstar decays at the primary vertex
@@ -993,6 +1057,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    }
 
             ioCascade = MakeCascade(twoTrackArrayCasc,event,vertexCasc,io2Prong,dcaCasc,okDstar);
+            if(ioCascade) fStageCounts[kCandidates]++;
             if(okDstar) {
 	      // add the D0 to the AOD (if not already done)
 	      if(!okD0) {
@@ -1050,7 +1115,8 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 
       // 2nd LOOP  ON  POSITIVE  TRACKS
-      for(iTrkP2=iTrkP1+1; iTrkP2<nSeleTrks; iTrkP2++) {
+      for(UInt_t jTrkP2=FirstInCell(cellDisplPos3Prong,iTrkP1+1); jTrkP2<cellDisplPos3Prong.size(); jTrkP2++) {
+	iTrkP2 = cellDisplPos3Prong[jTrkP2];
 
 	if(iTrkP2==iTrkP1 || iTrkP2==iTrkN1) continue;
 
@@ -1131,9 +1197,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
 
-	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+	fStageCounts[kTriplets]++;
+	dcap2n1 = GetPairDCA(postrack2,iTrkP2,negtrack1,iTrkN1);
 	if(dcap2n1>dcaMax) { postrack2=0; continue; }
-	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
+	dcap1p2 = GetPairDCA(postrack2,iTrkP2,postrack1,iTrkP1);
 	if(dcap1p2>dcaMax) { postrack2=0; continue; }
 
 	// check invariant mass cuts for D+,Ds,Lc
@@ -1165,10 +1232,12 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    continue;
 	  }
 	}
+	if(massCutOK) fStageCounts[kTripletsPresel]++;
 
 	// Vertexing
 	twoTrackArray2->AddAt(postrack2,0);
 	twoTrackArray2->AddAt(negtrack1,1);
+	fStageCounts[kVertexFits]++;
 	AliAODVertex *vertexp2n1 = ReconstructSecondaryVertex(twoTrackArray2,dispersion);
 	if(!vertexp2n1) {
 	  twoTrackArray2->Clear();
@@ -1179,8 +1248,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	// 3 prong candidates
 	if(f3Prong && massCutOK) {
 
+	  fStageCounts[kVertexFits]++;
 	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
 	  io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,vertexp2n1,dcap1n1,dcap2n1,dcap1p2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
+	  if(io3Prong) fStageCounts[kCandidates]++;
 	  if(ok3Prong) {
             AliAODVertex *v3Prong=0x0;
 	    if(!fMakeReducedRHF)v3Prong = new (verticesHFRef[iVerticesHF++])AliAODVertex(*secVert3PrAOD);
@@ -1241,10 +1312,12 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
           threeTrackArray->AddAt(postrack1,0);
           threeTrackArray->AddAt(negtrack1,1);
 	  threeTrackArray->AddAt(postrack2,2);
+          fStageCounts[kVertexFits]++;
           AliAODVertex* vertexp1n1p2 = ReconstructSecondaryVertex(threeTrackArray,dispersion);
 
 	  // 3rd LOOP  ON  NEGATIVE  TRACKS (for 4 prong)
-	  for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
+	  for(UInt_t jTrkN2=FirstInCell(cellDisplNeg,iTrkN1+1); jTrkN2<cellDisplNeg.size(); jTrkN2++) {
+	    iTrkN2 = cellDisplNeg[jTrkN2];
 
 	    if(iTrkN2==iTrkP1 || iTrkN2==iTrkP2 || iTrkN2==iTrkN1) continue;
 
@@ -1275,9 +1348,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
-	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	    fStageCounts[kQuadruplets]++;
+	    dcap1n2 = GetPairDCA(postrack1,iTrkP1,negtrack2,iTrkN2);
 	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
-            dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+            dcap2n2 = GetPairDCA(postrack2,iTrkP2,negtrack2,iTrkN2);
             if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
 
 
@@ -1297,9 +1371,13 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	      continue;
 	    }
 
+	    fStageCounts[kQuadrupletsPresel]++;
+
 	    // Vertexing
+	    fStageCounts[kVertexFits]++;
 	    AliAODVertex* secVert4PrAOD = ReconstructSecondaryVertex(fourTrackArray,dispersion);
 	    io4Prong = Make4Prong(fourTrackArray,event,secVert4PrAOD,vertexp1n1,vertexp1n1p2,dcap1n1,dcap1n2,dcap2n1,dcap2n2,ok4Prong);
+	    if(io4Prong) fStageCounts[kCandidates]++;
 	    if(ok4Prong) {
 	      rd = new(aodCharm4ProngRef[i4Prong++])AliAODRecoDecayHF4Prong(*io4Prong);
 	      if(fMakeReducedRHF){
@@ -1329,11 +1407,13 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	delete vertexp2n1;
 
       } // end 2nd loop on positive tracks
+      iTrkP2=nSeleTrks; // as at the end of a loop over all tracks
 
       twoTrackArray2->Clear();
 
       // 2nd LOOP  ON  NEGATIVE  TRACKS (for 3 prong -+-)
-      for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
+      for(UInt_t jTrkN2=FirstInCell(cellDisplNeg3Prong,iTrkN1+1); jTrkN2<cellDisplNeg3Prong.size(); jTrkN2++) {
+	iTrkN2 = cellDisplNeg3Prong[jTrkN2];
 
 	if(iTrkN2==iTrkP1 || iTrkN2==iTrkP2 || iTrkN2==iTrkN1) continue;
 
@@ -1409,9 +1489,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
 
-	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	fStageCounts[kTriplets]++;
+	dcap1n2 = GetPairDCA(postrack1,iTrkP1,negtrack2,iTrkN2);
 	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
-	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	dcan1n2 = GetPairDCA(negtrack1,iTrkN1,negtrack2,iTrkN2);
 	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
 
 	threeTrackArray->AddAt(negtrack1,0);
@@ -1433,11 +1514,13 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  negtrack2=0;
 	  continue;
 	}
+	fStageCounts[kTripletsPresel]++;
 
 	// Vertexing
 	twoTrackArray2->AddAt(postrack1,0);
 	twoTrackArray2->AddAt(negtrack2,1);
 
+	fStageCounts[kVertexFits]++;
 	AliAODVertex *vertexp1n2 = ReconstructSecondaryVertex(twoTrackArray2,dispersion);
 	if(!vertexp1n2) {
 	  twoTrackArray2->Clear();
@@ -1446,8 +1529,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	}
 
 	if(f3Prong) {
+	  fStageCounts[kVertexFits]++;
 	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
 	  io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,vertexp1n2,dcap1n1,dcap1n2,dcan1n2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
+	  if(io3Prong) fStageCounts[kCandidates]++;
 	  if(ok3Prong) {
 	    AliAODVertex *v3Prong = 0x0;
             if(!fMakeReducedRHF) v3Prong = new(verticesHFRef[iVerticesHF++])AliAODVertex(*secVert3PrAOD);
@@ -1501,6 +1586,8 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
  }  // end 1st loop on positive tracks
 
 
+  fStageCounts[kStored] += iD0toKpi+iJPSItoEle+i3Prong+i4Prong+iDstar+iCascades+iLikeSign2Prong+iLikeSign3Prong;
+
   //  AliDebug(1,Form(" Total HF vertices in event = %d;",
   //		  (Int_t)aodVerticesHFTClArr->GetEntriesFast()));
   if(fD0toKpi) {
@@ -2314,13 +2401,8 @@ AliAODRecoDecayHF2Prong *AliAnalysisVertexingHF::Make2Prong(
   px[1] = momentum[0]; py[1] = momentum[1]; pz[1] = momentum[2];
 
   if(!refill){//skip if it is called in refill step because already checked
-    // invariant mass cut (try to improve coding here..)
-    Bool_t okMassCut=kFALSE;
-    if(!okMassCut && fD0toKpi)   if(SelectInvMassAndPtD0Kpi(px,py,pz))     okMassCut=kTRUE;
-    if(!okMassCut && fJPSItoEle) if(SelectInvMassAndPtJpsiee(px,py,pz))    okMassCut=kTRUE;
-    if(!okMassCut && fDstar)     if(SelectInvMassAndPtDstarD0pi(px,py,pz)) okMassCut=kTRUE;
-    if(!okMassCut && fCascades)  if(SelectInvMassAndPtCascade(px,py,pz))   okMassCut=kTRUE;
-    if(!okMassCut) {
+    // invariant mass cut
+    if(!Select2ProngInvMassAndPt(px,py,pz)) {
       //AliDebug(2," candidate didn't pass mass cut");
       return 0x0;
     }
@@ -2885,6 +2967,60 @@ AliAODVertex* AliAnalysisVertexingHF::PrimaryVertex(const TObjArray *trkArray,
   return vertexAOD;
 }
 //-----------------------------------------------------------------------------
+Double_t AliAnalysisVertexingHF::GetPairDCA(AliESDtrack *trk1,Int_t iTrk1,
+					    AliESDtrack *trk2,Int_t iTrk2)
+{
+  /// DCA between two selected tracks with parameters at the primary vertex.
+  /// If the pair cache of the event is active, each pair is computed once
+  /// (always from the track with lower index) and reused by all candidates.
+  Double_t xdummy,ydummy;
+  fStageCounts[kDCARequests]++;
+  if(fPairDCA.empty()) {
+    fStageCounts[kDCAComputed]++;
+    return trk1->GetDCA(trk2,fBzkG,xdummy,ydummy);
+  }
+  if(iTrk1>iTrk2) {
+    std::swap(iTrk1,iTrk2);
+    std::swap(trk1,trk2);
+  }
+  Double_t &dca = fPairDCA[(Long64_t)iTrk2*(iTrk2-1)/2+iTrk1];
+  if(dca<0.) {
+    fStageCounts[kDCAComputed]++;
+    dca = trk1->GetDCA(trk2,fBzkG,xdummy,ydummy);
+  }
+  return dca;
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::Select2ProngInvMassAndPt(Double_t *px,Double_t *py,Double_t *pz)
+{
+  /// Invariant mass and pt cuts of all enabled 2-prong hypotheses
+  if(fD0toKpi   && SelectInvMassAndPtD0Kpi(px,py,pz))     return kTRUE;
+  if(fJPSItoEle && SelectInvMassAndPtJpsiee(px,py,pz))    return kTRUE;
+  if(fDstar     && SelectInvMassAndPtDstarD0pi(px,py,pz)) return kTRUE;
+  if(fCascades  && SelectInvMassAndPtCascade(px,py,pz))   return kTRUE;
+  return kFALSE;
+}
+//-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::ResetStageStatistics()
+{
+  /// Reset the counters of the candidate search stages
+  for(Int_t i=0; i<kNStages; i++) fStageCounts[i]=0;
+}
+//-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::PrintStageStatistics() const
+{
+  /// Print how many combinations survived each stage of the candidate search,
+  /// to tune the preselections
+  printf("Candidate search statistics (tracks: %d, selected %d):\n",fnTrksTotal,fnSeleTrksTotal);
+  printf("  pairs tested %lld, passing DCA %lld, passing kinematics %lld\n",
+	 fStageCounts[kPairs],fStageCounts[kPairsDCA],fStageCounts[kPairsKine]);
+  printf("  triplets tested %lld, preselected %lld\n",fStageCounts[kTriplets],fStageCounts[kTripletsPresel]);
+  printf("  quadruplets tested %lld, preselected %lld\n",fStageCounts[kQuadruplets],fStageCounts[kQuadrupletsPresel]);
+  printf("  secondary vertex fits %lld, candidates built %lld, stored %lld\n",
+	 fStageCounts[kVertexFits],fStageCounts[kCandidates],fStageCounts[kStored]);
+  printf("  pair DCAs requested %lld, computed %lld\n",fStageCounts[kDCARequests],fStageCounts[kDCAComputed]);
+}
+//-----------------------------------------------------------------------------
 void AliAnalysisVertexingHF::PrintStatus() const {
   /// Print parameters being used
 
@@ -13,6 +13,7 @@
 /// \author Contact: andrea.dainese@pd.infn.it
 //-------------------------------------------------------------------------
 
+#include <vector>
 #include <TNamed.h>
 #include <TList.h>
 
@@ -50,6 +51,10 @@ class AliAODv0;
 class AliAnalysisVertexingHF : public TNamed {
  public:
   //
+  /// stages of the candidate search, see PrintStageStatistics()
+  enum EStage { kPairs, kPairsDCA, kPairsKine, kTriplets, kTripletsPresel,
+		kQuadruplets, kQuadrupletsPresel, kVertexFits, kCandidates, kStored,
+		kDCARequests, kDCAComputed, kNStages };
   AliAnalysisVertexingHF();
   AliAnalysisVertexingHF(const AliAnalysisVertexingHF& source);
   AliAnalysisVertexingHF& operator=(const AliAnalysisVertexingHF& source);
@@ -73,6 +78,9 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t FillRecoCasc(AliVEvent *event,AliAODRecoCascadeHF *rc,Bool_t isDStar,Bool_t recoSecVtx=kFALSE);
   Bool_t RecoSecondaryVertexForCascades(AliVEvent *event, AliAODRecoCascadeHF *rc);
   void PrintStatus() const;
+  void PrintStageStatistics() const;
+  void ResetStageStatistics();
+  Long64_t GetStageCount(Int_t stage) const { return (stage>=0 && stage<kNStages) ? fStageCounts[stage] : 0; }
   void SetSecVtxWithKF() { fSecVtxWithKF=kTRUE; }
   void SetD0toKpiOn() { fD0toKpi=kTRUE; }
   void SetD0toKpiOff() { fD0toKpi=kFALSE; }
@@ -179,6 +187,8 @@ class AliAnalysisVertexingHF : public TNamed {
   void SetCutsDStartoKpipi(AliRDHFCutsDStartoKpipi* cuts) { fCutsDStartoKpipi = cuts; }
   AliRDHFCutsDStartoKpipi* GetCutsDStartoKpipi() const { return fCutsDStartoKpipi; }
   void SetMassCutBeforeVertexing(Bool_t flag) { fMassCutBeforeVertexing=flag; }
+  /// 2-prong mass and pt preselection with the momenta at the primary vertex, before the secondary vertex fit
+  void SetPairMassCutBeforeVertexing(Bool_t flag) { fPairMassCutBeforeVertexing=flag; }
 
   void SetMasses();
   Bool_t CheckCutsConsistency();
@@ -324,6 +334,7 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t fFindVertexForCascades;  /// reconstruct a secondary vertex or assume it's from the primary vertex
   Int_t  fV0TypeForCascadeVertex;  /// Select which V0 type we want to use for the cascas
   Bool_t fMassCutBeforeVertexing; /// to go faster in PbPb
+  Bool_t fPairMassCutBeforeVertexing; /// preselect 2-prongs with the momenta at the primary vertex
   // dummies for invariant mass calculation
   AliAODRecoDecay *fMassCalc2; /// for 2 prong
   AliAODRecoDecay *fMassCalc3; /// for 3 prong
@@ -348,6 +359,9 @@ class AliAnalysisVertexingHF : public TNamed {
   Double_t fMassDstar;
   Double_t fMassJpsi;
 
+  Long64_t fStageCounts[kNStages]; /// combinations reaching each stage of the candidate search
+  std::vector<Double_t> fPairDCA; //! DCAs of the pairs of selected tracks in the event, -1 if not yet computed
+
 
   //
   void AddRefs(AliAODVertex *v,AliAODRecoDecayHF *rd,const AliVEvent *event,
@@ -394,6 +408,8 @@ class AliAnalysisVertexingHF : public TNamed {
   AliAODVertex* PrimaryVertex(const TObjArray *trkArray=0x0,AliVEvent *event=0x0) const;
   AliAODVertex* ReconstructSecondaryVertex(TObjArray *trkArray,Double_t &dispersion,Bool_t useTRefArray=kTRUE) const;
 
+  Double_t GetPairDCA(AliESDtrack *trk1,Int_t iTrk1,AliESDtrack *trk2,Int_t iTrk2);
+  Bool_t Select2ProngInvMassAndPt(Double_t *px,Double_t *py,Double_t *pz);
   Bool_t SelectInvMassAndPt3prong(Double_t *px,Double_t *py,Double_t *pz, Int_t pidLcStatus=3);
   Bool_t SelectInvMassAndPt4prong(Double_t *px,Double_t *py,Double_t *pz);
   Bool_t SelectInvMassAndPtD0Kpi(Double_t *px,Double_t *py,Double_t *pz);
@@ -420,7 +436,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,27);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,28);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
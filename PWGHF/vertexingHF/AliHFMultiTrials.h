@@ -86,6 +86,8 @@ class AliHFMultiTrials : public TNamed {
   void SetSaveBkgValue(Bool_t opt=kTRUE, Double_t nsigma=3) {fSaveBkgVal=opt; fnSigmaForBkgEval=nsigma;}
 
   void SetDrawIndividualFits(Bool_t opt=kTRUE){fDrawIndividualFits=opt;}
+  /// fit the trials in nWorkers forked processes (<=1: all fits in this process)
+  void SetNumberOfWorkers(Int_t nWorkers){fNWorkers=nWorkers;}
 
   Bool_t DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad=0x0);
   void SaveToRoot(TString fileName, TString option="recreate") const;
@@ -103,7 +105,26 @@ class AliHFMultiTrials : public TNamed {
 
  private:
 
+  /// one fit configuration of the scan
+  struct TrialConfig {
+    Int_t fHisto;     /// index of the rebinned histogram
+    Int_t fRebin;     /// rebin factor
+    Int_t fFirstBin;  /// first bin step
+    Int_t fLowLim;    /// index of the low fit limit
+    Int_t fUpLim;     /// index of the up fit limit
+    Int_t fBkgFunc;   /// background function (EBkgFuncCases)
+    Int_t fFitConf;   /// sigma/mean configuration (EFitParamCases)
+    Int_t fTrial;     /// trial number within the case
+    Int_t fGlobBin;   /// bin in the histograms of all trials
+  };
+  /// layout of the fit results of one trial, followed by (valid,counts,error) for each bin counting step
+  enum ETrialResults{ kTrialDone, kTrialOut, kTrialChi2, kTrialSigma, kTrialESigma, kTrialPos, kTrialEPos, kTrialRY, kTrialERY, kTrialSignif, kTrialESignif, kTrialBkg, kTrialEBkg, kTrialBkgBEdge, kTrialEBkgBEdge, kNTrialResults };
+
   Bool_t CreateHistos();
+  AliHFMassFitterVAR* FitTrial(const TrialConfig& tc, TH1F* hRebinned, TH1D* hInvMassHisto, Double_t* res) const;
+  void FillTrial(const TrialConfig& tc, const Double_t* res);
+  Bool_t FitTrialsInWorkers(const std::vector<TrialConfig>& trials, const std::vector<TH1F*>& hRebinned, TH1D* hInvMassHisto, std::vector<Double_t>& results) const;
+  Int_t GetNTrialResults() const {return kNTrialResults+3*fNumOfnSigmaBinCSteps;}
   TH1F* RebinHisto(TH1D* hOrig, Int_t reb, Int_t firstUse) const;
   void BinCount(TH1F* h, TF1* fB, Int_t rebin, Double_t minMass, Double_t maxMass, Double_t& count, Double_t& ecount) const;
   Bool_t DoFitWithPol3Bkg(TH1F* histoToFit, Double_t  hmin, Double_t  hmax,
@@ -147,6 +168,7 @@ class AliHFMultiTrials : public TNamed {
   Bool_t fSaveBkgVal;		/// switch for saving bkg values in nsigma
 
   Bool_t fDrawIndividualFits; /// flag for drawing fits
+  Int_t fNWorkers;            /// number of worker processes for the fits
 
   TH1F* fHistoRawYieldDistAll;  /// histo with yield from all trials
   TH1F* fHistoRawYieldTrialAll; /// histo with yield from all trials
@@ -181,7 +203,7 @@ class AliHFMultiTrials : public TNamed {
   std::vector<AliHFMassFitterVAR*> fMassFitters; //!<! Mass fitters
 
   /// \cond CLASSIMP
-  ClassDef(AliHFMultiTrials,5); /// class for multiple trials of invariant mass fit
+  ClassDef(AliHFMultiTrials,6); /// class for multiple trials of invariant mass fit
   /// \endcond
 };
 
@@ -19,6 +19,11 @@
 
 #include "AliJetResponseMaker.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
 #include <TClonesArray.h>
 #include <TH2F.h>
 #include <THnSparse.h>
@@ -38,6 +43,190 @@
 
 ClassImp(AliJetResponseMaker)
 
+namespace {
+
+/**
+ * Eta-phi grid over jet axes, used to find the two closest jets
+ * of a jet in the other collection without testing all pairs.
+ */
+class AliJetAxisGrid {
+ public:
+  AliJetAxisGrid() : fNEta(0), fNPhi(0), fEtaMin(0), fEtaCell(0), fPhiCell(0), fQuery(0),
+                     fCellStart(), fCellJets(), fStamp() {}
+
+  void Build(const std::vector<AliEmcalJet*> &jets, Double_t cellSize);
+
+  template<class DistFunc>
+  void FindClosest(Double_t eta, Double_t phi, DistFunc dist, std::vector<std::pair<Int_t, Double_t> > &candidates);
+
+ private:
+  Int_t EtaCell(Double_t eta) const;
+  Int_t PhiCell(Double_t phi) const;
+  static Double_t NormalisePhi(Double_t phi);
+
+  static const Int_t kMaxCells = 100;
+
+  Int_t                 fNEta;          // number of cells in eta
+  Int_t                 fNPhi;          // number of cells in phi
+  Double_t              fEtaMin;        // lower edge of the grid in eta
+  Double_t              fEtaCell;       // cell size in eta
+  Double_t              fPhiCell;       // cell size in phi
+  Int_t                 fQuery;         // query counter for fStamp
+  std::vector<Int_t>    fCellStart;     // offsets of the cells in fCellJets
+  std::vector<Int_t>    fCellJets;      // jet indices sorted by cell
+  std::vector<Int_t>    fStamp;         // last query visiting the cell
+};
+
+void AliJetAxisGrid::Build(const std::vector<AliEmcalJet*> &jets, Double_t cellSize)
+{
+  // Jets with non-finite axis are left out: their distance to any jet is never
+  // smaller than the initial closest jet distance.
+
+  const Int_t njets = jets.size();
+  fNEta = 0;
+  fNPhi = 0;
+  fQuery = 0;
+  fCellStart.clear();
+  fCellJets.clear();
+  fStamp.clear();
+
+  Double_t etaMin = 0, etaMax = 0;
+  Bool_t first = kTRUE;
+  for (Int_t ijet = 0; ijet < njets; ijet++) {
+    Double_t eta = jets[ijet]->Eta();
+    if (!std::isfinite(eta) || !std::isfinite(jets[ijet]->Phi())) continue;
+    if (first || eta < etaMin) etaMin = eta;
+    if (first || eta > etaMax) etaMax = eta;
+    first = kFALSE;
+  }
+  if (first) return;
+
+  const Double_t span = etaMax - etaMin;
+  fNEta = TMath::Max(1, static_cast<Int_t>(TMath::Min(span / cellSize, Double_t(kMaxCells))));
+  fEtaCell = span > 0 ? span / fNEta : cellSize;
+  fNPhi = TMath::Max(1, static_cast<Int_t>(TMath::Min(TMath::TwoPi() / cellSize, Double_t(kMaxCells))));
+  fPhiCell = TMath::TwoPi() / fNPhi;
+  fEtaMin = etaMin;
+
+  const Int_t ncells = fNEta * fNPhi;
+  std::vector<Int_t> cellOfJet(njets, -1);
+  fCellStart.assign(ncells + 1, 0);
+  for (Int_t ijet = 0; ijet < njets; ijet++) {
+    if (!std::isfinite(jets[ijet]->Eta()) || !std::isfinite(jets[ijet]->Phi())) continue;
+    cellOfJet[ijet] = EtaCell(jets[ijet]->Eta()) * fNPhi + PhiCell(NormalisePhi(jets[ijet]->Phi()));
+    fCellStart[cellOfJet[ijet] + 1]++;
+  }
+  for (Int_t icell = 0; icell < ncells; icell++) fCellStart[icell + 1] += fCellStart[icell];
+  fCellJets.resize(fCellStart[ncells]);
+  std::vector<Int_t> pos(fCellStart.begin(), fCellStart.end() - 1);
+  for (Int_t ijet = 0; ijet < njets; ijet++) {
+    if (cellOfJet[ijet] >= 0) fCellJets[pos[cellOfJet[ijet]]++] = ijet;
+  }
+  fStamp.assign(ncells, 0);
+}
+
+template<class DistFunc>
+void AliJetAxisGrid::FindClosest(Double_t eta, Double_t phi, DistFunc dist, std::vector<std::pair<Int_t, Double_t> > &candidates)
+{
+  // Visit rings of cells around the query until the two closest jets found so far
+  // are closer than any jet in the cells not yet visited. The candidates (jet index,
+  // distance) are returned ordered by jet index.
+
+  candidates.clear();
+  if (fNEta == 0 || !std::isfinite(eta) || !std::isfinite(phi)) return;
+
+  fQuery++;
+  const Int_t ieta0 = EtaCell(eta);
+  const Int_t iphi0 = PhiCell(NormalisePhi(phi));
+  const Int_t maxRing = TMath::Max(fNEta, fNPhi);
+  const Double_t minCell = TMath::Min(fEtaCell, fPhiCell);
+
+  Double_t best1 = std::numeric_limits<Double_t>::infinity();
+  Double_t best2 = best1;
+  for (Int_t ring = 0; ; ring++) {
+    for (Int_t ieta = TMath::Max(0, ieta0 - ring); ieta <= TMath::Min(fNEta - 1, ieta0 + ring); ieta++) {
+      for (Int_t iphi = iphi0 - ring; iphi <= iphi0 + ring; iphi++) {
+        if (TMath::Abs(ieta - ieta0) != ring && TMath::Abs(iphi - iphi0) != ring) continue;
+        const Int_t icell = ieta * fNPhi + (iphi % fNPhi + fNPhi) % fNPhi;
+        if (fStamp[icell] == fQuery) continue;
+        fStamp[icell] = fQuery;
+        for (Int_t i = fCellStart[icell]; i < fCellStart[icell + 1]; i++) {
+          const Double_t d = dist(fCellJets[i]);
+          candidates.push_back(std::make_pair(fCellJets[i], d));
+          if (d < best1) {
+            best2 = best1;
+            best1 = d;
+          }
+          else if (d < best2) {
+            best2 = d;
+          }
+        }
+      }
+    }
+    if (ring >= maxRing) break;
+    // jets in cells outside the visited rings are at least ring cells away
+    if (best2 < ring * minCell * (1. - 1e-9) - 1e-12) break;
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+}
+
+Int_t AliJetAxisGrid::EtaCell(Double_t eta) const
+{
+  const Double_t cell = TMath::Floor((eta - fEtaMin) / fEtaCell);
+  if (cell < 0) return 0;
+  if (cell >= fNEta) return fNEta - 1;
+  return static_cast<Int_t>(cell);
+}
+
+Int_t AliJetAxisGrid::PhiCell(Double_t phi) const
+{
+  const Double_t cell = TMath::Floor(phi / fPhiCell);
+  if (cell < 0) return 0;
+  if (cell >= fNPhi) return fNPhi - 1;
+  return static_cast<Int_t>(cell);
+}
+
+Double_t AliJetAxisGrid::NormalisePhi(Double_t phi)
+{
+  Double_t result = std::fmod(phi, TMath::TwoPi());
+  if (result < 0) result += TMath::TwoPi();
+  return result;
+}
+
+/// Contribution of a detector-level constituent to the MC label matching level
+struct AliJetLabelEntry {
+  Int_t    fIndex;     // index of the associated MC particle in the particle-level container
+  Double_t fPt;        // pt subtracted from the detector-level jet
+  Double_t fFrac;      // fraction of the MC particle pt subtracted from the particle-level jet (cell fraction, 1 otherwise)
+};
+
+Bool_t LabelEntryIndexLess(const AliJetLabelEntry &a, const AliJetLabelEntry &b) { return a.fIndex < b.fIndex; }
+
+Bool_t IndexPairLess(const std::pair<Int_t, Double_t> &a, const std::pair<Int_t, Double_t> &b) { return a.first < b.first; }
+
+/// Jets (position in the jet list) containing a given constituent index, sorted by constituent index
+void BuildConstituentIndex(const std::vector<AliEmcalJet*> &jets, Bool_t clusters, std::vector<std::pair<Int_t, Int_t> > &index)
+{
+  index.clear();
+  for (UInt_t ijet = 0; ijet < jets.size(); ijet++) {
+    const Int_t n = clusters ? jets[ijet]->GetNumberOfClusters() : jets[ijet]->GetNumberOfTracks();
+    for (Int_t i = 0; i < n; i++) {
+      index.push_back(std::make_pair(clusters ? jets[ijet]->ClusterAt(i) : jets[ijet]->TrackAt(i), Int_t(ijet)));
+    }
+  }
+  std::sort(index.begin(), index.end());
+}
+
+/// Flag (with the value tag) all jets which contain the constituent
+void MarkJetsWithConstituent(const std::vector<std::pair<Int_t, Int_t> > &index, Int_t constituent, std::vector<Int_t> &flags, Int_t tag)
+{
+  std::vector<std::pair<Int_t, Int_t> >::const_iterator it = std::lower_bound(index.begin(), index.end(), std::make_pair(constituent, -1));
+  for (; it != index.end() && it->first == constituent; ++it) flags[it->second] = tag;
+}
+
+}
+
 //________________________________________________________________________
 AliJetResponseMaker::AliJetResponseMaker() : 
   AliAnalysisTaskEmcalJet("AliJetResponseMaker", kTRUE),
@@ -45,6 +234,7 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fMatchingPar1(0),
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
+  fUseFastMatching(kTRUE),
   fMinJetMCPt(1),
   fEmbeddingQA(),
   fHistoType(0),
@@ -134,6 +324,7 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fMatchingPar1(0),
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
+  fUseFastMatching(kTRUE),
   fMinJetMCPt(1),
   fEmbeddingQA(),
   fHistoType(0),
@@ -1429,17 +1620,344 @@ void AliJetResponseMaker::DoJetLoop()
   jets2->ResetCurrentID();
   while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
 
+  if (!fUseFastMatching || (fMatching == kSameCollections && fUseCellsToMatch && fCaloCells)) {
+    jets1->ResetCurrentID();
+    while ((jet1 = jets1->GetNextJet())) {
+      jet1->ResetMatching();
+
+      if (jet1->MCPt() < fMinJetMCPt) continue;
+
+      jets2->ResetCurrentID();
+      while ((jet2 = jets2->GetNextJet())) {
+        SetMatchingLevel(jet1, jet2, fMatching);
+      } // jet2 loop
+    } // jet1 loop
+    return;
+  }
+
+  // The fast matching visits the same pairs in the same order as the loop above (or, for the
+  // geometrical matching, a subset containing the two closest jets), therefore the closest
+  // and second closest jets are identical.
+  std::vector<AliEmcalJet*> jetList1, jetList2;
+
   jets1->ResetCurrentID();
   while ((jet1 = jets1->GetNextJet())) {
     jet1->ResetMatching();
-
     if (jet1->MCPt() < fMinJetMCPt) continue;
+    jetList1.push_back(jet1);
+  }
+
+  jets2->ResetCurrentID();
+  while ((jet2 = jets2->GetNextJet())) jetList2.push_back(jet2);
+
+  switch (fMatching) {
+  case kGeometrical:
+    DoGeometricalJetLoop(jetList1, jetList2);
+    break;
+  case kMCLabel:
+    DoMCLabelJetLoop(jetList1, jetList2);
+    break;
+  case kSameCollections:
+    DoSameCollectionsJetLoop(jetList1, jetList2);
+    break;
+  default:
+    ;
+  }
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::DoGeometricalJetLoop(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2)
+{
+  // Find the two closest jets of each jet using an eta-phi grid over the axes of the other collection.
+  // The candidates are applied in collection order, so ties are resolved as in the loop over all pairs.
+
+  const Double_t cellSize = TMath::Min(TMath::Max(TMath::Max(fMatchingPar1, fMatchingPar2), 0.1), 1.);
+
+  AliJetAxisGrid grid1, grid2;
+  grid1.Build(jets1, cellSize);
+  grid2.Build(jets2, cellSize);
+
+  std::vector<std::pair<Int_t, Double_t> > candidates;
+
+  for (UInt_t ijet1 = 0; ijet1 < jets1.size(); ijet1++) {
+    AliEmcalJet *jet1 = jets1[ijet1];
+    grid2.FindClosest(jet1->Eta(), jet1->Phi(), [&jet1, &jets2](Int_t i) { return jet1->DeltaR(jets2[i]); }, candidates);
+    for (UInt_t icand = 0; icand < candidates.size(); icand++) UpdateClosestJet(jet1, jets2[candidates[icand].first], candidates[icand].second);
+  }
+
+  for (UInt_t ijet2 = 0; ijet2 < jets2.size(); ijet2++) {
+    AliEmcalJet *jet2 = jets2[ijet2];
+    grid1.FindClosest(jet2->Eta(), jet2->Phi(), [&jet2, &jets1](Int_t i) { return jets1[i]->DeltaR(jet2); }, candidates);
+    for (UInt_t icand = 0; icand < candidates.size(); icand++) UpdateClosestJet(jet2, jets1[candidates[icand].first], candidates[icand].second);
+  }
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::DoMCLabelJetLoop(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2)
+{
+  // Same matching level as GetMCLabelMatchingLevel for all pairs. The constituents of each jet 1
+  // are converted once into a list of MC particle indices sorted by index; the jets 2 sharing
+  // at least one of them are found via a constituent index. For all other pairs only the
+  // normalisation of the matching level is left.
+
+  AliJetContainer *jetCont1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jetCont2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  // tracks1 just serves as a proxy to ensure that tracks are in jets1
+  AliParticleContainer *tracks1 = jetCont1->GetParticleContainer();
+  // tracks2 is used to retrieve MC labels associated with tracks in the container
+  AliParticleContainer *tracks2 = jetCont2->GetParticleContainer();
+
+  std::vector<std::pair<Int_t, Int_t> > jets2ByParticle;
+  BuildConstituentIndex(jets2, kFALSE, jets2ByParticle);
+
+  std::vector<Int_t> shared(jets2.size(), -1);
+  std::vector<AliJetLabelEntry> entries;
+
+  for (UInt_t ijet1 = 0; ijet1 < jets1.size(); ijet1++) {
+    AliEmcalJet *jet1 = jets1[ijet1];
+
+    Double_t d1start = jet1->Pt();
+    Double_t totalPt1 = d1start; // the total pt of the reconstructed jet will be cleaned from the background
+
+    // remove completely tracks that are not MC particles (label == 0)
+    if (tracks1 && tracks1->GetArray()) {
+      for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
+        AliVParticle *track = jet1->Track(iTrack);
+        if (!track) continue;
+        Int_t MClabel = TMath::Abs(track->GetLabel());
+        MClabel -= fMCLabelShift;
+        if (MClabel != 0) continue;
+        totalPt1 -= track->Pt();
+        d1start -= track->Pt();
+      }
+    }
+
+    // collect the constituents associated with MC particles, in the order in which they are subtracted
+    entries.clear();
+    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
+      AliVParticle *track = jet1->Track(iTrack);
+      if (!track) {
+        AliWarning(Form("Could not find track %d!", iTrack));
+        continue;
+      }
+      Int_t MClabel = TMath::Abs(track->GetLabel());
+      MClabel -= fMCLabelShift;
+      if (MClabel <= 0) continue;
+      Int_t index = tracks2->GetIndexFromLabel(MClabel);
+      if (index < 0) continue;
+      AliJetLabelEntry entry = {index, track->Pt(), 1.};
+      entries.push_back(entry);
+    }
+
+    if (fUseCellsToMatch && fCaloCells) {
+      for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+        AliVCluster *clus = jet1->Cluster(iClus);
+        if (!clus) {
+          AliWarning(Form("Could not find cluster %d!", iClus));
+          continue;
+        }
+        AliTLorentzVector part;
+        clus->GetMomentum(part, fVertex);
+
+        for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
+          Int_t cellId = clus->GetCellAbsId(iCell);
+          Double_t cellFrac = clus->GetCellAmplitudeFraction(iCell);
+
+          Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
+          MClabel -= fMCLabelShift;
+          if (MClabel == 0) {
+            totalPt1 -= part.Pt() * cellFrac;
+            d1start -= part.Pt() * cellFrac;
+            continue;
+          }
+          if (MClabel < 0) continue;
+          Int_t index = tracks2->GetIndexFromLabel(MClabel);
+          if (index < 0) continue;
+          AliJetLabelEntry entry = {index, part.Pt() * cellFrac, cellFrac};
+          entries.push_back(entry);
+        }
+      }
+    }
+    else {
+      for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+        AliVCluster *clus = jet1->Cluster(iClus);
+        if (!clus) {
+          AliWarning(Form("Could not find cluster %d!", iClus));
+          continue;
+        }
+        TLorentzVector part;
+        clus->GetMomentum(part, fVertex);
+
+        Int_t MClabel = TMath::Abs(clus->GetLabel());
+        MClabel -= fMCLabelShift;
+        if (MClabel == 0) {
+          totalPt1 -= part.Pt();
+          d1start -= part.Pt();
+          continue;
+        }
+        if (MClabel < 0) continue;
+        Int_t index = tracks2->GetIndexFromLabel(MClabel);
+        if (index < 0) continue;
+        AliJetLabelEntry entry = {index, part.Pt(), 1.};
+        entries.push_back(entry);
+      }
+    }
+
+    // keeps the subtraction order for entries with the same index
+    std::stable_sort(entries.begin(), entries.end(), LabelEntryIndexLess);
+    for (UInt_t ientry = 0; ientry < entries.size(); ientry++) {
+      if (ientry > 0 && entries[ientry].fIndex == entries[ientry - 1].fIndex) continue;
+      MarkJetsWithConstituent(jets2ByParticle, entries[ientry].fIndex, shared, ijet1);
+    }
+
+    for (UInt_t ijet2 = 0; ijet2 < jets2.size(); ijet2++) {
+      AliEmcalJet *jet2 = jets2[ijet2];
+
+      Double_t d1 = d1start;
+      Double_t d2 = jet2->Pt();
+
+      if (shared[ijet2] == Int_t(ijet1)) {
+        for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
+          AliJetLabelEntry key = {jet2->TrackAt(iTrack2), 0., 0.};
+          std::vector<AliJetLabelEntry>::const_iterator it = std::lower_bound(entries.begin(), entries.end(), key, LabelEntryIndexLess);
+          Bool_t track2Found = kFALSE;
+          for (; it != entries.end() && it->fIndex == key.fIndex; ++it) {
+            // found common particle
+            d1 -= it->fPt;
+            if (!track2Found) {
+              AliVParticle *MCpart = jet2->Track(iTrack2);
+              d2 -= MCpart->Pt() * it->fFrac;
+            }
+            track2Found = kTRUE;
+          }
+        }
+      }
+
+      if (d1 < 0)
+        d1 = 0;
+
+      if (d2 < 0)
+        d2 = 0;
+
+      if (totalPt1 < 1)
+        d1 = -1;
+      else
+        d1 /= totalPt1;
+
+      if (jet2->Pt() < 1)
+        d2 = -1;
+      else
+        d2 /= jet2->Pt();
 
-    jets2->ResetCurrentID();
-    while ((jet2 = jets2->GetNextJet())) {
-      SetMatchingLevel(jet1, jet2, fMatching);
-    } // jet2 loop
-  } // jet1 loop
+      UpdateClosestJet(jet1, jet2, d1);
+      UpdateClosestJet(jet2, jet1, d2);
+    }
+  }
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::DoSameCollectionsJetLoop(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2)
+{
+  // Same matching level as GetSameCollectionsMatchingLevel (cluster matching, not cells) for all pairs.
+  // Common constituents are found via the constituent indices of each jet 1 sorted once per jet.
+
+  AliJetContainer *jetCont1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jetCont2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  // All of the containers are simply used as proxies for whether tracks or clusters are in a jet
+  const Bool_t matchTracks = jetCont1->GetParticleContainer() && jetCont2->GetParticleContainer();
+  const Bool_t matchClusters = jetCont1->GetClusterContainer() && jetCont2->GetClusterContainer();
+
+  std::vector<std::pair<Int_t, Int_t> > jets2ByTrack, jets2ByCluster;
+  if (matchTracks) BuildConstituentIndex(jets2, kFALSE, jets2ByTrack);
+  if (matchClusters) BuildConstituentIndex(jets2, kTRUE, jets2ByCluster);
+
+  std::vector<Int_t> shared(jets2.size(), -1);
+  // (constituent index, pt) of the first available occurrence of each constituent of jet 1
+  std::vector<std::pair<Int_t, Double_t> > tracks1, clusters1;
+
+  for (UInt_t ijet1 = 0; ijet1 < jets1.size(); ijet1++) {
+    AliEmcalJet *jet1 = jets1[ijet1];
+
+    tracks1.clear();
+    clusters1.clear();
+    if (matchTracks) {
+      for (Int_t iTrack1 = 0; iTrack1 < jet1->GetNumberOfTracks(); iTrack1++) {
+        AliVParticle *part1 = jet1->Track(iTrack1);
+        if (!part1) {
+          AliWarning(Form("Could not find track %d!", jet1->TrackAt(iTrack1)));
+          continue;
+        }
+        tracks1.push_back(std::make_pair(jet1->TrackAt(iTrack1), part1->Pt()));
+      }
+      std::stable_sort(tracks1.begin(), tracks1.end(), IndexPairLess);
+      for (UInt_t i = 0; i < tracks1.size(); i++) MarkJetsWithConstituent(jets2ByTrack, tracks1[i].first, shared, ijet1);
+    }
+    if (matchClusters) {
+      for (Int_t iClus1 = 0; iClus1 < jet1->GetNumberOfClusters(); iClus1++) {
+        AliVCluster *clus1 = jet1->Cluster(iClus1);
+        if (!clus1) {
+          AliWarning(Form("Could not find cluster %d!", jet1->ClusterAt(iClus1)));
+          continue;
+        }
+        TLorentzVector part1;
+        clus1->GetMomentum(part1, fVertex);
+        clusters1.push_back(std::make_pair(jet1->ClusterAt(iClus1), part1.Pt()));
+      }
+      std::stable_sort(clusters1.begin(), clusters1.end(), IndexPairLess);
+      for (UInt_t i = 0; i < clusters1.size(); i++) MarkJetsWithConstituent(jets2ByCluster, clusters1[i].first, shared, ijet1);
+    }
+
+    for (UInt_t ijet2 = 0; ijet2 < jets2.size(); ijet2++) {
+      AliEmcalJet *jet2 = jets2[ijet2];
+
+      Double_t d1 = jet1->Pt();
+      Double_t d2 = jet2->Pt();
+
+      if (shared[ijet2] == Int_t(ijet1)) {
+        for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks() && matchTracks; iTrack2++) {
+          std::pair<Int_t, Double_t> key(jet2->TrackAt(iTrack2), 0.);
+          std::vector<std::pair<Int_t, Double_t> >::const_iterator it = std::lower_bound(tracks1.begin(), tracks1.end(), key, IndexPairLess);
+          if (it == tracks1.end() || it->first != key.first) continue;
+          AliVParticle *part2 = jet2->Track(iTrack2);
+          if (!part2) continue;
+          d1 -= it->second;
+          d2 -= part2->Pt();
+        }
+        for (Int_t iClus2 = 0; iClus2 < jet2->GetNumberOfClusters() && matchClusters; iClus2++) {
+          std::pair<Int_t, Double_t> key(jet2->ClusterAt(iClus2), 0.);
+          std::vector<std::pair<Int_t, Double_t> >::const_iterator it = std::lower_bound(clusters1.begin(), clusters1.end(), key, IndexPairLess);
+          if (it == clusters1.end() || it->first != key.first) continue;
+          AliVCluster *clus2 = jet2->Cluster(iClus2);
+          if (!clus2) continue;
+          TLorentzVector part2;
+          clus2->GetMomentum(part2, fVertex);
+          d1 -= it->second;
+          d2 -= part2.Pt();
+        }
+      }
+
+      if (d1 < 0)
+        d1 = 0;
+
+      if (d2 < 0)
+        d2 = 0;
+
+      if (jet1->Pt() > 0)
+        d1 /= jet1->Pt();
+      else
+        d1 = -1;
+
+      if (jet2->Pt() > 0)
+        d2 /= jet2->Pt();
+      else
+        d2 = -1;
+
+      UpdateClosestJet(jet1, jet2, d1);
+      UpdateClosestJet(jet2, jet1, d2);
+    }
+  }
 }
 
 //________________________________________________________________________
@@ -1886,26 +2404,23 @@ void AliJetResponseMaker::SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2,
     ;
   }
 
-  if (d1 >= 0) {
+  UpdateClosestJet(jet1, jet2, d1);
+  UpdateClosestJet(jet2, jet1, d2);
+}
 
-    if (d1 < jet1->ClosestJetDistance()) {
-      jet1->SetSecondClosestJet(jet1->ClosestJet(), jet1->ClosestJetDistance());
-      jet1->SetClosestJet(jet2, d1);
-    }
-    else if (d1 < jet1->SecondClosestJetDistance()) {
-      jet1->SetSecondClosestJet(jet2, d1);
-    }
-  }
+//________________________________________________________________________
+void AliJetResponseMaker::UpdateClosestJet(AliEmcalJet *jet, AliEmcalJet *partner, Double_t d) const
+{
+  // Update the closest and second closest jet with a new candidate at matching level d.
 
-  if (d2 >= 0) {
+  if (d < 0) return;
 
-    if (d2 < jet2->ClosestJetDistance()) {
-      jet2->SetSecondClosestJet(jet2->ClosestJet(), jet2->ClosestJetDistance());
-      jet2->SetClosestJet(jet1, d2);
-    }
-    else if (d2 < jet2->SecondClosestJetDistance()) {
-      jet2->SetSecondClosestJet(jet1, d2);
-    }
+  if (d < jet->ClosestJetDistance()) {
+    jet->SetSecondClosestJet(jet->ClosestJet(), jet->ClosestJetDistance());
+    jet->SetClosestJet(partner, d);
+  }
+  else if (d < jet->SecondClosestJetDistance()) {
+    jet->SetSecondClosestJet(partner, d);
   }
 }
 
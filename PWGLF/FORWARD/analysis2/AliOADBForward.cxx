@@ -8,6 +8,8 @@
 #include <TFile.h>
 #include <TError.h>
 #include <TSystem.h>
+#include <algorithm>
+#include <map>
 
 #ifndef ALIROOT_SVN_REVISION
 # define ALIROOT_SVN_REVISION 0
@@ -146,8 +148,49 @@ AliOADBForward::Entry::Print(Option_t* /*option*/) const
   Printf("%s", GetTitle());
 }
 //====================================================================
+namespace {
+  typedef std::vector<AliOADBForward::Table::IndexRow>::const_iterator RowIter;
+  /** 
+   * Order index rows on run number 
+   */
+  struct RunLess 
+  {
+    Bool_t operator()(const AliOADBForward::Table::IndexRow& a, 
+		      const AliOADBForward::Table::IndexRow& b) const 
+    { 
+      return a.fRunNo < b.fRunNo; 
+    }
+    Bool_t operator()(const AliOADBForward::Table::IndexRow& a, 
+		      ULong_t run) const 
+    { 
+      return a.fRunNo < run; 
+    }
+    Bool_t operator()(ULong_t run, 
+		      const AliOADBForward::Table::IndexRow& b) const 
+    { 
+      return run < b.fRunNo; 
+    }
+  };
+  /** 
+   * First row with run number not less than @a run 
+   */
+  RowIter LowerRun(RowIter beg, RowIter end, ULong_t run) 
+  {
+    return std::lower_bound(beg, end, run, RunLess());
+  }
+  /** 
+   * First row with run number larger than @a run 
+   */
+  RowIter UpperRun(RowIter beg, RowIter end, ULong_t run) 
+  {
+    return std::upper_bound(beg, end, run, RunLess());
+  }
+}
+
+//____________________________________________________________________
 AliOADBForward::Table::Table(TTree* tree, Bool_t isNew, ERunSelectMode mode)
-  : fTree(tree), fEntry(0), fVerbose(false), fMode(mode), fFallBack(false)
+  : fTree(tree), fEntry(0), fVerbose(false), fMode(mode), fFallBack(false),
+    fIndex(), fIndexLoaded(false)
 {
   if (!tree) return;
 
@@ -178,7 +221,9 @@ AliOADBForward::Table::Table(const Table& o)
     fEntry(o.fEntry), 
     fVerbose(o.fVerbose),
     fMode(o.fMode), 
-    fFallBack(o.fFallBack)
+    fFallBack(o.fFallBack),
+    fIndex(o.fIndex),
+    fIndexLoaded(o.fIndexLoaded)
 {
   //
   // Copy constructor 
@@ -206,6 +251,8 @@ AliOADBForward::Table::operator=(const Table& o)
   fEntry   = o.fEntry;
   fVerbose = o.fVerbose;
   fMode    = o.fMode;
+  fIndex       = o.fIndex;
+  fIndexLoaded = o.fIndexLoaded;
   if (fTree) fTree->SetBranchAddress("e", &fEntry);
 
   return *this;
@@ -272,6 +319,7 @@ AliOADBForward::Table::Close()
   // if (fEntry) delete fEntry;
   fTree  = 0;
   fEntry = 0;
+  ResetIndex();
   return true;
 } 
 //____________________________________________________________________
@@ -285,9 +333,192 @@ AliOADBForward::Table::Query(ULong_t        runNo,
 			     Bool_t         sat) const
 {
   // 
-  // Query the tree 
+  // Query the table using the in-memory index.  This gives the same
+  // entry as the query on the tree (see the string based Query
+  // below): among the entries that match the conditions and the
+  // run number selection, the best run according to the mode is
+  // chosen, and for equally good runs the last entry wins.
   //
-  return Query(runNo, mode, Conditions(sys, sNN, fld, mc, sat));
+  if (!IsOpen()) { 
+    Error("Query", "No tree associated");
+    return -1;
+  }
+  if (!LoadIndex()) 
+    return Query(runNo, mode, Conditions(sys, sNN, fld, mc, sat));
+
+  if (runNo > 0 && (mode <= kDefault || mode > kNewer)) mode = fMode;
+  if (fVerbose) 
+    Printf("%s: Query is '%s' (%s, indexed)", GetName(), 
+	   Conditions(sys, sNN, fld, mc, sat).Data(), 
+	   (runNo > 0 ? Mode2String(mode) : "latest"));
+
+  // Smaller score is better 
+  Long64_t bestScore = 0;
+  Int_t    entry     = -1;
+  for (std::vector<IndexGroup>::const_iterator g = fIndex.begin();
+       g != fIndex.end(); ++g) { 
+    if (sys > 0 && g->fSys != sys)                            continue;
+    if (sNN > 0 && TMath::Abs(Int_t(g->fSNN) - Int_t(sNN)) >= 11) continue;
+    if (TMath::Abs(fld) < 10 && g->fField != fld)             continue;
+    if (g->fMC != mc || g->fSatellite != sat)                 continue;
+
+    const std::vector<IndexRow>& rows = g->fRows;
+    RowIter  beg   = rows.begin();
+    RowIter  end   = rows.end();
+    Long64_t score = 0;
+    Int_t    ent   = -1;
+    switch (runNo > 0 ? mode : (mode == kNewest || mode == kOlder || 
+				mode == kNewer ? mode : kDefault)) {
+    case kExact: { 
+      RowIter lo = LowerRun(beg, end, runNo);
+      RowIter hi = UpperRun(lo, end, runNo);
+      if (lo == hi) continue;
+      ent = (hi-1)->fEntry;
+    }
+      break;
+    case kNewest: 
+      score = -Long64_t(rows.back().fRunNo);
+      ent   = rows.back().fEntry;
+      break;
+    case kOlder: { 
+      RowIter hi = (runNo > 0 ? UpperRun(beg, end, runNo) : end);
+      if (hi == beg) continue;
+      --hi;
+      score = -Long64_t(hi->fRunNo);
+      ent   = hi->fEntry;
+    }
+      break;
+    case kNewer: { 
+      RowIter lo = (runNo > 0 ? LowerRun(beg, end, runNo) : beg);
+      if (lo == end) continue;
+      score = lo->fRunNo;
+      ent   = (UpperRun(lo, end, lo->fRunNo)-1)->fEntry;
+    }
+      break;
+    case kNear: { 
+      // Nearest run at or above, and nearest run below 
+      RowIter  lo    = LowerRun(beg, end, runNo);
+      Long64_t dHigh = -1;
+      Int_t    eHigh = -1;
+      if (lo != end) { 
+	dHigh = lo->fRunNo - runNo;
+	eHigh = (UpperRun(lo, end, lo->fRunNo)-1)->fEntry;
+      }
+      Long64_t dLow = -1;
+      Int_t    eLow = -1;
+      if (lo != beg) { 
+	dLow = runNo - (lo-1)->fRunNo;
+	eLow = (lo-1)->fEntry;
+      }
+      if (dHigh < 0 || (dLow >= 0 && (dLow < dHigh || 
+				      (dLow == dHigh && eLow > eHigh)))) {
+	score = dLow;
+	ent   = eLow;
+      }
+      else { 
+	score = dHigh;
+	ent   = eHigh;
+      }
+      if (score > kMaxNearDistance) continue;
+    }
+      break;
+    case kDefault: 
+      ent = g->fMaxEntry;
+      break;
+    }
+    if (ent < 0) continue;
+    if (entry >= 0 && (score > bestScore || 
+		       (score == bestScore && ent < entry))) continue;
+    bestScore = score;
+    entry     = ent;
+  }
+
+  if (fVerbose) {
+    Printf("Returning entry # %d", entry);
+  }
+  return entry;
+}
+
+//____________________________________________________________________
+Bool_t
+AliOADBForward::Table::LoadIndex() const
+{
+  // 
+  // Build the in-memory index of the table.  The fields needed for
+  // the queries are read with two draws on the tree, so that the
+  // correction objects are not read in.
+  //
+  if (fIndexLoaded) return true;
+  if (!IsOpen()) return false;
+
+  fIndex.clear();
+  Long64_t nEntries = fTree->GetEntries();
+  if (nEntries > 0) { 
+    Long64_t oldEstimate = fTree->GetEstimate();
+    fTree->SetEstimate(nEntries);
+    std::vector<Double_t> runs, times, syss, snns, flds, mcs, sats;
+    Long64_t n1 = fTree->Draw("fRunNo:fTimestamp:fSys:fSNN", "", "goff");
+    if (n1 == nEntries) { 
+      runs.assign(fTree->GetV1(), fTree->GetV1() + nEntries);
+      times.assign(fTree->GetV2(), fTree->GetV2() + nEntries);
+      syss.assign(fTree->GetV3(), fTree->GetV3() + nEntries);
+      snns.assign(fTree->GetV4(), fTree->GetV4() + nEntries);
+    }
+    Long64_t n2 = fTree->Draw("fField:fMC:fSatellite", "", "goff");
+    if (n2 == nEntries) { 
+      flds.assign(fTree->GetV1(), fTree->GetV1() + nEntries);
+      mcs.assign(fTree->GetV2(), fTree->GetV2() + nEntries);
+      sats.assign(fTree->GetV3(), fTree->GetV3() + nEntries);
+    }
+    // Setting the estimate releases the buffers of the draws 
+    fTree->SetEstimate(oldEstimate);
+    if (n1 != nEntries || n2 != nEntries) { 
+      Warning("LoadIndex", "Failed to read %lld entries of %s (got %lld, %lld)",
+	      nEntries, GetName(), n1, n2);
+      return false;
+    }
+
+    std::map<ULong64_t,Int_t> groups;
+    for (Long64_t i = 0; i < nEntries; i++) { 
+      UShort_t sys = UShort_t(syss[i]);
+      UShort_t sNN = UShort_t(snns[i]);
+      Short_t  fld = Short_t(flds[i]);
+      Bool_t   mc  = mcs[i]  != 0;
+      Bool_t   sat = sats[i] != 0;
+      ULong64_t key = ((ULong64_t(sys) << 48) | (ULong64_t(sNN) << 32) | 
+		       (ULong64_t(UShort_t(fld)) << 16) | 
+		       (mc ? 2 : 0) | (sat ? 1 : 0));
+      std::map<ULong64_t,Int_t>::iterator it = groups.find(key);
+      if (it == groups.end()) { 
+	it = groups.insert(std::make_pair(key, Int_t(fIndex.size()))).first;
+	IndexGroup g;
+	g.fSys       = sys;
+	g.fSNN       = sNN;
+	g.fField     = fld;
+	g.fMC        = mc;
+	g.fSatellite = sat;
+	g.fMaxEntry  = -1;
+	fIndex.push_back(g);
+      }
+      IndexGroup& g = fIndex[it->second];
+      IndexRow    r;
+      r.fRunNo     = ULong_t(runs[i]);
+      r.fTimestamp = UInt_t(times[i]);
+      r.fEntry     = Int_t(i);
+      g.fRows.push_back(r);
+      g.fMaxEntry  = r.fEntry;
+    }
+    // Entries are added in order, so a stable sort on the run number
+    // keeps entries of the same run ordered by entry number
+    for (std::vector<IndexGroup>::iterator g = fIndex.begin(); 
+	 g != fIndex.end(); ++g) 
+      std::stable_sort(g->fRows.begin(), g->fRows.end(), RunLess());
+  }
+  fIndexLoaded = true;
+  if (fVerbose) 
+    Printf("%s: Indexed %lld entries in %d groups", GetName(), 
+	   nEntries, Int_t(fIndex.size()));
+  return true;
 }
 
 //____________________________________________________________________
@@ -470,6 +701,9 @@ AliOADBForward::Table::Insert(TObject* o,
   // do an Auto-save and flush-baskets now 
   fTree->AutoSave("FlushBaskets SaveSelf");
 
+  // Rebuild the index on the next query 
+  ResetIndex();
+
   return true;
 }
 
@@ -4,6 +4,7 @@
 #include <TNamed.h>
 #include <TString.h>
 #include <TMap.h>
+#include <vector>
 class TFile;
 class TTree;
 class TBrowser;
@@ -244,7 +245,8 @@ public:
      * @name Queries 
      */
     /** 
-     * Query the tree 
+     * Query the table.  The query is resolved from the in-memory
+     * index of the table (see LoadIndex), without touching the tree. 
      * 
      * @param runNo  Run number 
      * @param mode   Run selection mode 
@@ -276,6 +278,21 @@ public:
     Int_t Query(ULong_t        runNo,
 		ERunSelectMode mode,
 		const TString& q) const;
+    /** 
+     * Build the in-memory index of the table, if not done already.
+     * The run number, time stamp, and conditions of all entries are
+     * read once from the tree, and the entries are grouped on the
+     * conditions (system, sNN, field, MC, satellite).  Within each
+     * group the entries are sorted on run number, so that a query in
+     * any mode is a binary search per group.
+     * 
+     * @return true if the index is available 
+     */
+    Bool_t LoadIndex() const;
+    /** 
+     * Drop the in-memory index.  It is rebuilt on the next query. 
+     */
+    void ResetIndex() const { fIndex.clear(); fIndexLoaded = false; }
     /** 
      * Insert a new entry into the tree 
      * 
@@ -419,13 +436,39 @@ public:
      */
     Bool_t IsOpen(Bool_t rw=false) const; 
 
+    /** 
+     * An entry of the in-memory index 
+     */
+    struct IndexRow 
+    {
+      ULong_t fRunNo;     // Run number 
+      UInt_t  fTimestamp; // When the object was stored 
+      Int_t   fEntry;     // Entry number in the tree 
+    };
+    /** 
+     * Entries of the in-memory index with the same conditions,
+     * sorted on run number and entry number
+     */
+    struct IndexGroup 
+    {
+      UShort_t              fSys;       // Collision system 
+      UShort_t              fSNN;       // Center of mass energy 
+      Short_t               fField;     // L3 magnetic field
+      Bool_t                fMC;        // True if only for MC 
+      Bool_t                fSatellite; // Satelitte events
+      Int_t                 fMaxEntry;  // Largest entry number 
+      std::vector<IndexRow> fRows;      // Entries 
+    };
+
     TTree*         fTree;     // Our tree
     Entry*         fEntry;    // Entry cache 
     Bool_t         fVerbose;  // To be verbose or not 
     ERunSelectMode fMode;     // Run query mode 
     Bool_t         fFallBack; // Enable fall-back
+    mutable std::vector<IndexGroup> fIndex;       //! In-memory index 
+    mutable Bool_t                  fIndexLoaded; //! Whether index was built
 
-    ClassDef(Table,1); 
+    ClassDef(Table,2); 
   };
   // === Interface ===================================================
   /** 